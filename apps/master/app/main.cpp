@@ -7,21 +7,37 @@
 #include <unistd.h>
 
 #include "ethercat_sim/app/cli_runtime.h"
+#include "ethercat_sim/app/rt_config.h"
+#include "ethercat_sim/communication/socket_io.h"
 #include "framework/logger/logger.h"
 #include "logic/master_controller.h"
 #include "logic/master_model.h"
 #if HAVE_FTXUI
 #include "gui/master_tui.h"
 #endif
+#if HAVE_FASTDDS
+#include "ethercat_sim/communication/dds_process_image_bridge.h"
+#endif
 
 static void usage(const char* argv0)
 {
-    ethercat_sim::framework::logger::Logger::error("Usage: %s [--uds PATH | --tcp HOST:PORT] [--cycle us] [--headless] [--no-auto]", argv0);
+    ethercat_sim::framework::logger::Logger::error("Usage: %s [--uds PATH | --tcp HOST:PORT] [--cycle us] [--headless] [--busy-poll] [--spin-us N] [--wire-v1] [--no-auto] [--dds-pi] %s", argv0, ethercat_sim::app::rtUsage());
 }
 
 namespace
 {
 
+void logCycleStats(ethercat_sim::app::master::MasterController const& controller)
+{
+    auto s = controller.cycleStats();
+    ethercat_sim::framework::logger::Logger::info(
+        "cycle stats: cycles=%llu overruns=%llu pd_errors=%llu jitter mean=%lldus max=%lldus",
+        static_cast<unsigned long long>(s.cycles), static_cast<unsigned long long>(s.overruns),
+        static_cast<unsigned long long>(s.pd_errors),
+        static_cast<long long>(s.mean_jitter_ns / 1000),
+        static_cast<long long>(s.max_jitter_ns / 1000));
+}
+
 bool runAutoSequence(const std::shared_ptr<ethercat_sim::app::master::MasterController>& controller)
 {
     using namespace std::chrono_literals;
@@ -48,7 +64,8 @@ bool runAutoSequence(const std::shared_ptr<ethercat_sim::app::master::MasterCont
         }
         else
         {
-            ethercat_sim::framework::logger::Logger::error("Auto sequence step '%s' failed", label);
+            ethercat_sim::framework::logger::Logger::error("Auto sequence step '%s' failed: %s",
+                                                           label, model->current()->status.c_str());
         }
         return success;
     };
@@ -57,8 +74,8 @@ bool runAutoSequence(const std::shared_ptr<ethercat_sim::app::master::MasterCont
         "scan", [&] { controller->scan(); },
         [&]
         {
-            auto snap = model->snapshot();
-            return snap.detected_slaves > 0 && !snap.slaves.empty();
+            auto snap = model->current();
+            return snap->detected_slaves > 0 && !snap->slaves.empty();
         });
     if (!scan_ok)
     {
@@ -66,7 +83,7 @@ bool runAutoSequence(const std::shared_ptr<ethercat_sim::app::master::MasterCont
     }
 
     auto preop_ok =
-        attempt("preop", [&] { controller->initPreop(); }, [&] { return model->snapshot().preop; });
+        attempt("preop", [&] { controller->initPreop(); }, [&] { return model->current()->preop; });
     if (!preop_ok)
     {
         return false;
@@ -74,7 +91,7 @@ bool runAutoSequence(const std::shared_ptr<ethercat_sim::app::master::MasterCont
 
     auto op_ok = attempt(
         "operational", [&] { controller->requestOperational(); },
-        [&] { return model->snapshot().operational; });
+        [&] { return model->current()->operational; });
     return op_ok;
 }
 
@@ -89,10 +106,25 @@ int main(int argc, char** argv)
     int cycle_us         = 1000;
     bool force_headless  = false;
     bool auto_sequence   = true;
+    bool dds_pi          = false;
+    ethercat_sim::app::RtConfig rt;
+    ethercat_sim::communication::IoPolicy io;
+    int wire_version = 2;
 
     for (int i = 1; i < argc; ++i)
     {
         std::string a = argv[i];
+        std::string rt_err;
+        if (ethercat_sim::app::parseRtOption(argc, argv, i, rt, &rt_err))
+        {
+            if (!rt_err.empty())
+            {
+                ethercat_sim::framework::logger::Logger::error("%s", rt_err.c_str());
+                usage(argv[0]);
+                return 2;
+            }
+            continue;
+        }
         if (a == "--uds" && i + 1 < argc)
         {
             endpoint = std::string("uds://") + argv[++i];
@@ -109,10 +141,26 @@ int main(int argc, char** argv)
         {
             force_headless = true;
         }
+        else if (a == "--busy-poll")
+        {
+            io.busy_poll = true;
+        }
+        else if (a == "--spin-us" && i + 1 < argc)
+        {
+            io.spin_budget = std::chrono::microseconds(std::stoi(argv[++i]));
+        }
+        else if (a == "--wire-v1")
+        {
+            wire_version = 1;
+        }
         else if (a == "--no-auto")
         {
             auto_sequence = false;
         }
+        else if (a == "--dds-pi")
+        {
+            dds_pi = true;
+        }
         else if (a == "-h" || a == "--help")
         {
             usage(argv[0]);
@@ -125,10 +173,43 @@ int main(int argc, char** argv)
         static std::atomic_bool stop{false};
         ethercat_sim::app::installSignalHandlers(stop);
 
+        std::string rt_err;
+        if (!ethercat_sim::app::lockProcessMemory(rt, &rt_err))
+        {
+            ethercat_sim::framework::logger::Logger::warn("memory locking failed: %s",
+                                                          rt_err.c_str());
+        }
+
         auto controller =
             std::make_shared<ethercat_sim::app::master::MasterController>(endpoint, cycle_us);
+        controller->setRtConfig(rt);
+        controller->setIoPolicy(io);
+        controller->setWireVersion(wire_version);
         controller->start();
 
+        if (dds_pi)
+        {
+#if HAVE_FASTDDS
+            auto bridge = std::make_shared<ethercat_sim::communication::ProcessImageBridge>();
+            if (bridge->valid())
+            {
+                controller->setCycleHook(
+                    [bridge](ethercat_sim::app::master::ProcessImage const& pi)
+                    {
+                        bridge->publish(pi.inputSection(), pi.inputSize(), pi.outputSection(),
+                                        pi.outputSize());
+                    });
+                ethercat_sim::framework::logger::Logger::info("Publishing process image over DDS");
+            }
+            else
+            {
+                ethercat_sim::framework::logger::Logger::warn("DDS process image bridge unavailable");
+            }
+#else
+            ethercat_sim::framework::logger::Logger::warn("--dds-pi ignored: built without FastDDS");
+#endif
+        }
+
         bool auto_ok = true;
         if (auto_sequence)
         {
@@ -167,8 +248,15 @@ int main(int argc, char** argv)
             {
                 ethercat_sim::framework::logger::Logger::info("Headless mode - OP state reached");
             }
+            // Cycle statistics make the effect of --rt-prio/--cpu/--mlock visible in headless runs
+            auto next_stats = std::chrono::steady_clock::now() + 5s;
             while (!stop.load())
             {
+                if (std::chrono::steady_clock::now() >= next_stats)
+                {
+                    logCycleStats(*controller);
+                    next_stats += 5s;
+                }
                 if (terminal.isActive())
                 {
                     if (terminal.pollForEscape(200ms))
@@ -185,6 +273,7 @@ int main(int argc, char** argv)
         }
 
         controller->stop();
+        logCycleStats(*controller);
         ethercat_sim::framework::logger::Logger::info("Graceful shutdown");
     }
     catch (std::exception const& e)
@@ -1,6 +1,8 @@
 #include "bus/master_socket.h"
 
+#include <algorithm>
 #include <arpa/inet.h>
+#include <cerrno>
 #include <cstring>
 #include <iostream>
 #include <netdb.h>
@@ -8,6 +10,7 @@
 #include <string_view>
 #include <sys/socket.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 
 #include "framework/logger/logger.h"
 #include <sys/un.h>
@@ -19,6 +22,8 @@
 namespace ethercat_sim::bus
 {
 
+namespace wire = communication::wire;
+
 void MasterSocket::open(std::string const& /*interface*/)
 {
     if (fd_ != -1)
@@ -31,7 +36,8 @@ void MasterSocket::open(std::string const& /*interface*/)
         ethercat_sim::framework::logger::Logger::info("Connecting to UDS: %s", path.c_str());
         if (!connectUDS_(path))
         {
-            throw std::runtime_error("MasterSocket: UDS connect failed");
+            throw std::runtime_error("MasterSocket: UDS connect to " + path +
+                                     " failed: " + std::strerror(errno));
         }
         ethercat_sim::framework::logger::Logger::info("Successfully connected to UDS");
     }
@@ -40,7 +46,8 @@ void MasterSocket::open(std::string const& /*interface*/)
         ethercat_sim::framework::logger::Logger::info("Connecting to TCP: %s:%d", host.c_str(), port);
         if (!connectTCP_(host, port))
         {
-            throw std::runtime_error("MasterSocket: TCP connect failed");
+            throw std::runtime_error("MasterSocket: TCP connect to " + host + ":" +
+                                     std::to_string(port) + " failed: " + std::strerror(errno));
         }
         ethercat_sim::framework::logger::Logger::info("Successfully connected to TCP");
     }
@@ -52,17 +59,8 @@ void MasterSocket::open(std::string const& /*interface*/)
 
 void MasterSocket::setTimeout(std::chrono::nanoseconds timeout)
 {
+    // The socket is non-blocking; reads and writes wait at most this long (see socket_io.h)
     timeout_ = timeout;
-    if (fd_ == -1)
-        return;
-    timeval tv{};
-    tv.tv_sec =
-        static_cast<int>(std::chrono::duration_cast<std::chrono::seconds>(timeout_).count());
-    tv.tv_usec = static_cast<int>(
-        std::chrono::duration_cast<std::chrono::microseconds>(timeout_ % std::chrono::seconds(1))
-            .count());
-    setsockopt(fd_, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
-    setsockopt(fd_, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
 }
 
 void MasterSocket::close() noexcept
@@ -76,13 +74,29 @@ void MasterSocket::close() noexcept
 
 int32_t MasterSocket::write(uint8_t const* frame, int32_t frame_size)
 {
-    if (fd_ == -1)
+    if (fd_ == -1 || frame_size <= 0)
         return -1;
-    uint16_t be_len = htons(static_cast<uint16_t>(frame_size));
-    if (!writeAll_(&be_len, sizeof(be_len)))
+    if (wire_version_ == 1)
+    {
+        if (frame_size > wire::kMaxV1FrameSize)
+            return -1;
+        uint16_t be_len = htons(static_cast<uint16_t>(frame_size));
+        iovec iov[2]    = {{&be_len, sizeof(be_len)},
+                           {const_cast<uint8_t*>(frame), static_cast<size_t>(frame_size)}};
+        if (!communication::writeVectored(fd_, iov, 2, io_, timeout_))
+            return -1;
+        return frame_size;
+    }
+
+    if (static_cast<size_t>(frame_size) > wire::kMaxFrameSize)
         return -1;
-    if (!writeAll_(frame, static_cast<size_t>(frame_size)))
+    if (tx_count_ == wire::kMaxFrames && !flush_())
         return -1;
+    auto& d = tx_desc_[tx_count_++];
+    d.len   = static_cast<uint16_t>(frame_size);
+    d.index = tx_index_++;
+    d.rx_ns = 0;
+    tx_payload_.insert(tx_payload_.end(), frame, frame + frame_size);
     return frame_size;
 }
 
@@ -90,20 +104,115 @@ int32_t MasterSocket::read(uint8_t* frame, int32_t frame_size)
 {
     if (fd_ == -1)
         return -1;
-    uint16_t be_len = 0;
-    if (!readAll_(&be_len, sizeof(be_len)))
-        return 0; // timeout -> 0
-    uint16_t len = ntohs(be_len);
-    if (len > static_cast<uint16_t>(frame_size))
+    if (rx_next_ == rx_count_)
     {
-        // read and drop
-        std::string tmp(len, '\0');
-        readAll_(tmp.data(), len);
-        return -1;
+        if (tx_count_ > 0 && !flush_())
+            return -1;
+        if (!receive_())
+            return 0; // timeout -> 0
     }
-    if (!readAll_(frame, len))
-        return 0;
-    return static_cast<int32_t>(len);
+    auto const& d      = rx_desc_[rx_next_++];
+    uint8_t const* src = rx_payload_.data() + rx_offset_;
+    rx_offset_ += d.len;
+    if (d.len > static_cast<uint16_t>(frame_size))
+        return -1; // drop oversized frame
+    std::memcpy(frame, src, d.len);
+    return static_cast<int32_t>(d.len);
+}
+
+bool MasterSocket::flush_()
+{
+    // One message per batch: prelude + descriptors + payloads in a single sendmsg()
+    std::array<uint8_t, wire::headerSize(wire::kMaxFrames)> header{};
+    uint64_t now = wire::nowNs();
+    for (size_t i = 0; i < tx_count_; ++i)
+    {
+        tx_desc_[i].tx_ns                        = now;
+        sent_ns_[tx_desc_[i].index % kSentSlots] = now;
+    }
+    wire::Prelude prelude;
+    prelude.count = static_cast<uint8_t>(tx_count_);
+    prelude.seq   = tx_seq_++;
+    wire::encodeHeader(header.data(), prelude, tx_desc_.data());
+    iovec iov[2] = {{header.data(), wire::headerSize(tx_count_)},
+                    {tx_payload_.data(), tx_payload_.size()}};
+    in_flight_ += tx_count_; // earlier batches may still be unanswered
+    tx_count_ = 0;
+    bool ok   = communication::writeVectored(fd_, iov, 2, io_, timeout_);
+    tx_payload_.clear();
+    return ok;
+}
+
+bool MasterSocket::receive_()
+{
+    rx_count_  = 0;
+    rx_next_   = 0;
+    rx_offset_ = 0;
+    std::array<uint8_t, wire::headerSize(wire::kMaxFrames)> header{};
+    if (!readAll_(header.data(), 2))
+        return false;
+    if (!wire::isV2(header.data()))
+    {
+        uint16_t len = static_cast<uint16_t>((header[0] << 8) | header[1]);
+        rx_payload_.resize(len);
+        if (len == 0 || !readAll_(rx_payload_.data(), len))
+            return false;
+        rx_desc_[0]     = wire::FrameDescriptor{};
+        rx_desc_[0].len = len;
+        rx_count_       = 1;
+        return true;
+    }
+
+    wire::Prelude prelude;
+    if (!readAll_(header.data() + 2, wire::kPreludeSize - 2) ||
+        !wire::decodePrelude(header.data(), prelude))
+        return false;
+    uint8_t* descriptors = header.data() + wire::kPreludeSize;
+    if (!readAll_(descriptors, prelude.count * wire::kDescriptorSize) ||
+        !wire::decodeDescriptors(descriptors, prelude.count, rx_desc_.data()))
+        return false;
+    size_t total = 0;
+    for (size_t i = 0; i < prelude.count; ++i)
+        total += rx_desc_[i].len;
+    rx_payload_.resize(total);
+    if (!readAll_(rx_payload_.data(), total))
+        return false;
+    uint64_t now = wire::nowNs();
+    for (size_t i = 0; i < prelude.count; ++i)
+    {
+        auto& sent = sent_ns_[rx_desc_[i].index % kSentSlots];
+        account_(rx_desc_[i], sent);
+        sent = 0;
+    }
+    frames_.fetch_add(prelude.count, std::memory_order_relaxed);
+    last_downlink_ns_.store(static_cast<int64_t>(now - rx_desc_[prelude.count - 1].tx_ns),
+                            std::memory_order_relaxed);
+    in_flight_ -= std::min<std::size_t>(in_flight_, prelude.count);
+    rx_count_ = prelude.count;
+    return true;
+}
+
+void MasterSocket::account_(wire::FrameDescriptor const& reply, uint64_t sent_ns)
+{
+    if (sent_ns == 0)
+        return;
+    auto uplink = static_cast<int64_t>(reply.rx_ns - sent_ns);
+    auto rtt    = static_cast<int64_t>(wire::nowNs() - sent_ns);
+    last_uplink_ns_.store(uplink, std::memory_order_relaxed);
+    last_rtt_ns_.store(rtt, std::memory_order_relaxed);
+    if (rtt > max_rtt_ns_.load(std::memory_order_relaxed))
+        max_rtt_ns_.store(rtt, std::memory_order_relaxed);
+}
+
+MasterSocket::LinkLatency MasterSocket::latency() const noexcept
+{
+    LinkLatency l;
+    l.frames           = frames_.load(std::memory_order_relaxed);
+    l.last_uplink_ns   = last_uplink_ns_.load(std::memory_order_relaxed);
+    l.last_downlink_ns = last_downlink_ns_.load(std::memory_order_relaxed);
+    l.last_rtt_ns      = last_rtt_ns_.load(std::memory_order_relaxed);
+    l.max_rtt_ns       = max_rtt_ns_.load(std::memory_order_relaxed);
+    return l;
 }
 
 bool MasterSocket::connectUDS_(const std::string& path)
@@ -133,12 +242,15 @@ bool MasterSocket::connectUDS_(const std::string& path)
     }
     if (::connect(fd_, reinterpret_cast<sockaddr*>(&addr), len) < 0)
     {
-        ethercat_sim::framework::logger::Logger::error("Failed to connect to %s: %s", path.c_str(), std::strerror(errno));
+        // Callers retry while the slaves come up; they report the final failure
+        int const err = errno;
+        ethercat_sim::framework::logger::Logger::debug("Failed to connect to %s: %s", path.c_str(), std::strerror(err));
         ::close(fd_);
-        fd_ = -1;
+        fd_   = -1;
+        errno = err;
         return false;
     }
-    setTimeout(timeout_);
+    communication::configureSocket(fd_, io_);
     return true;
 }
 
@@ -153,47 +265,30 @@ bool MasterSocket::connectTCP_(const std::string& host, uint16_t port)
     if (::inet_pton(AF_INET, host.c_str(), &sa.sin_addr) != 1)
     {
         ::close(fd_);
-        fd_ = -1;
+        fd_   = -1;
+        errno = EINVAL;
         return false;
     }
     if (::connect(fd_, reinterpret_cast<sockaddr*>(&sa), sizeof(sa)) < 0)
     {
+        int const err = errno;
         ::close(fd_);
-        fd_ = -1;
+        fd_   = -1;
+        errno = err;
         return false;
     }
-    setTimeout(timeout_);
+    communication::configureSocket(fd_, io_);
     return true;
 }
 
 bool MasterSocket::writeAll_(const void* data, size_t len)
 {
-    const uint8_t* p = static_cast<const uint8_t*>(data);
-    size_t left      = len;
-    while (left > 0)
-    {
-        ssize_t n = ::send(fd_, p, left, 0);
-        if (n <= 0)
-            return false;
-        p += n;
-        left -= static_cast<size_t>(n);
-    }
-    return true;
+    return communication::writeExact(fd_, data, len, io_, timeout_);
 }
 
 bool MasterSocket::readAll_(void* data, size_t len)
 {
-    uint8_t* p  = static_cast<uint8_t*>(data);
-    size_t left = len;
-    while (left > 0)
-    {
-        ssize_t n = ::recv(fd_, p, left, 0);
-        if (n <= 0)
-            return false;
-        p += n;
-        left -= static_cast<size_t>(n);
-    }
-    return true;
+    return communication::readExact(fd_, data, len, io_, timeout_);
 }
 
 } // namespace ethercat_sim::bus
@@ -1,21 +1,41 @@
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <chrono>
 #include <cstdint>
 #include <string>
+#include <vector>
 
+#include "ethercat_sim/communication/socket_io.h"
+#include "ethercat_sim/communication/wire_protocol.h"
 #include "kickcat/AbstractSocket.h"
 
 namespace ethercat_sim::bus
 {
 
 // MasterSocket implements Kickcat's AbstractSocket and forwards EtherCAT frames
-// over a stream transport (UDS or TCP). The EtherCAT frame bytes are sent as-is
-// with a 16-bit big-endian length prefix to preserve message boundaries on streams.
+// over a stream transport (UDS or TCP), framed as described in wire_protocol.h.
+// - v2 (default): frames written by KickCAT are batched and sent as one message, with timestamps,
+//   when it starts reading the replies; replies are queued and handed out one per read().
+// - v1: each frame is sent alone behind a 16-bit big-endian length prefix.
 class MasterSocket : public ::kickcat::AbstractSocket
 {
   public:
-    explicit MasterSocket(std::string endpoint) : endpoint_(std::move(endpoint)) {}
+    // One-way latencies measured from v2 timestamps (CLOCK_MONOTONIC, same host only)
+    struct LinkLatency
+    {
+        std::uint64_t frames{0};
+        std::int64_t last_uplink_ns{0};   // master send -> slaves receive
+        std::int64_t last_downlink_ns{0}; // slaves send -> master receive
+        std::int64_t last_rtt_ns{0};
+        std::int64_t max_rtt_ns{0};
+    };
+
+    explicit MasterSocket(std::string endpoint, communication::IoPolicy io = {})
+        : endpoint_(std::move(endpoint)), io_(io)
+    {
+    }
 
     void open(std::string const& interface) override;
     void setTimeout(std::chrono::nanoseconds timeout) override;
@@ -23,15 +43,58 @@ class MasterSocket : public ::kickcat::AbstractSocket
     int32_t read(uint8_t* frame, int32_t frame_size) override;
     int32_t write(uint8_t const* frame, int32_t frame_size) override;
 
+    // 1 or 2; call before open()
+    void setWireVersion(int version)
+    {
+        wire_version_ = version == 1 ? 1 : 2;
+    }
+    int wireVersion() const noexcept
+    {
+        return wire_version_;
+    }
+
+    LinkLatency latency() const noexcept;
+
   private:
     int fd_{-1};
     std::string endpoint_;
+    communication::IoPolicy io_;
     std::chrono::nanoseconds timeout_{std::chrono::milliseconds(2)};
 
     bool connectUDS_(const std::string& path);
     bool connectTCP_(const std::string& host, uint16_t port);
     bool writeAll_(const void* data, size_t len);
     bool readAll_(void* data, size_t len);
+    bool flush_();
+    bool receive_();
+    void account_(communication::wire::FrameDescriptor const& reply, std::uint64_t sent_ns);
+
+    int wire_version_{2};
+
+    // Pending request batch (v2)
+    std::array<communication::wire::FrameDescriptor, communication::wire::kMaxFrames> tx_desc_{};
+    // Send time of the frames in flight, by frame index: several batches can be in flight when
+    // more than kMaxFrames frames are queued in one cycle (0 = slot free)
+    static constexpr std::size_t kSentSlots = 256;
+    std::array<std::uint64_t, kSentSlots> sent_ns_{};
+    std::vector<std::uint8_t> tx_payload_;
+    std::size_t tx_count_{0};
+    std::size_t in_flight_{0};
+    std::uint32_t tx_seq_{0};
+    std::uint16_t tx_index_{0};
+
+    // Received replies not yet handed to KickCAT
+    std::array<communication::wire::FrameDescriptor, communication::wire::kMaxFrames> rx_desc_{};
+    std::vector<std::uint8_t> rx_payload_;
+    std::size_t rx_count_{0};
+    std::size_t rx_next_{0};
+    std::size_t rx_offset_{0};
+
+    std::atomic<std::uint64_t> frames_{0};
+    std::atomic<std::int64_t> last_uplink_ns_{0};
+    std::atomic<std::int64_t> last_downlink_ns_{0};
+    std::atomic<std::int64_t> last_rtt_ns_{0};
+    std::atomic<std::int64_t> max_rtt_ns_{0};
 };
 
 } // namespace ethercat_sim::bus
@@ -1,6 +1,9 @@
 #include "master_tui.h"
 
+#include <algorithm>
 #include <chrono>
+#include <cstdint>
+#include <cstdio>
 #include <string>
 #include <thread>
 
@@ -92,28 +95,67 @@ void run_master_tui(std::shared_ptr<MasterController> controller,
 
     auto inputs = Container::Vertical({idx_input, sub_input, val_input, do_read, do_write});
 
+    // Rebuilt only when the model publishes a new version or the selection moves
+    std::uint64_t rows_version = 0;
+    int rows_selected          = -1;
+    std::vector<Element> rows;
+
+    // Hex dump of the first bytes of a process data section
+    auto hexBytes = [](std::uint8_t const* data, std::size_t len)
+    {
+        std::string out;
+        char buf[4];
+        for (std::size_t i = 0; i < std::min<std::size_t>(len, 16); ++i)
+        {
+            std::snprintf(buf, sizeof(buf), "%02X ", data[i]);
+            out += buf;
+        }
+        return out.empty() ? std::string("-") : out;
+    };
+
     auto renderer =
         Renderer(inputs,
                  [&]
                  {
-                     auto snap   = model->snapshot();
-                     auto status = text("status: " + snap.status);
-                     if (selected >= static_cast<int>(snap.slaves.size()))
-                         selected = static_cast<int>(snap.slaves.size()) - 1;
+                     auto snap   = model->current();
+                     auto status = text("status: " + snap->status);
+                     if (selected >= static_cast<int>(snap->slaves.size()))
+                         selected = static_cast<int>(snap->slaves.size()) - 1;
                      if (selected < 0)
                          selected = 0;
-                     std::vector<Element> rows;
-                     rows.push_back(hbox({text("Addr") | bold | underlined, text("  "),
-                                          text("State") | bold | underlined, text("  "),
-                                          text("AL") | bold | underlined}));
-                     for (size_t i = 0; i < snap.slaves.size(); ++i)
+                     if (rows.empty() || rows_version != snap->version || rows_selected != selected)
+                     {
+                         rows_version  = snap->version;
+                         rows_selected = selected;
+                         rows.clear();
+                         rows.push_back(hbox({text("Addr") | bold | underlined, text("  "),
+                                              text("State") | bold | underlined, text("  "),
+                                              text("AL") | bold | underlined}));
+                         for (size_t i = 0; i < snap->slaves.size(); ++i)
+                         {
+                             auto const& r = snap->slaves[i];
+                             auto line =
+                                 hbox({text(std::to_string(r.address)), text("  "),
+                                       text(stateName(r.state)), text("  "),
+                                       text(formatAlCode(r.al_code).data())});
+                             if (static_cast<int>(i) == selected)
+                                 line = line | inverted;
+                             rows.push_back(line);
+                         }
+                     }
+                     auto& image = controller->processImage();
+                     auto stats  = controller->cycleStats();
+                     Element pdo = text("PDO: not mapped");
+                     if (image.mapped())
                      {
-                         auto const& r = snap.slaves[i];
-                         auto line     = hbox({text(std::to_string(r.address)), text("  "),
-                                               text(r.state), text("  "), text(r.al_code)});
-                         if (static_cast<int>(i) == selected)
-                             line = line | inverted;
-                         rows.push_back(line);
+                         image.pollInputs();
+                         pdo = vbox({
+                             text("in : " + hexBytes(image.inputs(), image.inputSize())),
+                             text("cycles: " + std::to_string(stats.cycles) +
+                                  "  overruns: " + std::to_string(stats.overruns) +
+                                  "  jitter max: " + std::to_string(stats.max_jitter_ns / 1000) +
+                                  " us"),
+                         });
                      }
                      auto sdo_panel = vbox({
                                           text("SDO"),
@@ -121,19 +163,20 @@ void run_master_tui(std::shared_ptr<MasterController> controller,
                                           hbox({text("sub:"), separator(), sub_input->Render()}),
                                           hbox({text("value:"), separator(), val_input->Render()}),
                                           hbox({do_read->Render(), text("  "), do_write->Render()}),
-                                          text("last:" + snap.sdo_value_hex),
-                                          text("result:" + snap.sdo_status),
+                                          text("last:" + snap->sdo_value_hex),
+                                          text("result:" + snap->sdo_status),
                                       }) |
                                       border;
                      auto info =
                          vbox({
                              text("EtherCAT Master"),
                              separator(),
-                             text("slaves: " + std::to_string(snap.detected_slaves)),
-                             text(std::string("PREOP: ") + (snap.preop ? "yes" : "no")),
-                             text(std::string("OP: ") + (snap.operational ? "yes" : "no")),
+                             text("slaves: " + std::to_string(snap->detected_slaves)),
+                             text(std::string("PREOP: ") + (snap->preop ? "yes" : "no")),
+                             text(std::string("OP: ") + (snap->operational ? "yes" : "no")),
+                             pdo,
                              separator(),
-                             vbox(std::move(rows)) | frame,
+                             vbox(rows) | frame,
                              separator(),
                              text("keys: [s]can  [i]nit  [o]p  [Up/Down] select  [q]/[ESC] quit"),
                              separator(),
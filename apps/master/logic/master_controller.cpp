@@ -3,10 +3,8 @@
 #include <algorithm>
 #include <chrono>
 #include <cstdio>
-#include <iomanip>
 #include <iostream>
 #include <kickcat/Error.h>
-#include <sstream>
 #include <vector>
 
 #include "kickcat/Bus.h"
@@ -52,24 +50,26 @@ std::string stateToString(kickcat::State state)
     }
 }
 
-std::string formatAlStatusCode(uint16_t code)
-{
-    std::ostringstream oss;
-    oss << "0x" << std::uppercase << std::hex << std::setw(4) << std::setfill('0') << code;
-    return oss.str();
-}
-
 SlavesRow makeRow(kickcat::Slave const& slave)
 {
     SlavesRow row;
     row.address = slave.address;
-    row.state   = stateToString(normalizeState(slave.al_status));
-    row.al_code = formatAlStatusCode(slave.al_status_code);
+    row.state   = static_cast<uint8_t>(normalizeState(slave.al_status));
+    row.al_code = slave.al_status_code;
     return row;
 }
 
 } // namespace
 
+// KickCAT's Bus with mapping detection reachable, so the image size is known before
+// createMapping() writes the slave PIs into the iomap
+class MasterBus : public kickcat::Bus
+{
+  public:
+    using Bus::Bus;
+    using Bus::detectMapping;
+};
+
 MasterController::MasterController(std::string endpoint, int cycle_us)
     : endpoint_(std::move(endpoint)), cycle_us_(cycle_us)
 {
@@ -105,13 +105,14 @@ void MasterController::ensureBus_()
     {
         return;
     }
-    sock_ = std::make_shared<bus::MasterSocket>(endpoint_);
+    sock_ = std::make_shared<bus::MasterSocket>(endpoint_, io_);
+    sock_->setWireVersion(wire_version_);
     sock_->open("");
     sock_->setTimeout(200ms);
     auto redundancy = std::make_shared<::kickcat::SocketNull>();
     link_           = std::make_shared<kickcat::Link>(sock_, redundancy, [] {});
     link_->setTimeout(200ms);
-    bus_ = std::make_unique<kickcat::Bus>(link_);
+    bus_ = std::make_unique<MasterBus>(link_);
     bus_->configureWaitLatency(1ms, 20ms);
 }
 
@@ -162,20 +163,19 @@ void MasterController::refreshSlaveAlStatusUnlocked_()
     }
 }
 
-std::vector<SlavesRow> MasterController::snapshotSlavesUnlocked_()
+std::vector<SlavesRow> const& MasterController::snapshotSlavesUnlocked_()
 {
-    std::vector<SlavesRow> rows;
+    // Reuse the scratch vector so the cyclic task does not allocate once the size is stable.
+    rows_.clear();
     if (!bus_)
     {
-        return rows;
+        return rows_;
     }
-    auto const& slaves = bus_->slaves();
-    rows.reserve(slaves.size());
-    for (auto const& slave : slaves)
+    for (auto const& slave : bus_->slaves())
     {
-        rows.push_back(makeRow(slave));
+        rows_.push_back(makeRow(slave));
     }
-    return rows;
+    return rows_;
 }
 
 bool MasterController::allSlavesInStateUnlocked_(kickcat::State state) const
@@ -346,8 +346,7 @@ void MasterController::initPreop()
         initReached  = initReached || allSlavesInStateUnlocked_(kickcat::State::INIT);
         preopReached = preopReached || allSlavesInStateUnlocked_(kickcat::State::PRE_OP);
 
-        auto rows = snapshotSlavesUnlocked_();
-        model_->setSlaves(std::move(rows));
+        model_->setSlaves(snapshotSlavesUnlocked_());
         model_->setPreop(preopReached);
 
         if (preopReached)
@@ -388,11 +387,14 @@ void MasterController::requestOperational()
                 return;
             }
         }
-        std::vector<uint8_t> iomap(4096, 0);
-        bus_->createMapping(iomap.data());
+        if (!mapProcessImageUnlocked_())
+        {
+            model_->setStatus("op err: process image too large");
+            return;
+        }
         bus_->requestState(kickcat::State::OPERATIONAL);
         bus_->waitForState(kickcat::State::OPERATIONAL, 2000ms,
-                           [&] { bus_->processDataReadWrite([](auto const&) {}); });
+                           [&] { exchangeProcessDataUnlocked_(); });
         refreshSlaveAlStatusUnlocked_();
         model_->setSlaves(snapshotSlavesUnlocked_());
         model_->setOperational(true);
@@ -404,31 +406,168 @@ void MasterController::requestOperational()
     }
 }
 
+bool MasterController::mapProcessImageUnlocked_()
+{
+    // KickCAT lays out all inputs first, then all outputs, inside the buffer we hand it; refuse
+    // an image that does not fit before it writes past the end
+    bus_->detectMapping();
+    std::size_t required = 0;
+    for (auto const& slave : bus_->slaves())
+    {
+        required += static_cast<std::size_t>(std::max(slave.input.bsize, 0)) +
+                    static_cast<std::size_t>(std::max(slave.output.bsize, 0));
+    }
+    if (required > image_.capacity())
+    {
+        ethercat_sim::framework::logger::Logger::error(
+            "process image needs %zu bytes, iomap holds %zu", required, image_.capacity());
+        return false;
+    }
+
+    uint8_t* base = image_.iomap();
+    bus_->createMapping(base);
+
+    std::size_t in_begin = image_.capacity(), in_end = 0;
+    std::size_t out_begin = image_.capacity(), out_end = 0;
+    for (auto const& slave : bus_->slaves())
+    {
+        if (slave.input.bsize > 0 && slave.input.data)
+        {
+            auto off = static_cast<std::size_t>(slave.input.data - base);
+            in_begin = std::min(in_begin, off);
+            in_end   = std::max(in_end, off + static_cast<std::size_t>(slave.input.bsize));
+        }
+        if (slave.output.bsize > 0 && slave.output.data)
+        {
+            auto off  = static_cast<std::size_t>(slave.output.data - base);
+            out_begin = std::min(out_begin, off);
+            out_end   = std::max(out_end, off + static_cast<std::size_t>(slave.output.bsize));
+        }
+    }
+    if (in_end == 0)
+    {
+        in_begin = 0;
+    }
+    if (out_end == 0)
+    {
+        out_begin = 0;
+    }
+    bool ok = image_.setLayout(in_begin, in_end - in_begin, out_begin, out_end - out_begin);
+    if (ok)
+    {
+        ethercat_sim::framework::logger::Logger::info(
+            "process image mapped: inputs %zu bytes @%zu, outputs %zu bytes @%zu",
+            in_end - in_begin, in_begin, out_end - out_begin, out_begin);
+    }
+    return ok;
+}
+
+void MasterController::exchangeProcessDataUnlocked_()
+{
+    image_.applyOutputs();
+    bool failed = false;
+    bus_->processDataReadWrite([&](auto const&) { failed = true; });
+    if (failed)
+    {
+        pd_errors_.fetch_add(1, std::memory_order_relaxed);
+    }
+    image_.latchInputs();
+    if (cycle_hook_)
+    {
+        cycle_hook_(image_);
+    }
+}
+
+void MasterController::setCycleHook(CycleHook hook)
+{
+    std::lock_guard<std::mutex> guard(bus_mutex_);
+    cycle_hook_ = std::move(hook);
+}
+
+CycleStats MasterController::cycleStats() const
+{
+    CycleStats s;
+    s.cycles         = cycles_.load(std::memory_order_relaxed);
+    s.overruns       = overruns_.load(std::memory_order_relaxed);
+    s.pd_errors      = pd_errors_.load(std::memory_order_relaxed);
+    s.last_jitter_ns = last_jitter_ns_.load(std::memory_order_relaxed);
+    s.max_jitter_ns  = max_jitter_ns_.load(std::memory_order_relaxed);
+    if (s.cycles > s.overruns)
+    {
+        s.mean_jitter_ns = jitter_sum_ns_.load(std::memory_order_relaxed) /
+                           static_cast<std::int64_t>(s.cycles - s.overruns);
+    }
+    return s;
+}
+
 void MasterController::run_()
 {
     model_->setStatus("ready - press 's' to scan");
 
-    auto period = std::chrono::microseconds(cycle_us_);
+    if (rt_.enabled())
+    {
+        std::string err;
+        if (applyRtToCurrentThread(rt_, &err))
+        {
+            ethercat_sim::framework::logger::Logger::info(
+                "cyclic thread RT: prio=%d cpu=%d mlock=%s", rt_.priority, rt_.cpu,
+                rt_.lock_memory ? "on" : "off");
+        }
+        else
+        {
+            ethercat_sim::framework::logger::Logger::warn("cyclic thread RT setup: %s",
+                                                          err.c_str());
+        }
+    }
+
+    // Deadline scheduling: wake-ups are anchored to an absolute timeline so processing time and
+    // sleep inaccuracy do not accumulate. Missed deadlines are counted and the timeline restarts.
+    auto const period = std::chrono::microseconds(cycle_us_);
+    auto deadline     = std::chrono::steady_clock::now() + period;
     while (!stop_.load())
     {
         try
         {
-            std::vector<SlavesRow> rows;
+            std::lock_guard<std::mutex> guard(bus_mutex_);
+            ensureBus_();
+            // A mapping without PDOs has no logical datagram to exchange; keep the link alive
+            if (image_.mapped() && image_.inputSize() + image_.outputSize() > 0)
+            {
+                exchangeProcessDataUnlocked_();
+            }
+            else
             {
-                std::lock_guard<std::mutex> guard(bus_mutex_);
-                ensureBus_();
                 bus_->sendNop([](auto const&) {});
                 bus_->finalizeDatagrams();
                 bus_->processAwaitingFrames();
-                rows = snapshotSlavesUnlocked_();
             }
-            model_->setSlaves(std::move(rows));
+            // Only publishes (and bumps the model version) when a row actually changed
+            model_->setSlaves(snapshotSlavesUnlocked_());
         }
         catch (...)
         {
             // ignore transient errors
         }
-        std::this_thread::sleep_for(period);
+        cycles_.fetch_add(1, std::memory_order_relaxed);
+
+        auto now = std::chrono::steady_clock::now();
+        if (now > deadline)
+        {
+            overruns_.fetch_add(1, std::memory_order_relaxed);
+            deadline = now + period;
+            continue;
+        }
+        std::this_thread::sleep_until(deadline);
+        auto jitter = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                          std::chrono::steady_clock::now() - deadline)
+                          .count();
+        last_jitter_ns_.store(jitter, std::memory_order_relaxed);
+        jitter_sum_ns_.fetch_add(jitter, std::memory_order_relaxed);
+        if (jitter > max_jitter_ns_.load(std::memory_order_relaxed))
+        {
+            max_jitter_ns_.store(jitter, std::memory_order_relaxed);
+        }
+        deadline += period;
     }
 }
 
@@ -3,13 +3,17 @@
 #include <atomic>
 #include <chrono>
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <string>
 #include <thread>
 #include <vector>
 
+#include "ethercat_sim/app/rt_config.h"
+#include "ethercat_sim/communication/socket_io.h"
 #include "master_model.h"
+#include "process_image.h"
 
 namespace kickcat
 {
@@ -28,12 +32,43 @@ class MasterSocket;
 namespace ethercat_sim::app::master
 {
 
+class MasterBus;
+
+// Cyclic task statistics (updated by the cyclic thread, read from anywhere)
+struct CycleStats
+{
+    std::uint64_t cycles{0};
+    std::uint64_t overruns{0};  // cycles that finished after their deadline
+    std::uint64_t pd_errors{0}; // process data exchanges reporting a datagram error
+    std::int64_t last_jitter_ns{0};
+    std::int64_t max_jitter_ns{0};
+    std::int64_t mean_jitter_ns{0};
+};
+
 class MasterController
 {
   public:
     MasterController(std::string endpoint, int cycle_us);
     ~MasterController();
 
+    // Real-time settings applied by the cyclic thread when it starts; call before start()
+    void setRtConfig(RtConfig cfg)
+    {
+        rt_ = cfg;
+    }
+
+    // Socket wait strategy (e.g. busy polling); call before the bus is first used
+    void setIoPolicy(communication::IoPolicy io)
+    {
+        io_ = io;
+    }
+
+    // Stream framing towards the slaves (2 = batched/timestamped, 1 = legacy length prefix)
+    void setWireVersion(int version)
+    {
+        wire_version_ = version;
+    }
+
     void start();
     void stop();
 
@@ -49,12 +84,28 @@ class MasterController
         return model_;
     }
 
+    // Process data views, valid once requestOperational() mapped the image. Inputs have a single
+    // reader and outputs a single writer; neither side blocks the cyclic task.
+    ProcessImage& processImage()
+    {
+        return image_;
+    }
+
+    CycleStats cycleStats() const;
+
+    // Called by the cyclic task right after every process data exchange, with the bus lock held;
+    // must not block (e.g. publish the image to other processes).
+    using CycleHook = std::function<void(ProcessImage const&)>;
+    void setCycleHook(CycleHook hook);
+
   private:
     void run_();
+    void exchangeProcessDataUnlocked_();
+    bool mapProcessImageUnlocked_();
     void ensureBus_();
     int32_t detectSlavesWithRetries_(int attempts, std::chrono::milliseconds delay);
     void refreshSlaveAlStatusUnlocked_();
-    std::vector<SlavesRow> snapshotSlavesUnlocked_();
+    std::vector<SlavesRow> const& snapshotSlavesUnlocked_();
     bool allSlavesInStateUnlocked_(kickcat::State state) const;
     bool requestAndWaitStateUnlocked_(kickcat::State target, std::chrono::milliseconds timeout);
 
@@ -63,7 +114,20 @@ class MasterController
     std::shared_ptr<MasterModel> model_{std::make_shared<MasterModel>()};
     std::shared_ptr<bus::MasterSocket> sock_;
     std::shared_ptr<kickcat::Link> link_;
-    std::unique_ptr<kickcat::Bus> bus_;
+    std::unique_ptr<MasterBus> bus_;
+    std::vector<SlavesRow> rows_; // scratch rows, guarded by bus_mutex_
+    ProcessImage image_;          // persistent iomap; mapping guarded by bus_mutex_
+    CycleHook cycle_hook_;        // guarded by bus_mutex_
+
+    std::atomic<std::uint64_t> cycles_{0};
+    std::atomic<std::uint64_t> overruns_{0};
+    std::atomic<std::uint64_t> pd_errors_{0};
+    std::atomic<std::int64_t> last_jitter_ns_{0};
+    std::atomic<std::int64_t> max_jitter_ns_{0};
+    std::atomic<std::int64_t> jitter_sum_ns_{0};
+    RtConfig rt_;
+    communication::IoPolicy io_;
+    int wire_version_{2};
 
     std::thread th_;
     std::atomic_bool stop_{false};
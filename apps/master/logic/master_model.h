@@ -1,5 +1,10 @@
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <vector>
@@ -7,15 +12,53 @@
 namespace ethercat_sim::app::master
 {
 
+// Compact, trivially copyable per-slave row. Rows are rebuilt by the cyclic task, so they must not
+// own heap memory; text formatting is left to the views (see stateName()/formatAlCode()).
 struct SlavesRow
 {
-    int address{0};
-    std::string state;
-    std::string al_code;
+    std::uint16_t address{0};
+    std::uint16_t al_code{0};
+    std::uint8_t state{0}; // AL state bits (INIT=1, PRE_OP=2, BOOT=3, SAFE_OP=4, OP=8)
+
+    bool operator==(SlavesRow const& o) const noexcept
+    {
+        return address == o.address && al_code == o.al_code && state == o.state;
+    }
+    bool operator!=(SlavesRow const& o) const noexcept
+    {
+        return !(*this == o);
+    }
 };
 
+inline char const* stateName(std::uint8_t state) noexcept
+{
+    switch (state & 0x0F)
+    {
+    case 0x01:
+        return "INIT";
+    case 0x02:
+        return "PRE_OP";
+    case 0x03:
+        return "BOOT";
+    case 0x04:
+        return "SAFE_OP";
+    case 0x08:
+        return "OP";
+    default:
+        return "INVALID";
+    }
+}
+
+inline std::array<char, 8> formatAlCode(std::uint16_t code) noexcept
+{
+    std::array<char, 8> buf{};
+    std::snprintf(buf.data(), buf.size(), "0x%04X", code);
+    return buf;
+}
+
 struct MasterSnapshot
 {
+    std::uint64_t version{0}; // bumped on every published change
     int detected_slaves{0};
     bool preop{false};
     bool operational{false};
@@ -26,59 +69,110 @@ struct MasterSnapshot
     std::string sdo_value_hex;
 };
 
+// MasterModel publishes immutable, versioned snapshots (RCU-style double buffer).
+// - Readers call current() to get the latest snapshot without copying it, or version() to skip
+//   work when nothing changed since their last look.
+// - Writers are serialized; an update that does not change anything is not published. The
+//   retired buffer is recycled once no reader holds it, so steady-state updates do not allocate.
 class MasterModel
 {
   public:
     void setDetectedSlaves(int n)
     {
-        std::lock_guard<std::mutex> l(m_);
-        snap_.detected_slaves = n;
+        update_([&](MasterSnapshot const& s) { return s.detected_slaves != n; },
+                [&](MasterSnapshot& s) { s.detected_slaves = n; });
     }
     void setPreop(bool v)
     {
-        std::lock_guard<std::mutex> l(m_);
-        snap_.preop = v;
+        update_([&](MasterSnapshot const& s) { return s.preop != v; },
+                [&](MasterSnapshot& s) { s.preop = v; });
     }
     void setOperational(bool v)
     {
-        std::lock_guard<std::mutex> l(m_);
-        snap_.operational = v;
+        update_([&](MasterSnapshot const& s) { return s.operational != v; },
+                [&](MasterSnapshot& s) { s.operational = v; });
     }
-    void setStatus(std::string s)
+    void setStatus(std::string v)
     {
-        std::lock_guard<std::mutex> l(m_);
-        snap_.status = std::move(s);
+        update_([&](MasterSnapshot const& s) { return s.status != v; },
+                [&](MasterSnapshot& s) { s.status = std::move(v); });
     }
 
-    void setSlaves(std::vector<SlavesRow> rows)
+    void setSlaves(std::vector<SlavesRow> const& rows)
     {
-        std::lock_guard<std::mutex> l(m_);
-        snap_.slaves = std::move(rows);
+        update_([&](MasterSnapshot const& s) { return s.slaves != rows; },
+                [&](MasterSnapshot& s) { s.slaves = rows; });
     }
     void setSelectedSlaves(int i)
     {
-        std::lock_guard<std::mutex> l(m_);
-        snap_.selected_slaves = i;
+        update_([&](MasterSnapshot const& s) { return s.selected_slaves != i; },
+                [&](MasterSnapshot& s) { s.selected_slaves = i; });
     }
-    void setSdoStatus(std::string s)
+    void setSdoStatus(std::string v)
     {
-        std::lock_guard<std::mutex> l(m_);
-        snap_.sdo_status = std::move(s);
+        update_([&](MasterSnapshot const& s) { return s.sdo_status != v; },
+                [&](MasterSnapshot& s) { s.sdo_status = std::move(v); });
     }
     void setSdoValueHex(std::string v)
     {
-        std::lock_guard<std::mutex> l(m_);
-        snap_.sdo_value_hex = std::move(v);
+        update_([&](MasterSnapshot const& s) { return s.sdo_value_hex != v; },
+                [&](MasterSnapshot& s) { s.sdo_value_hex = std::move(v); });
+    }
+
+    // Latest published snapshot; never blocks on writers and never copies the rows.
+    std::shared_ptr<MasterSnapshot const> current() const
+    {
+        return std::atomic_load_explicit(&front_, std::memory_order_acquire);
+    }
+
+    // Version of the latest published snapshot (cheap change detection for readers).
+    std::uint64_t version() const noexcept
+    {
+        return version_.load(std::memory_order_acquire);
     }
+
     MasterSnapshot snapshot() const
     {
-        std::lock_guard<std::mutex> l(m_);
-        return snap_;
+        return *current();
     }
 
   private:
-    mutable std::mutex m_;
-    MasterSnapshot snap_{};
+    template <typename Changed, typename Apply> void update_(Changed&& changed, Apply&& apply)
+    {
+        std::lock_guard<std::mutex> l(write_m_);
+        auto cur = std::atomic_load_explicit(&front_, std::memory_order_relaxed);
+        if (!changed(*cur))
+        {
+            return;
+        }
+        auto next = reclaimBack_();
+        *next     = *cur; // copy-assign reuses the recycled buffer's capacity
+        apply(*next);
+        next->version = cur->version + 1;
+        // Publish before bumping the version: a reader that sees the new version must find the
+        // new snapshot behind front_
+        std::atomic_store_explicit(&front_, std::shared_ptr<MasterSnapshot const>(next),
+                                   std::memory_order_release);
+        version_.store(next->version, std::memory_order_release);
+        back_ = std::const_pointer_cast<MasterSnapshot>(std::move(cur));
+    }
+
+    std::shared_ptr<MasterSnapshot> reclaimBack_()
+    {
+        // back_ is no longer reachable through front_, so its use count can only go down; once we
+        // are the sole owner no reader can observe the rewrite.
+        if (back_ && back_.use_count() == 1)
+        {
+            std::atomic_thread_fence(std::memory_order_acquire);
+            return std::move(back_);
+        }
+        return std::make_shared<MasterSnapshot>();
+    }
+
+    std::mutex write_m_;
+    std::shared_ptr<MasterSnapshot const> front_{std::make_shared<MasterSnapshot const>()};
+    std::shared_ptr<MasterSnapshot> back_;
+    std::atomic<std::uint64_t> version_{0};
 };
 
 } // namespace ethercat_sim::app::master
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <unistd.h>
+
+#include "ethercat_sim/framework/concurrency/triple_buffer.h"
+
+namespace ethercat_sim::app::master
+{
+
+// Persistent process image shared between KickCAT and the application.
+// - The iomap handed to Bus::createMapping() is page-aligned and lives as long as the controller,
+//   so the slave PI pointers set up by KickCAT stay valid for every cycle.
+// - The cyclic task copies received inputs into a triple buffer and picks up the latest outputs
+//   from another one; the application side never blocks the cycle (one reader, one writer).
+class ProcessImage
+{
+  public:
+    static constexpr std::size_t kDefaultCapacity = 4096;
+
+    explicit ProcessImage(std::size_t capacity = kDefaultCapacity)
+    {
+        long sys_page    = ::sysconf(_SC_PAGESIZE);
+        std::size_t page = sys_page > 0 ? static_cast<std::size_t>(sys_page) : 4096;
+        capacity_        = std::max<std::size_t>((capacity + page - 1) / page * page, page);
+        void* p          = nullptr;
+        if (::posix_memalign(&p, page, capacity_) != 0)
+        {
+            throw std::bad_alloc();
+        }
+        std::memset(p, 0, capacity_);
+        iomap_.reset(static_cast<std::uint8_t*>(p));
+    }
+
+    ProcessImage(ProcessImage const&)            = delete;
+    ProcessImage& operator=(ProcessImage const&) = delete;
+
+    std::uint8_t* iomap() noexcept
+    {
+        return iomap_.get();
+    }
+    std::size_t capacity() const noexcept
+    {
+        return capacity_;
+    }
+
+    // Declares where KickCAT placed the input (slave->master) and output sections.
+    // Not thread-safe: call while the cyclic task is not exchanging process data.
+    bool setLayout(std::size_t in_offset, std::size_t in_size, std::size_t out_offset,
+                   std::size_t out_size)
+    {
+        if (in_offset + in_size > capacity_ || out_offset + out_size > capacity_)
+        {
+            return false;
+        }
+        in_offset_  = in_offset;
+        out_offset_ = out_offset;
+        inputs_.resize(in_size);
+        outputs_.resize(out_size);
+        std::memcpy(outputs_.writeBuffer(), iomap_.get() + out_offset_, out_size);
+        outputs_.publishKeep();
+        mapped_ = true;
+        return true;
+    }
+
+    bool mapped() const noexcept
+    {
+        return mapped_;
+    }
+
+    // Raw iomap sections; only stable from the cyclic task (e.g. inside a cycle hook)
+    std::uint8_t const* inputSection() const noexcept
+    {
+        return iomap_.get() + in_offset_;
+    }
+    std::uint8_t const* outputSection() const noexcept
+    {
+        return iomap_.get() + out_offset_;
+    }
+
+    // Cyclic task: before the exchange, copy the latest application outputs into the iomap
+    void applyOutputs() noexcept
+    {
+        if (outputs_.update())
+        {
+            std::memcpy(iomap_.get() + out_offset_, outputs_.readBuffer(), outputs_.size());
+        }
+    }
+
+    // Cyclic task: after the exchange, publish the received inputs
+    void latchInputs() noexcept
+    {
+        std::memcpy(inputs_.writeBuffer(), iomap_.get() + in_offset_, inputs_.size());
+        inputs_.publish();
+    }
+
+    // Application side (single reader): refresh and read the latest inputs
+    bool pollInputs() noexcept
+    {
+        return inputs_.update();
+    }
+    std::uint8_t const* inputs() const noexcept
+    {
+        return inputs_.readBuffer();
+    }
+    std::size_t inputSize() const noexcept
+    {
+        return inputs_.size();
+    }
+
+    // Application side (single writer): edit outputs in place, then commit them to the cycle
+    std::uint8_t* outputs() noexcept
+    {
+        return outputs_.writeBuffer();
+    }
+    std::size_t outputSize() const noexcept
+    {
+        return outputs_.size();
+    }
+    void commitOutputs() noexcept
+    {
+        outputs_.publishKeep();
+    }
+
+  private:
+    struct FreeDeleter
+    {
+        void operator()(std::uint8_t* p) const noexcept
+        {
+            std::free(p);
+        }
+    };
+
+    std::unique_ptr<std::uint8_t, FreeDeleter> iomap_;
+    std::size_t capacity_{0};
+    std::size_t in_offset_{0};
+    std::size_t out_offset_{0};
+    bool mapped_{false};
+    framework::concurrency::TripleBuffer inputs_;
+    framework::concurrency::TripleBuffer outputs_;
+};
+
+} // namespace ethercat_sim::app::master
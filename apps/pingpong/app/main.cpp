@@ -0,0 +1,461 @@
+// Transport ping-pong: drives an in-process MasterSocket <-> SlavesEndpoint pair over each
+// requested transport and reports throughput and round-trip latency percentiles, so uds:// and
+// tcp:// (and later transports) can be compared on the same frame workload.
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include "kickcat/Frame.h"
+#include "kickcat/protocol.h"
+
+#include "bus/master_socket.h"
+#include "bus/slaves_endpoint.h"
+#include "ethercat_sim/app/rt_config.h"
+#include "ethercat_sim/communication/socket_io.h"
+#include "framework/logger/logger.h"
+
+namespace
+{
+
+using clock = std::chrono::steady_clock;
+
+// Datagram mix carried by every frame
+enum class Mix
+{
+    Fprd,  // one FPRD of --size bytes from the first slave
+    Lrw,   // one LRW of --size bytes of process image
+    Cyclic // LRW of --size bytes + FPRD AL_STATUS of every slave (a typical cycle frame)
+};
+
+struct Options
+{
+    std::vector<std::string> transports{"uds", "tcp"};
+    std::string tcp{"127.0.0.1:47170"};
+    Mix mix{Mix::Cyclic};
+    std::size_t size{64};
+    std::size_t slaves{8};
+    int depth{1};
+    int rounds{20000};
+    int warmup{1000};
+    int wire{2};
+    int slaves_cpu{-1};
+    ethercat_sim::bus::SlavesEndpoint::Backend backend{
+        ethercat_sim::bus::SlavesEndpoint::Backend::Poll};
+    ethercat_sim::communication::IoPolicy io;
+    ethercat_sim::app::RtConfig rt;
+};
+
+struct Result
+{
+    std::string endpoint;
+    std::vector<std::int64_t> rtt_ns; // one sample per round of `depth` frames
+    std::size_t frames{0};
+    std::size_t frame_bytes{0};
+    double seconds{0};
+    int errors{0};
+    ethercat_sim::bus::SlavesEndpoint::ServerStats server;
+};
+
+void usage(char const* argv0)
+{
+    std::fprintf(stderr,
+                 "Usage: %s [--transport uds,tcp] [--tcp HOST:PORT] [--mix fprd|lrw|cyclic]\n"
+                 "          [--size BYTES] [--slaves N] [--depth N] [--rounds N] [--warmup N]\n"
+                 "          [--wire-v1] [--io-uring] [--busy-poll] [--spin-us N]\n"
+                 "          [--slaves-cpu N] %s\n"
+                 "  --depth N       frames in flight per round trip (written before reading)\n"
+                 "  --cpu N         pin the master thread; --slaves-cpu pins the server threads\n",
+                 argv0, ethercat_sim::app::rtUsage());
+}
+
+bool parseMix(std::string const& s, Mix& mix)
+{
+    if (s == "fprd")
+    {
+        mix = Mix::Fprd;
+    }
+    else if (s == "lrw")
+    {
+        mix = Mix::Lrw;
+    }
+    else if (s == "cyclic")
+    {
+        mix = Mix::Cyclic;
+    }
+    else
+    {
+        return false;
+    }
+    return true;
+}
+
+char const* mixName(Mix mix)
+{
+    switch (mix)
+    {
+    case Mix::Fprd:
+        return "fprd";
+    case Mix::Lrw:
+        return "lrw";
+    default:
+        return "cyclic";
+    }
+}
+
+// Consumes the value of the option at argv[i]: a whole decimal in [lo, hi], else the problem is
+// printed and false returned
+bool intArg(char** argv, int& i, long lo, long hi, int& out)
+{
+    char const* name = argv[i];
+    if (ethercat_sim::app::detail::parseIntIn(argv[++i], lo, hi, out))
+    {
+        return true;
+    }
+    std::fprintf(stderr, "%s: expected %ld..%ld, got '%s'\n", name, lo, hi, argv[i]);
+    return false;
+}
+
+std::vector<std::string> splitList(std::string const& s)
+{
+    std::vector<std::string> out;
+    std::stringstream ss(s);
+    for (std::string item; std::getline(ss, item, ',');)
+    {
+        if (!item.empty())
+        {
+            out.push_back(item);
+        }
+    }
+    return out;
+}
+
+std::vector<uint8_t> buildFrame(Options const& opt)
+{
+    ::kickcat::Frame frame;
+    std::vector<uint8_t> payload(opt.size, 0);
+    uint16_t al_status = 0;
+    auto const len     = static_cast<uint16_t>(opt.size);
+    switch (opt.mix)
+    {
+    case Mix::Fprd:
+        frame.addDatagram(0, ::kickcat::Command::FPRD, ::kickcat::createAddress(1, 0x0000),
+                          payload.data(), len);
+        break;
+    case Mix::Lrw:
+        frame.addDatagram(0, ::kickcat::Command::LRW, 0, payload.data(), len);
+        break;
+    case Mix::Cyclic:
+        frame.addDatagram(0, ::kickcat::Command::LRW, 0, payload.data(), len);
+        for (std::size_t i = 0; i < opt.slaves; ++i)
+        {
+            frame.addDatagram(static_cast<uint8_t>(1 + i), ::kickcat::Command::FPRD,
+                              ::kickcat::createAddress(static_cast<uint16_t>(1 + i),
+                                                       ::kickcat::reg::AL_STATUS),
+                              &al_status, sizeof(al_status));
+        }
+        break;
+    }
+    int32_t size = frame.finalize();
+    return std::vector<uint8_t>(frame.data(), frame.data() + size);
+}
+
+void pinCurrentThread(ethercat_sim::app::RtConfig cfg, int cpu, char const* who)
+{
+    cfg.cpu = cpu;
+    std::string err;
+    if (!ethercat_sim::app::applyRtToCurrentThread(cfg, &err))
+    {
+        std::fprintf(stderr, "%s thread RT settings: %s\n", who, err.c_str());
+    }
+}
+
+bool runTransport(Options const& opt, std::string const& endpoint, Result& res)
+{
+    res.endpoint = endpoint;
+    std::atomic_bool stop{false};
+    ethercat_sim::bus::SlavesEndpoint server(endpoint);
+    server.setSlavesCount(opt.slaves);
+    server.setStopFlag(&stop);
+    server.setIoPolicy(opt.io);
+    server.setBackend(opt.backend);
+    std::thread server_thread(
+        [&]
+        {
+            // Threads spawned by the poll backend inherit this affinity
+            pinCurrentThread(opt.rt, opt.slaves_cpu, "slaves");
+            server.run();
+        });
+
+    ethercat_sim::bus::MasterSocket sock(endpoint, opt.io);
+    sock.setWireVersion(opt.wire);
+    for (int attempt = 0;; ++attempt)
+    {
+        try
+        {
+            sock.open("");
+            break;
+        }
+        catch (std::exception const& e)
+        {
+            // The server thread may not be listening yet: only the last attempt is an error
+            if (attempt > 100)
+            {
+                ethercat_sim::framework::logger::Logger::error("cannot connect to %s: %s",
+                                                               endpoint.c_str(), e.what());
+                stop.store(true);
+                server_thread.join();
+                return false;
+            }
+            ethercat_sim::framework::logger::Logger::debug("connect attempt %d: %s", attempt + 1,
+                                                           e.what());
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        }
+    }
+    sock.setTimeout(std::chrono::seconds(1));
+
+    auto const tx   = buildFrame(opt);
+    auto const size = static_cast<int32_t>(tx.size());
+    std::vector<uint8_t> rx(::kickcat::ETH_MAX_SIZE);
+    auto round = [&]
+    {
+        bool ok = true;
+        for (int d = 0; d < opt.depth && ok; ++d)
+        {
+            ok = sock.write(tx.data(), size) == size;
+        }
+        for (int d = 0; d < opt.depth && ok; ++d)
+        {
+            ok = sock.read(rx.data(), static_cast<int32_t>(rx.size())) == size;
+        }
+        return ok;
+    };
+
+    for (int i = 0; i < opt.warmup; ++i)
+    {
+        (void) round();
+    }
+    res.frame_bytes = tx.size();
+    res.rtt_ns.reserve(static_cast<std::size_t>(opt.rounds));
+    auto const start = clock::now();
+    for (int i = 0; i < opt.rounds; ++i)
+    {
+        auto t0 = clock::now();
+        if (!round())
+        {
+            ++res.errors;
+            continue;
+        }
+        res.rtt_ns.push_back(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - t0).count());
+    }
+    res.seconds = std::chrono::duration<double>(clock::now() - start).count();
+    res.frames  = res.rtt_ns.size() * static_cast<std::size_t>(opt.depth);
+
+    sock.close();
+    res.server = server.stats();
+    stop.store(true);
+    server_thread.join();
+    return !res.rtt_ns.empty();
+}
+
+void report(Result& r)
+{
+    std::sort(r.rtt_ns.begin(), r.rtt_ns.end());
+    auto pct = [&](double p)
+    {
+        auto idx = static_cast<std::size_t>(p * static_cast<double>(r.rtt_ns.size() - 1));
+        return static_cast<double>(r.rtt_ns[idx]) / 1000.0;
+    };
+    double const fps = static_cast<double>(r.frames) / r.seconds;
+    std::printf("%-42s %10.0f %8.1f %8.1f %8.1f %8.1f %8.1f %6d %7.2f\n", r.endpoint.c_str(), fps,
+                fps * static_cast<double>(r.frame_bytes) / 1e6, pct(0.50), pct(0.99), pct(0.999),
+                static_cast<double>(r.rtt_ns.back()) / 1000.0, r.errors,
+                r.server.frames ? static_cast<double>(r.server.syscalls) / r.server.frames : 0.0);
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options opt;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string a = argv[i];
+        std::string rt_err;
+        if (ethercat_sim::app::parseRtOption(argc, argv, i, opt.rt, &rt_err))
+        {
+            if (!rt_err.empty())
+            {
+                std::fprintf(stderr, "%s\n", rt_err.c_str());
+                usage(argv[0]);
+                return 2;
+            }
+            continue;
+        }
+        if (a == "--transport" && i + 1 < argc)
+        {
+            opt.transports = splitList(argv[++i]);
+        }
+        else if (a == "--tcp" && i + 1 < argc)
+        {
+            opt.tcp = argv[++i];
+        }
+        else if (a == "--mix" && i + 1 < argc)
+        {
+            if (!parseMix(argv[++i], opt.mix))
+            {
+                usage(argv[0]);
+                return 2;
+            }
+        }
+        else if (a == "--size" && i + 1 < argc)
+        {
+            int bytes = 0;
+            if (!intArg(argv, i, 1, 65535, bytes))
+            {
+                return 2;
+            }
+            opt.size = static_cast<std::size_t>(bytes);
+        }
+        else if (a == "--slaves" && i + 1 < argc)
+        {
+            int n = 0;
+            if (!intArg(argv, i, 1, 65535, n))
+            {
+                return 2;
+            }
+            opt.slaves = static_cast<std::size_t>(n);
+        }
+        else if (a == "--depth" && i + 1 < argc)
+        {
+            if (!intArg(argv, i, 1, INT_MAX, opt.depth))
+            {
+                return 2;
+            }
+        }
+        else if (a == "--rounds" && i + 1 < argc)
+        {
+            if (!intArg(argv, i, 1, INT_MAX, opt.rounds))
+            {
+                return 2;
+            }
+        }
+        else if (a == "--warmup" && i + 1 < argc)
+        {
+            if (!intArg(argv, i, 0, INT_MAX, opt.warmup))
+            {
+                return 2;
+            }
+        }
+        else if (a == "--slaves-cpu" && i + 1 < argc)
+        {
+            long const cpus = std::min<long>(CPU_SETSIZE, ::sysconf(_SC_NPROCESSORS_CONF));
+            if (!intArg(argv, i, 0, (cpus > 0 ? cpus : CPU_SETSIZE) - 1, opt.slaves_cpu))
+            {
+                return 2;
+            }
+        }
+        else if (a == "--wire-v1")
+        {
+            opt.wire = 1;
+        }
+        else if (a == "--io-uring")
+        {
+            opt.backend = ethercat_sim::bus::SlavesEndpoint::Backend::IoUring;
+        }
+        else if (a == "--busy-poll")
+        {
+            opt.io.busy_poll = true;
+        }
+        else if (a == "--spin-us" && i + 1 < argc)
+        {
+            int us = 0;
+            if (!intArg(argv, i, 0, 1000000, us))
+            {
+                return 2;
+            }
+            opt.io.spin_budget = std::chrono::microseconds(us);
+        }
+        else
+        {
+            usage(argv[0]);
+            return a == "-h" || a == "--help" ? 0 : 2;
+        }
+    }
+
+    // One datagram must fit an Ethernet frame next to the per-slave status reads
+    std::size_t const overhead = opt.mix == Mix::Cyclic ? opt.slaves * 14u : 0u;
+    if (opt.size + overhead > ::kickcat::MAX_ETHERCAT_PAYLOAD_SIZE ||
+        (opt.mix == Mix::Cyclic && opt.slaves + 1 > ::kickcat::MAX_ETHERCAT_DATAGRAMS))
+    {
+        std::fprintf(stderr, "frame does not fit: --size %zu with %s mix of %zu slaves\n",
+                     opt.size, mixName(opt.mix), opt.slaves);
+        return 2;
+    }
+    auto const max_depth = ethercat_sim::communication::wire::kMaxFrames;
+    if (opt.wire == 2 && opt.depth > static_cast<int>(max_depth))
+    {
+        std::fprintf(stderr, "--depth is limited to %zu frames per v2 message\n", max_depth);
+        return 2;
+    }
+
+    ethercat_sim::framework::logger::Logger::setLevel(
+        ethercat_sim::framework::logger::LogLevel::WARN);
+    std::string err;
+    if (!ethercat_sim::app::lockProcessMemory(opt.rt, &err))
+    {
+        std::fprintf(stderr, "memory lock: %s\n", err.c_str());
+    }
+    if (opt.slaves_cpu < 0)
+    {
+        opt.slaves_cpu = opt.rt.cpu;
+    }
+    pinCurrentThread(opt.rt, opt.rt.cpu, "master");
+
+    std::printf("pingpong: mix=%s size=%zu slaves=%zu depth=%d rounds=%d wire=v%d backend=%s "
+                "busy_poll=%s cpu=%d/%d\n",
+                mixName(opt.mix), opt.size, opt.slaves, opt.depth, opt.rounds, opt.wire,
+                opt.backend == ethercat_sim::bus::SlavesEndpoint::Backend::IoUring ? "io_uring"
+                                                                                   : "poll",
+                opt.io.busy_poll ? "on" : "off", opt.rt.cpu, opt.slaves_cpu);
+    std::printf("%-42s %10s %8s %8s %8s %8s %8s %6s %7s\n", "transport", "frames/s", "MB/s",
+                "p50us", "p99us", "p99.9us", "maxus", "errors", "sys/fr");
+
+    int failed = 0;
+    for (auto const& t : opt.transports)
+    {
+        std::string endpoint;
+        if (t == "uds")
+        {
+            endpoint = "uds:///tmp/ethercat_pingpong_" +
+                       std::to_string(static_cast<long>(::getpid())) + ".sock";
+        }
+        else if (t == "tcp")
+        {
+            endpoint = "tcp://" + opt.tcp;
+        }
+        else
+        {
+            endpoint = t; // full endpoint URI, e.g. uds://@name
+        }
+        Result res;
+        if (!runTransport(opt, endpoint, res))
+        {
+            std::fprintf(stderr, "%s: no successful round trip (%d errors)\n", endpoint.c_str(),
+                         res.errors);
+            ++failed;
+            continue;
+        }
+        report(res);
+    }
+    return failed == 0 ? 0 : 1;
+}
@@ -13,12 +13,31 @@
 #endif
 
 #include "ethercat_sim/app/cli_runtime.h"
+#include "ethercat_sim/app/rt_config.h"
+#include "ethercat_sim/communication/socket_io.h"
 
 static void usage(const char* argv0)
 {
-    ethercat_sim::framework::logger::Logger::error("Usage: %s [--uds PATH | --tcp HOST:PORT] [--count N] [--headless]", argv0);
+    ethercat_sim::framework::logger::Logger::error("Usage: %s [--uds PATH | --tcp HOST:PORT | --eth IFNAME] [--count N] [--headless] [--busy-poll] [--spin-us N] [--io-uring] %s", argv0, ethercat_sim::app::rtUsage());
 }
 
+namespace
+{
+
+// The server thread has no cycle of its own, it answers each frame as the master sends it; its
+// jitter is the spread of the per-frame processing time, which --rt-prio/--cpu/--mlock narrow
+void logServerStats(ethercat_sim::app::slaves::SlavesController const& controller)
+{
+    auto s = controller.profiler()->phase(ethercat_sim::framework::profiling::Phase::ProcessFrame);
+    ethercat_sim::framework::logger::Logger::info(
+        "server stats: frames=%llu processing mean=%.1fus p99=%.1fus max=%.1fus",
+        static_cast<unsigned long long>(s.count), static_cast<double>(s.meanNs()) / 1000.0,
+        static_cast<double>(s.percentileNs(0.99)) / 1000.0,
+        static_cast<double>(s.max_ns) / 1000.0);
+}
+
+} // namespace
+
 int main(int argc, char** argv)
 {
     // Initialize logger
@@ -27,10 +46,24 @@ int main(int argc, char** argv)
     std::string endpoint = "uds:///tmp/ethercat_bus.sock";
     std::size_t count    = 1;
     bool force_headless  = false;
+    ethercat_sim::app::RtConfig rt;
+    ethercat_sim::communication::IoPolicy io;
+    auto backend = ethercat_sim::bus::SlavesEndpoint::Backend::Poll;
 
     for (int i = 1; i < argc; ++i)
     {
         std::string a = argv[i];
+        std::string rt_err;
+        if (ethercat_sim::app::parseRtOption(argc, argv, i, rt, &rt_err))
+        {
+            if (!rt_err.empty())
+            {
+                ethercat_sim::framework::logger::Logger::error("%s", rt_err.c_str());
+                usage(argv[0]);
+                return 2;
+            }
+            continue;
+        }
         if (a == "--uds" && i + 1 < argc)
         {
             endpoint = std::string("uds://") + argv[++i];
@@ -39,6 +72,10 @@ int main(int argc, char** argv)
         {
             endpoint = std::string("tcp://") + argv[++i];
         }
+        else if (a == "--eth" && i + 1 < argc)
+        {
+            endpoint = std::string("eth://") + argv[++i];
+        }
         else if (a == "--count" && i + 1 < argc)
         {
             count = static_cast<std::size_t>(std::stoul(argv[++i]));
@@ -47,6 +84,18 @@ int main(int argc, char** argv)
         {
             force_headless = true;
         }
+        else if (a == "--busy-poll")
+        {
+            io.busy_poll = true;
+        }
+        else if (a == "--spin-us" && i + 1 < argc)
+        {
+            io.spin_budget = std::chrono::microseconds(std::stoi(argv[++i]));
+        }
+        else if (a == "--io-uring")
+        {
+            backend = ethercat_sim::bus::SlavesEndpoint::Backend::IoUring;
+        }
         else if (a == "-h" || a == "--help")
         {
             usage(argv[0]);
@@ -56,9 +105,20 @@ int main(int argc, char** argv)
 
     static std::atomic_bool stop{false};
     ethercat_sim::app::installSignalHandlers(stop);
+    static std::atomic_bool dump_profile{false};
+    ethercat_sim::app::installDumpSignalHandler(dump_profile);
+
+    std::string rt_err;
+    if (!ethercat_sim::app::lockProcessMemory(rt, &rt_err))
+    {
+        ethercat_sim::framework::logger::Logger::warn("memory locking failed: %s", rt_err.c_str());
+    }
 
     auto controller = std::make_shared<ethercat_sim::app::slaves::SlavesController>(
         endpoint, static_cast<int>(count));
+    controller->setRtConfig(rt);
+    controller->setIoPolicy(io);
+    controller->setBackend(backend);
     controller->start();
     bool smoke = std::getenv("TUI_SMOKE_TEST") != nullptr;
 #if HAVE_FTXUI
@@ -77,8 +137,19 @@ int main(int argc, char** argv)
     {
         ethercat_sim::app::TerminalGuard terminal;
         using namespace std::chrono_literals;
+        auto next_stats = std::chrono::steady_clock::now() + 5s;
         while (!stop.load())
         {
+            if (std::chrono::steady_clock::now() >= next_stats)
+            {
+                logServerStats(*controller);
+                next_stats += 5s;
+            }
+            if (dump_profile.exchange(false))
+            {
+                // kill -USR1 <pid>: per-phase timings since start
+                std::cerr << "[slaves] profile\n" << controller->profiler()->report() << std::flush;
+            }
             if (terminal.isActive())
             {
                 if (terminal.pollForEscape(200ms))
@@ -94,6 +165,7 @@ int main(int argc, char** argv)
         }
     }
     controller->stop();
+    logServerStats(*controller);
     ethercat_sim::framework::logger::Logger::info("Graceful shutdown");
     return 0;
 }
@@ -1,7 +1,9 @@
 #include "bus/slaves_endpoint.h"
 
 #include <arpa/inet.h>
+#include <array>
 #include <cerrno>
+#include <chrono>
 #include <cstring>
 #include <fcntl.h>
 #include <iostream>
@@ -9,6 +11,7 @@
 #include <poll.h>
 #include <sys/socket.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 #include <sys/un.h>
 #include <system_error>
 #include <thread>
@@ -18,12 +21,18 @@
 #include "kickcat/protocol.h"
 
 #include "ethercat_sim/communication/endpoint_parser.h"
+#include "ethercat_sim/communication/packet_ring.h"
+#include "ethercat_sim/communication/socket_io.h"
+#include "ethercat_sim/communication/wire_protocol.h"
+#include "ethercat_sim/framework/concurrency/spsc_ring.h"
 #include "framework/logger/logger.h"
 #include "sim/el1258_subs.h"
 
 namespace ethercat_sim::bus
 {
 
+namespace wire = communication::wire;
+
 bool SlavesEndpoint::bindUDS_(const std::string& path)
 {
     listen_fd_ = ::socket(AF_UNIX, SOCK_STREAM, 0);
@@ -91,125 +100,332 @@ bool SlavesEndpoint::bindTCP_(const std::string& host, uint16_t port)
     return true;
 }
 
-static bool read_exact_nb(int fd, void* buf, size_t len, std::atomic_bool* stop)
+namespace
+{
+
+// One request/response message travelling through the pipeline. The reader fills it, the
+// processor rewrites the frames in place and the writer sends it back and recycles the slot.
+struct PipelineMessage
+{
+    bool v2{false};
+    wire::Prelude prelude;
+    std::array<uint8_t, wire::headerSize(wire::kMaxFrames)> header{};
+    std::array<wire::FrameDescriptor, wire::kMaxFrames> frames{};
+    std::vector<uint8_t> payload;
+    uint64_t rx_ns{0};
+};
+
+// Messages that can be in flight between reader and writer; the slot rings are one size up so
+// the end marker always fits next to every slot.
+constexpr std::size_t kPipelineDepth = 4;
+constexpr uint8_t kEndOfStream       = 0xFF;
+using SlotRing = framework::concurrency::SpscRing<uint8_t, 2 * kPipelineDepth>;
+
+constexpr auto kStageWait = std::chrono::milliseconds(200);
+
+constexpr uint16_t kEtherCatEtherType = 0x88A4; // host byte order
+
+} // namespace
+
+void SlavesEndpoint::prepareSimulator_()
 {
-    uint8_t* p  = static_cast<uint8_t*>(buf);
-    size_t left = len;
-    while (left > 0)
+    // Prepare simulator with N slaves
+    sim_->initialize("");
+    sim_->setProfiler(profiler_);
+    sim_->clearSlaves();
+    // Create N EL1258-like virtual slaves with station addresses starting at 1
+    for (std::size_t i = 0; i < slaves_count_; ++i)
     {
-        struct pollfd pfd
-        {
-            fd, POLLIN, 0
-        };
-        int pr = ::poll(&pfd, 1, 200);
-        if (pr < 0)
-            return false;
-        if (pr == 0)
+        auto s = std::make_shared<ethercat_sim::subs::El1258Slave>(static_cast<uint16_t>(1 + i));
+        sim_->addVirtualSlave(std::move(s));
+    }
+    sim_->startAllSlaves(); // Start all slaves like the working KickCAT example
+    sim_->setLinkUp(true);
+}
+
+bool SlavesEndpoint::handleClient_(int fd)
+{
+    prepareSimulator_();
+    communication::IoPolicy io = io_;
+    io.stats                   = &io_stats_;
+
+    // Three stages joined by lock-free rings so the next request is read off the socket while the
+    // previous one is processed and its reply is sent:
+    //   reader (this thread) -> parsed -> processor -> done -> writer -> free -> reader
+    // Each stage handles slots in FIFO order, so replies leave in request order. The simulator is
+    // only touched by the processor.
+    std::vector<PipelineMessage> pool(kPipelineDepth);
+    for (auto& m : pool)
+    {
+        m.payload.reserve(wire::kMaxFrames * wire::kMaxFrameSize);
+    }
+    SlotRing free_slots, parsed, done;
+    framework::concurrency::Doorbell free_bell, parsed_bell, done_bell;
+    for (uint8_t i = 0; i < kPipelineDepth; ++i)
+    {
+        free_slots.tryPush(i);
+    }
+
+    auto stopping = [&] { return stop_ && stop_->load(); };
+    // Pops the next slot, spinning first under busy_poll; gives up only when abort() holds
+    auto popWait = [&](SlotRing& ring, framework::concurrency::Doorbell& bell, uint8_t& slot,
+                       auto abort)
+    {
+        auto const start = std::chrono::steady_clock::now();
+        while (!ring.tryPop(slot))
         {
-            if (stop && stop->load())
+            if (abort())
+            {
                 return false;
-            continue;
+            }
+            if (io.busy_poll && std::chrono::steady_clock::now() - start < io.spin_budget)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+            bell.wait([&] { return !ring.empty(); }, kStageWait);
         }
-        if (!(pfd.revents & POLLIN))
+        return true;
+    };
+    auto push = [](SlotRing& ring, framework::concurrency::Doorbell& bell, uint8_t slot)
+    {
+        ring.tryPush(slot); // cannot fail: at most kPipelineDepth + 1 entries exist
+        bell.ring();
+    };
+
+    std::thread processor(
+        [&]
         {
-            if (stop && stop->load())
-                return false;
-            continue;
-        }
-        ssize_t n = ::recv(fd, p, left, 0);
-        if (n <= 0)
-            return false;
-        p += n;
-        left -= static_cast<size_t>(n);
-    }
-    return true;
-}
+            uint8_t slot = 0;
+            while (popWait(parsed, parsed_bell, slot, [] { return false; }))
+            {
+                if (slot != kEndOfStream)
+                {
+                    PipelineMessage& m = pool[slot];
+                    std::size_t offset = 0;
+                    std::size_t count  = m.v2 ? m.prelude.count : 1;
+                    for (std::size_t i = 0; i < count; ++i)
+                    {
+                        std::size_t len = m.v2 ? m.frames[i].len : m.payload.size();
+                        processFrame_(m.payload.data() + offset, static_cast<int32_t>(len));
+                        sim_->runOnce(); // Execute slave routines like the working KickCAT example
+                        offset += len;
+                    }
+                    frames_served_.fetch_add(count, std::memory_order_relaxed);
+                }
+                push(done, done_bell, slot);
+                if (slot == kEndOfStream)
+                {
+                    return;
+                }
+            }
+        });
 
-static bool write_exact_nb(int fd, const void* buf, size_t len, std::atomic_bool* stop)
-{
-    const uint8_t* p = static_cast<const uint8_t*>(buf);
-    size_t left      = len;
-    while (left > 0)
+    std::atomic_bool write_failed{false};
+    std::thread writer(
+        [&]
+        {
+            uint8_t slot = 0;
+            while (popWait(done, done_bell, slot, [] { return false; }))
+            {
+                if (slot == kEndOfStream)
+                {
+                    return;
+                }
+                PipelineMessage& m = pool[slot];
+                // After a failed write keep recycling slots so the reader can drain and stop
+                if (!write_failed.load(std::memory_order_relaxed))
+                {
+                    framework::profiling::ScopedPhase timer(
+                        profiler_, framework::profiling::Phase::SocketWrite);
+                    bool ok = false;
+                    if (m.v2)
+                    {
+                        uint64_t tx_ns = wire::nowNs();
+                        for (std::size_t i = 0; i < m.prelude.count; ++i)
+                        {
+                            m.frames[i].rx_ns = m.rx_ns;
+                            m.frames[i].tx_ns = tx_ns;
+                        }
+                        wire::encodeHeader(m.header.data(), m.prelude, m.frames.data());
+                        iovec iov[2] = {{m.header.data(), wire::headerSize(m.prelude.count)},
+                                        {m.payload.data(), m.payload.size()}};
+                        ok           = communication::writeVectored(
+                            fd, iov, 2, io, communication::kIoWaitForever, stop_);
+                    }
+                    else
+                    {
+                        uint16_t out_len = htons(static_cast<uint16_t>(m.payload.size()));
+                        iovec iov[2]     = {{&out_len, sizeof(out_len)},
+                                            {m.payload.data(), m.payload.size()}};
+                        ok               = communication::writeVectored(
+                            fd, iov, 2, io, communication::kIoWaitForever, stop_);
+                    }
+                    if (!ok)
+                    {
+                        write_failed.store(true);
+                        ::shutdown(fd, SHUT_RDWR); // unblock the reader
+                    }
+                }
+                push(free_slots, free_bell, slot);
+            }
+        });
+
+    auto readFrom = [&](void* p, std::size_t n)
+    { return communication::readExact(fd, p, n, io, communication::kIoWaitForever, stop_); };
+
+    // Reader: each message starts with either a v1 length or the v2 magic (see wire_protocol.h);
+    // the reply uses the same version as the request.
+    bool ok = true;
+    while (true)
     {
-        struct pollfd pfd
+        uint8_t slot = 0;
+        if (!popWait(free_slots, free_bell, slot, stopping))
         {
-            fd, POLLOUT, 0
+            break;
+        }
+        PipelineMessage& m = pool[slot];
+        if (!readFrom(m.header.data(), 2))
+        {
+            ok = stopping(); // graceful stop, or peer gone
+            break;
+        }
+        // The request has started arriving: time the rest of it, not the idle wait before
+        uint64_t const read_start = profiler_ ? framework::profiling::PhaseProfiler::nowNs() : 0;
+        auto readDone             = [&]
+        {
+            if (profiler_)
+            {
+                profiler_->record(framework::profiling::Phase::SocketRead,
+                                  framework::profiling::PhaseProfiler::nowNs() - read_start);
+            }
         };
-        int pr = ::poll(&pfd, 1, 200);
-        if (pr < 0)
-            return false;
-        if (pr == 0)
+
+        m.v2 = wire::isV2(m.header.data());
+        if (!m.v2)
         {
-            if (stop && stop->load())
-                return false;
+            uint16_t len = static_cast<uint16_t>((m.header[0] << 8) | m.header[1]);
+            if (len == 0 || len > wire::kMaxV1FrameSize)
+            {
+                ok = false; // invalid
+                break;
+            }
+            m.payload.resize(len);
+            if (!readFrom(m.payload.data(), len))
+            {
+                ok = stopping();
+                break;
+            }
+            readDone();
+            push(parsed, parsed_bell, slot);
             continue;
         }
-        if (!(pfd.revents & POLLOUT))
+
+        if (!readFrom(m.header.data() + 2, wire::kPreludeSize - 2))
         {
-            if (stop && stop->load())
-                return false;
-            continue;
+            ok = stopping();
+            break;
         }
-        ssize_t n = ::send(fd, p, left, 0);
-        if (n <= 0)
-            return false;
-        p += n;
-        left -= static_cast<size_t>(n);
+        if (!wire::decodePrelude(m.header.data(), m.prelude))
+        {
+            ok = false;
+            break;
+        }
+        uint8_t* descriptors = m.header.data() + wire::kPreludeSize;
+        if (!readFrom(descriptors, m.prelude.count * wire::kDescriptorSize))
+        {
+            ok = stopping();
+            break;
+        }
+        if (!wire::decodeDescriptors(descriptors, m.prelude.count, m.frames.data()))
+        {
+            ok = false;
+            break;
+        }
+        std::size_t total = 0;
+        for (std::size_t i = 0; i < m.prelude.count; ++i)
+            total += m.frames[i].len;
+        m.payload.resize(total);
+        if (!readFrom(m.payload.data(), total))
+        {
+            ok = stopping();
+            break;
+        }
+        m.rx_ns = wire::nowNs();
+        readDone();
+        push(parsed, parsed_bell, slot);
     }
-    return true;
+
+    // Requests already read are still answered before the connection is torn down
+    push(parsed, parsed_bell, kEndOfStream);
+    processor.join();
+    writer.join();
+    if (write_failed.load())
+    {
+        ok = stopping();
+    }
+    return ok;
 }
 
-bool SlavesEndpoint::handleClient_(int fd)
+bool SlavesEndpoint::runRawEthernet_(const std::string& ifname)
 {
-    // Prepare simulator with N slaves
-    sim_->initialize("");
-    sim_->clearSlaves();
-    // Create N EL1258-like virtual slaves with station addresses starting at 1
-    for (std::size_t i = 0; i < slaves_count_; ++i)
+    // PACKET_MMAP ring with per-frame status (TPACKET_V2) rather than TPACKET_V3: a V3 block is
+    // only handed to user space when it fills up or its retire timer (>= 1 ms) fires, which would
+    // add a millisecond to every round trip of a master that waits for its frames. Batching comes
+    // from draining all ready slots per wake-up and answering them with one sendmmsg().
+    communication::PacketRing ring;
+    std::string err;
+    if (!ring.open(ifname, kEtherCatEtherType, &err))
     {
-        auto s = std::make_shared<ethercat_sim::subs::El1258Slave>(static_cast<uint16_t>(1 + i));
-        sim_->addVirtualSlave(std::move(s));
+        ethercat_sim::framework::logger::Logger::error("Failed to open eth://%s: %s (needs "
+                                                       "CAP_NET_RAW)",
+                                                       ifname.c_str(), err.c_str());
+        return false;
     }
-    sim_->startAllSlaves(); // Start all slaves like the working KickCAT example
-    sim_->setLinkUp(true);
+    ethercat_sim::framework::logger::Logger::info("Listening for EtherCAT frames on %s",
+                                                  ifname.c_str());
+    prepareSimulator_();
+    if (on_connection_)
+        on_connection_(true);
 
-    // blocking loop: read len(uint16), read frame, process, write back
-    while (true)
+    auto handler = [this](uint8_t* frame, std::size_t& len)
     {
-        if (stop_ && stop_->load())
-            return true;
-        uint16_t be_len = 0;
-        if (!read_exact_nb(fd, &be_len, sizeof(be_len), stop_))
+        if (len < sizeof(::kickcat::EthernetHeader) + sizeof(::kickcat::EthercatHeader))
         {
-            if (stop_ && stop_->load())
-                return true; // graceful stop
             return false;
         }
-        uint16_t len = ntohs(be_len);
-        if (len == 0 || len > 1500)
-        {
-            return false; // invalid
-        }
-        std::vector<uint8_t> buf(len);
-        if (!read_exact_nb(fd, buf.data(), len, stop_))
+        processFrame_(frame, static_cast<int32_t>(len));
+        sim_->runOnce();
+        // Like a real ESC, mark the source MAC as locally administered on the way back so the
+        // master can tell its returning frames from the ones it sent
+        frame[6] |= 0x02;
+        return true;
+    };
+
+    bool ok = true;
+    while (!(stop_ && stop_->load()))
+    {
+        if (ring.poll(handler, 200) < 0)
         {
-            if (stop_ && stop_->load())
-                return true;
-            else
-                return false;
+            ethercat_sim::framework::logger::Logger::error("eth://%s receive failed: %s",
+                                                           ifname.c_str(), strerror(errno));
+            ok = false;
+            break;
         }
-        processFrame_(buf.data(), static_cast<int32_t>(len));
-        sim_->runOnce(); // Execute slave routines like the working KickCAT example
-        uint16_t out_len = htons(static_cast<uint16_t>(buf.size()));
-        if (!write_exact_nb(fd, &out_len, sizeof(out_len), stop_))
-            return stop_ && stop_->load();
-        if (!write_exact_nb(fd, buf.data(), buf.size(), stop_))
-            return stop_ && stop_->load();
     }
+    ethercat_sim::framework::logger::Logger::info("eth://%s closed: rx=%llu tx=%llu frames",
+                                                  ifname.c_str(),
+                                                  static_cast<unsigned long long>(
+                                                      ring.framesReceived()),
+                                                  static_cast<unsigned long long>(ring.framesSent()));
+    if (on_connection_)
+        on_connection_(false);
+    return ok;
 }
 
 void SlavesEndpoint::processFrame_(uint8_t* frame, int32_t frame_size)
 {
+    framework::profiling::ScopedPhase timer(profiler_, framework::profiling::Phase::ProcessFrame);
     ::kickcat::Frame f(frame, frame_size);
     static bool dbg = []
     {
@@ -228,6 +444,10 @@ void SlavesEndpoint::processFrame_(uint8_t* frame, int32_t frame_size)
         auto [hdr, data, wkc] = f.peekDatagram();
         if (hdr == nullptr)
             break;
+        if (profiler_)
+        {
+            profiler_->countDatagram(static_cast<uint8_t>(hdr->command));
+        }
 
         uint16_t ack = 0;
         switch (hdr->command)
@@ -416,8 +636,10 @@ void SlavesEndpoint::processFrame_(uint8_t* frame, int32_t frame_size)
             bool ok          = false;
             if (hdr->command == ::kickcat::Command::LRD)
                 ok = sim_->readLogical(logical, data, hdr->len);
-            else
+            else if (hdr->command == ::kickcat::Command::LWR)
                 ok = sim_->writeLogical(logical, data, hdr->len);
+            else
+                ok = sim_->readWriteLogical(logical, data, hdr->len);
             ack = ok ? 1 : 0;
             if (dbg)
             {
@@ -463,8 +685,12 @@ bool SlavesEndpoint::run()
 {
     ethercat_sim::framework::logger::Logger::info("SlavesEndpoint::run() started with endpoint: %s",
                                                   endpoint_.c_str());
-    std::string path, host;
+    std::string path, host, ifname;
     uint16_t port = 0;
+    if (communication::EndpointParser::parseEthEndpoint(endpoint_, ifname))
+    {
+        return runRawEthernet_(ifname);
+    }
     if (communication::EndpointParser::parseUdsEndpoint(endpoint_, path))
     {
         ethercat_sim::framework::logger::Logger::info("Parsed UDS endpoint, path: %s",
@@ -498,6 +724,20 @@ bool SlavesEndpoint::run()
         return false;
     }
 
+    if (backend_ == Backend::IoUring)
+    {
+        bool ok = false;
+        if (runUring_(ok))
+        {
+            ::close(listen_fd_);
+            if (!uds_is_abstract_ && !bound_disk_path_.empty())
+                ::unlink(bound_disk_path_.c_str());
+            return ok;
+        }
+        ethercat_sim::framework::logger::Logger::warn(
+            "io_uring backend unavailable, using the poll backend");
+    }
+
     // Accept loop with poll to allow graceful stop
     ethercat_sim::framework::logger::Logger::info(
         "Entering accept loop, waiting for connections...");
@@ -549,7 +789,9 @@ bool SlavesEndpoint::run()
             ::unlink(bound_disk_path_.c_str());
         return false;
     }
-    ethercat_sim::framework::logger::Logger::info("Client connected");
+    ethercat_sim::framework::logger::Logger::info("Client connected%s",
+                                                  io_.busy_poll ? " (busy-poll)" : "");
+    communication::configureSocket(fd, io_);
     if (on_connection_)
         on_connection_(true);
     bool ok = handleClient_(fd);
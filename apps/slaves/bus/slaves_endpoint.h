@@ -7,6 +7,8 @@
 #include <string>
 #include <vector>
 
+#include "ethercat_sim/communication/socket_io.h"
+#include "ethercat_sim/framework/profiling/phase_profiler.h"
 #include "ethercat_sim/simulation/network_simulator.h"
 
 namespace ethercat_sim::bus
@@ -15,6 +17,23 @@ namespace ethercat_sim::bus
 class SlavesEndpoint
 {
   public:
+    // Stream server implementation
+    // - Poll: one client, reader/processor/writer threads over non-blocking sockets
+    // - IoUring: single-threaded io_uring event loop serving every client (multishot accept and
+    //   receive into provided buffers, replies from registered buffers); falls back to Poll when
+    //   the build or the kernel lacks io_uring
+    enum class Backend
+    {
+        Poll,
+        IoUring
+    };
+
+    struct ServerStats
+    {
+        std::uint64_t frames{0};
+        std::uint64_t syscalls{0}; // socket syscalls (Poll) or io_uring_enter calls (IoUring)
+    };
+
     explicit SlavesEndpoint(std::string endpoint) : endpoint_(std::move(endpoint)) {}
 
     void setSlavesCount(std::size_t n)
@@ -25,12 +44,55 @@ class SlavesEndpoint
     {
         stop_ = stop_flag;
     }
-    bool run(); // blocking server loop (single connection for now)
+    void setIoPolicy(communication::IoPolicy io)
+    {
+        io_ = io;
+    }
+    void setBackend(Backend backend)
+    {
+        backend_ = backend;
+    }
+    // Phase timers and datagram counters (not owned; nullptr disables). The poll backend records
+    // socket reads and writes; every backend records frame processing and simulator phases.
+    void setProfiler(framework::profiling::PhaseProfiler* profiler)
+    {
+        profiler_ = profiler;
+    }
+    // Serve an externally owned simulator, e.g. one whose slave counters a UI is watching
+    void setSimulator(std::shared_ptr<simulation::NetworkSimulator> sim)
+    {
+        sim_ = std::move(sim);
+    }
+    ServerStats stats() const noexcept
+    {
+        return {frames_served_.load(std::memory_order_relaxed),
+                io_stats_.syscalls.load(std::memory_order_relaxed)};
+    }
+    // Blocking server loop: one stream client (uds://, tcp://), or raw EtherCAT frames on a local
+    // interface (eth://ifname, e.g. one end of a veth pair) until stopped
+    bool run();
+
+    // Transport-free frame path shared by every server loop, for benchmarks: prepare() builds the
+    // slaves, serveFrame() answers one EtherCAT frame in place and runs the slave routines
+    void prepare()
+    {
+        prepareSimulator_();
+    }
+    void serveFrame(uint8_t* frame, int32_t len)
+    {
+        processFrame_(frame, len);
+        sim_->runOnce();
+    }
 
   private:
     std::string endpoint_;
     std::size_t slaves_count_{1};
     std::atomic_bool* stop_{nullptr};
+    communication::IoPolicy io_;
+    Backend backend_{Backend::Poll};
+    communication::IoStats io_stats_;
+    std::atomic<std::uint64_t> frames_served_{0};
+    framework::profiling::PhaseProfiler* profiler_{nullptr};
 
     std::shared_ptr<simulation::NetworkSimulator> sim_{
         std::make_shared<simulation::NetworkSimulator>()};
@@ -40,7 +102,12 @@ class SlavesEndpoint
     std::string bound_disk_path_;
     bool bindUDS_(const std::string& path);
     bool bindTCP_(const std::string& host, uint16_t port);
+    void prepareSimulator_();
     bool handleClient_(int fd);
+    bool runRawEthernet_(const std::string& ifname);
+    // Serves clients on listen_fd_ with io_uring; returns false (ok untouched) when io_uring is
+    // unavailable so the caller can fall back to the poll backend
+    bool runUring_(bool& ok);
     void processFrame_(uint8_t* buf, int32_t len);
     std::function<void(bool)> on_connection_;
 
@@ -0,0 +1,437 @@
+#include "bus/slaves_endpoint.h"
+
+#if HAVE_IO_URING
+
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include "ethercat_sim/communication/io_uring.h"
+#include "ethercat_sim/communication/socket_io.h"
+#include "ethercat_sim/communication/wire_protocol.h"
+#include "framework/logger/logger.h"
+
+namespace ethercat_sim::bus
+{
+
+namespace wire = communication::wire;
+
+namespace
+{
+
+enum class Op : std::uint64_t
+{
+    Accept = 1,
+    Recv   = 2,
+    Write  = 3,
+};
+
+std::uint64_t tag(Op op, std::uint32_t conn)
+{
+    return (static_cast<std::uint64_t>(op) << 32) | conn;
+}
+
+constexpr unsigned kRingEntries       = 256;
+constexpr std::uint16_t kRecvGroup    = 0;
+constexpr unsigned kRecvBuffers       = 256;
+constexpr unsigned kRecvBufferSize    = 4096;
+constexpr std::size_t kMaxConnections = 8;
+// Largest message in either direction is a full v2 batch; each reply buffer holds two
+constexpr std::size_t kMaxMessage =
+    wire::headerSize(wire::kMaxFrames) + wire::kMaxFrames * wire::kMaxFrameSize;
+constexpr std::size_t kTxBufferSize = 2 * kMaxMessage;
+// A client that keeps sending without reading its replies is dropped past this backlog
+constexpr std::size_t kMaxInbox = 4 * kMaxMessage;
+constexpr auto kWaitSlice       = std::chrono::milliseconds(200);
+
+struct Connection
+{
+    int fd{-1};
+    bool recv_armed{false};
+    bool closing{false};
+    std::vector<std::uint8_t> inbox; // received bytes not parsed yet
+    // Two registered reply buffers: the kernel writes one while the next replies fill the other
+    std::array<std::uint8_t*, 2> tx{};
+    std::array<std::size_t, 2> tx_len{};
+    int staging{0};
+    bool writing{false};
+    std::size_t write_off{0}; // bytes of the in-flight buffer already written
+};
+
+} // namespace
+
+bool SlavesEndpoint::runUring_(bool& ok)
+{
+    communication::IoUring ring;
+    std::string err;
+    // Spinning on the CQ (busy_poll) needs the kernel to post completions without waiting for
+    // us to enter it, so cooperative task running is only used when we sleep in io_uring_enter
+    if (!ring.init(kRingEntries, !io_.busy_poll, &err) ||
+        !ring.setupBufferRing(kRecvGroup, kRecvBuffers, kRecvBufferSize, &err))
+    {
+        ethercat_sim::framework::logger::Logger::warn("io_uring setup failed: %s", err.c_str());
+        return false;
+    }
+    std::array<Connection, kMaxConnections> conns;
+    void* tx_mem = nullptr;
+    if (::posix_memalign(&tx_mem, 4096, kMaxConnections * 2 * kTxBufferSize) != 0)
+    {
+        return false;
+    }
+    std::unique_ptr<void, decltype(&std::free)> tx_owner(tx_mem, &std::free);
+    std::array<iovec, kMaxConnections * 2> tx_iov{};
+    for (std::size_t i = 0; i < kMaxConnections; ++i)
+    {
+        for (std::size_t b = 0; b < 2; ++b)
+        {
+            auto* p           = static_cast<std::uint8_t*>(tx_mem) + (2 * i + b) * kTxBufferSize;
+            conns[i].tx[b]    = p;
+            tx_iov[2 * i + b] = {p, kTxBufferSize};
+        }
+    }
+    if (!ring.registerBuffers(tx_iov.data(), static_cast<unsigned>(tx_iov.size()), &err))
+    {
+        ethercat_sim::framework::logger::Logger::warn("io_uring setup failed: %s", err.c_str());
+        return false;
+    }
+
+    // One simulated segment shared by every client, prepared once for the server's lifetime
+    prepareSimulator_();
+    ethercat_sim::framework::logger::Logger::info("io_uring backend serving up to %zu clients%s",
+                                                  kMaxConnections,
+                                                  io_.busy_poll ? " (busy-poll)" : "");
+    ok                      = true;
+    std::size_t active      = 0;
+    std::uint64_t other_sys = 0; // syscalls outside io_uring_enter (yields, close, shutdown)
+    communication::IoStats socket_stats; // counted by configureSocket() for accepted clients
+    communication::IoPolicy io = io_;
+    io.stats                   = &socket_stats;
+    bool accept_armed       = false;
+
+    auto nextSqe = [&]() -> io_uring_sqe*
+    {
+        io_uring_sqe* sqe = ring.getSqe();
+        if (!sqe)
+        {
+            ring.submit(); // SQ full: flush and retry
+            sqe = ring.getSqe();
+        }
+        return sqe;
+    };
+    auto armAccept = [&]
+    {
+        if (io_uring_sqe* sqe = nextSqe())
+        {
+            sqe->opcode    = IORING_OP_ACCEPT;
+            sqe->fd        = listen_fd_;
+            sqe->ioprio    = IORING_ACCEPT_MULTISHOT;
+            sqe->user_data = tag(Op::Accept, 0);
+            accept_armed   = true;
+        }
+    };
+    auto armRecv = [&](std::uint32_t id)
+    {
+        Connection& c = conns[id];
+        if (io_uring_sqe* sqe = nextSqe())
+        {
+            sqe->opcode    = IORING_OP_RECV;
+            sqe->fd        = c.fd;
+            sqe->ioprio    = IORING_RECV_MULTISHOT;
+            sqe->flags     = IOSQE_BUFFER_SELECT;
+            sqe->buf_group = kRecvGroup;
+            sqe->user_data = tag(Op::Recv, id);
+            c.recv_armed   = true;
+        }
+    };
+    auto submitWrite = [&](std::uint32_t id)
+    {
+        Connection& c = conns[id];
+        int b         = c.staging ^ 1;
+        if (io_uring_sqe* sqe = nextSqe())
+        {
+            sqe->opcode    = IORING_OP_WRITE_FIXED;
+            sqe->fd        = c.fd;
+            sqe->addr      = reinterpret_cast<std::uint64_t>(c.tx[b] + c.write_off);
+            sqe->len       = static_cast<std::uint32_t>(c.tx_len[b] - c.write_off);
+            sqe->off       = static_cast<std::uint64_t>(-1); // stream: no file offset
+            sqe->buf_index = static_cast<std::uint16_t>(2 * id + b);
+            sqe->user_data = tag(Op::Write, id);
+        }
+    };
+    auto startWrite = [&](std::uint32_t id)
+    {
+        Connection& c = conns[id];
+        if (c.writing || c.closing || c.tx_len[c.staging] == 0)
+        {
+            return;
+        }
+        c.staging ^= 1;
+        c.writing   = true;
+        c.write_off = 0;
+        submitWrite(id);
+    };
+    auto drop = [&](std::uint32_t id)
+    {
+        Connection& c = conns[id];
+        if (!c.closing)
+        {
+            c.closing = true;
+            ++other_sys;
+            ::shutdown(c.fd, SHUT_RDWR); // ends the multishot receive
+        }
+    };
+    auto maybeClose = [&](std::uint32_t id)
+    {
+        Connection& c = conns[id];
+        if (!c.closing || c.recv_armed || c.writing)
+        {
+            return;
+        }
+        ++other_sys;
+        ::close(c.fd);
+        auto tx = c.tx;
+        c       = Connection{};
+        c.tx    = tx;
+        if (--active == 0 && on_connection_)
+            on_connection_(false);
+        ethercat_sim::framework::logger::Logger::info("Client %u disconnected", id);
+    };
+
+    // Answers every complete request in the inbox (in order) into the staging reply buffer;
+    // stops early when the buffer is full and resumes once the in-flight write completes
+    auto serve = [&](std::uint32_t id)
+    {
+        Connection& c   = conns[id];
+        std::size_t off = 0;
+        while (!c.closing)
+        {
+            std::uint8_t* p   = c.inbox.data() + off;
+            std::size_t avail = c.inbox.size() - off;
+            std::uint8_t* out = c.tx[c.staging] + c.tx_len[c.staging];
+            std::size_t room  = kTxBufferSize - c.tx_len[c.staging];
+            if (avail < 2)
+                break;
+            if (!wire::isV2(p))
+            {
+                std::size_t len = static_cast<std::size_t>((p[0] << 8) | p[1]);
+                if (len == 0 || len > wire::kMaxV1FrameSize)
+                {
+                    drop(id); // invalid
+                    break;
+                }
+                if (avail < 2 + len || room < 2 + len)
+                    break;
+                std::memcpy(out, p, 2 + len);
+                processFrame_(out + 2, static_cast<int32_t>(len));
+                sim_->runOnce();
+                c.tx_len[c.staging] += 2 + len;
+                off += 2 + len;
+                frames_served_.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+
+            wire::Prelude prelude;
+            std::array<wire::FrameDescriptor, wire::kMaxFrames> frames{};
+            if (avail < wire::kPreludeSize)
+                break;
+            if (!wire::decodePrelude(p, prelude))
+            {
+                drop(id);
+                break;
+            }
+            std::size_t hdr = wire::headerSize(prelude.count);
+            if (avail < hdr)
+                break;
+            if (!wire::decodeDescriptors(p + wire::kPreludeSize, prelude.count, frames.data()))
+            {
+                drop(id);
+                break;
+            }
+            std::size_t total = 0;
+            for (std::size_t i = 0; i < prelude.count; ++i)
+                total += frames[i].len;
+            if (avail < hdr + total || room < hdr + total)
+                break;
+
+            uint64_t rx_ns = wire::nowNs();
+            std::memcpy(out + hdr, p + hdr, total);
+            std::size_t o = 0;
+            for (std::size_t i = 0; i < prelude.count; ++i)
+            {
+                processFrame_(out + hdr + o, static_cast<int32_t>(frames[i].len));
+                sim_->runOnce();
+                frames[i].rx_ns = rx_ns;
+                o += frames[i].len;
+            }
+            uint64_t tx_ns = wire::nowNs();
+            for (std::size_t i = 0; i < prelude.count; ++i)
+                frames[i].tx_ns = tx_ns;
+            wire::encodeHeader(out, prelude, frames.data());
+            c.tx_len[c.staging] += hdr + total;
+            off += hdr + total;
+            frames_served_.fetch_add(prelude.count, std::memory_order_relaxed);
+        }
+        if (off > 0)
+            c.inbox.erase(c.inbox.begin(), c.inbox.begin() + static_cast<std::ptrdiff_t>(off));
+        if (c.inbox.size() > kMaxInbox)
+            drop(id);
+        startWrite(id);
+    };
+
+    auto onCompletion = [&](io_uring_cqe const& cqe)
+    {
+        auto op   = static_cast<Op>(cqe.user_data >> 32);
+        auto id   = static_cast<std::uint32_t>(cqe.user_data);
+        bool more = (cqe.flags & IORING_CQE_F_MORE) != 0;
+        switch (op)
+        {
+        case Op::Accept:
+        {
+            accept_armed = more;
+            if (cqe.res >= 0)
+            {
+                std::uint32_t slot = 0;
+                while (slot < kMaxConnections && conns[slot].fd >= 0)
+                    ++slot;
+                if (slot == kMaxConnections)
+                {
+                    ethercat_sim::framework::logger::Logger::warn(
+                        "io_uring backend: %zu clients already connected, refusing",
+                        kMaxConnections);
+                    ++other_sys;
+                    ::close(cqe.res);
+                    break;
+                }
+                Connection& c = conns[slot];
+                c.fd          = cqe.res;
+                c.inbox.reserve(kMaxInbox);
+                communication::configureSocket(c.fd, io);
+                armRecv(slot);
+                if (active++ == 0 && on_connection_)
+                    on_connection_(true);
+                ethercat_sim::framework::logger::Logger::info("Client %u connected (io_uring)",
+                                                              slot);
+            }
+            else if (cqe.res != -EINTR && cqe.res != -ECONNABORTED)
+            {
+                ethercat_sim::framework::logger::Logger::error("io_uring accept: %s",
+                                                               std::strerror(-cqe.res));
+                ok = false;
+            }
+            break;
+        }
+        case Op::Recv:
+        {
+            Connection& c = conns[id];
+            c.recv_armed  = more;
+            if (cqe.res > 0 && (cqe.flags & IORING_CQE_F_BUFFER))
+            {
+                auto bid = static_cast<std::uint16_t>(cqe.flags >> IORING_CQE_BUFFER_SHIFT);
+                std::uint8_t const* buf = ring.providedBuffer(bid);
+                c.inbox.insert(c.inbox.end(), buf, buf + cqe.res);
+                ring.recycleBuffer(bid);
+                serve(id);
+            }
+            else if (cqe.res != -ENOBUFS)
+            {
+                c.closing = true; // peer closed or connection error
+            }
+            if (!c.recv_armed && !c.closing)
+                armRecv(id);
+            maybeClose(id);
+            break;
+        }
+        case Op::Write:
+        {
+            Connection& c = conns[id];
+            int b         = c.staging ^ 1;
+            if (cqe.res < 0)
+            {
+                c.writing   = false;
+                c.tx_len[b] = 0;
+                drop(id);
+            }
+            else
+            {
+                c.write_off += static_cast<std::size_t>(cqe.res);
+                if (c.write_off < c.tx_len[b])
+                {
+                    submitWrite(id); // short write: send the rest
+                    break;
+                }
+                c.writing   = false;
+                c.tx_len[b] = 0;
+                serve(id); // replies held back by a full buffer, then the next write
+            }
+            maybeClose(id);
+            break;
+        }
+        }
+    };
+
+    while (ok && !(stop_ && stop_->load(std::memory_order_relaxed)))
+    {
+        if (!accept_armed)
+            armAccept();
+        if (!ring.hasCompletions())
+        {
+            if (io_.busy_poll)
+            {
+                // Submit replies, then watch the CQ without entering the kernel for a while
+                if (ring.hasPendingSubmissions())
+                    ring.submit();
+                auto const start = std::chrono::steady_clock::now();
+                while (!ring.hasCompletions() &&
+                       std::chrono::steady_clock::now() - start < io_.spin_budget)
+                {
+                    ++other_sys;
+                    std::this_thread::yield();
+                }
+            }
+            if (!ring.hasCompletions() && !ring.submitAndWait(1, kWaitSlice))
+            {
+                ethercat_sim::framework::logger::Logger::error("io_uring_enter: %s",
+                                                               std::strerror(errno));
+                ok = false;
+                break;
+            }
+        }
+        ring.forEachCompletion(onCompletion);
+        io_stats_.syscalls.store(ring.enterCalls() + other_sys +
+                                     socket_stats.syscalls.load(std::memory_order_relaxed),
+                                 std::memory_order_relaxed);
+    }
+
+    for (auto& c : conns)
+    {
+        if (c.fd >= 0)
+            ::close(c.fd);
+    }
+    if (active > 0 && on_connection_)
+        on_connection_(false);
+    return true;
+}
+
+} // namespace ethercat_sim::bus
+
+#else
+
+namespace ethercat_sim::bus
+{
+
+bool SlavesEndpoint::runUring_(bool& ok)
+{
+    (void) ok;
+    return false; // built without io_uring support
+}
+
+} // namespace ethercat_sim::bus
+
+#endif // HAVE_IO_URING
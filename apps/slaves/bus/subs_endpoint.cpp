@@ -337,8 +337,10 @@ void SubsEndpoint::processFrame_(uint8_t* frame, int32_t frame_size)
             bool ok          = false;
             if (hdr->command == ::kickcat::Command::LRD)
                 ok = sim_->readLogical(logical, data, hdr->len);
-            else
+            else if (hdr->command == ::kickcat::Command::LWR)
                 ok = sim_->writeLogical(logical, data, hdr->len);
+            else
+                ok = sim_->readWriteLogical(logical, data, hdr->len);
             ack = ok ? 1 : 0;
             if (dbg)
             {
@@ -1,11 +1,18 @@
 #include "slaves_tui.h"
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <cstdio>
+#include <string>
 #include <thread>
+#include <vector>
 
 #include "ftxui/component/component.hpp"
 #include "ftxui/component/screen_interactive.hpp"
 #include "ftxui/dom/elements.hpp"
+#include "ftxui/screen/terminal.hpp"
+#include "kickcat/protocol.h"
 #include "logic/slaves_controller.h"
 #include "logic/slaves_model.h"
 
@@ -15,28 +22,232 @@ using namespace std::chrono_literals;
 namespace ethercat_sim::app::slaves
 {
 
+namespace
+{
+
+// One row per phase: count, mean, p50, p99, max (µs) from the lock-free histograms
+Element profileTable(framework::profiling::PhaseProfiler const& profiler)
+{
+    using framework::profiling::Phase;
+    using framework::profiling::PhaseProfiler;
+    auto us = [](std::uint64_t ns)
+    {
+        char buf[32];
+        std::snprintf(buf, sizeof(buf), "%9.1f", static_cast<double>(ns) / 1e3);
+        return text(buf);
+    };
+    Elements rows;
+    rows.push_back(hbox({text("phase") | bold | size(WIDTH, EQUAL, 16),
+                         text("    count") | bold, text("   mean") | bold, text("    p50") | bold,
+                         text("    p99") | bold, text("    max") | bold}));
+    for (std::size_t i = 0; i < PhaseProfiler::kPhases; ++i)
+    {
+        auto phase = static_cast<Phase>(i);
+        auto s     = profiler.phase(phase);
+        rows.push_back(hbox({text(framework::profiling::phaseName(phase)) | size(WIDTH, EQUAL, 16),
+                             text(std::to_string(s.count)) | size(WIDTH, EQUAL, 9),
+                             us(s.meanNs()), us(s.percentileNs(0.50)), us(s.percentileNs(0.99)),
+                             us(s.max_ns)}));
+    }
+    return vbox(std::move(rows));
+}
+
+// Per-slave table over the slaves' published (seqlock) state. Only the rows on screen are built,
+// and datagram rates are resampled once per second, so a redraw stays cheap with 10k slaves.
+class SlaveTable
+{
+  public:
+    static constexpr auto kRateWindow = 1s;
+
+    explicit SlaveTable(std::shared_ptr<simulation::NetworkSimulator const> sim)
+        : sim_(std::move(sim))
+    {
+    }
+
+    Element render(std::size_t visible_rows)
+    {
+        auto table = sim_->slaveStates();
+        sampleRates_(table);
+        visible_rows_ = std::max<std::size_t>(1, visible_rows);
+        first_        = std::min(first_, lastFirst_(table->size()));
+
+        Elements rows;
+        rows.push_back(hbox({cell_("#", 6) | bold, cell_("addr", 6) | bold,
+                             cell_("AL state", 12) | bold, cell_("code", 8) | bold,
+                             cell_("dgram/s", 10) | bold, cell_("wkc=0", 10) | bold,
+                             cell_("mbx w/r", 16) | bold, cell_("SM0-3", 13) | bold,
+                             text("inputs") | bold}));
+        std::size_t const end = std::min(table->size(), first_ + visible_rows_);
+        for (std::size_t i = first_; i < end; ++i)
+        {
+            auto const st = (*table)[i]->load();
+            char code[8];
+            std::snprintf(code, sizeof(code), "0x%04X", static_cast<unsigned>(st.al_status_code));
+            char rate[16];
+            std::snprintf(rate, sizeof(rate), "%.0f", i < rates_.size() ? rates_[i] : 0.0);
+            char sm[16];
+            std::snprintf(sm, sizeof(sm), "%02X %02X %02X %02X", st.sm_status[0], st.sm_status[1],
+                          st.sm_status[2], st.sm_status[3]);
+            auto mbx =
+                std::to_string(st.mailbox_writes) + "/" + std::to_string(st.mailbox_reads);
+            auto wkc_style = st.wkc_zero ? color(Color::Red) : Decorator(nothing);
+            rows.push_back(hbox({
+                cell_(std::to_string(i), 6),
+                cell_(std::to_string(st.station_address), 6),
+                cell_(::kickcat::toString(static_cast<::kickcat::State>(st.al_state)), 12),
+                cell_(code, 8),
+                cell_(rate, 10),
+                cell_(std::to_string(st.wkc_zero), 10) | wkc_style,
+                cell_(mbx, 16),
+                cell_(sm, 13),
+                text(inputs_(st)),
+            }));
+        }
+        char footer[64];
+        std::snprintf(footer, sizeof(footer), "rows %zu-%zu of %zu",
+                      table->empty() ? 0 : first_ + 1, end, table->size());
+        rows.push_back(text(footer) | dim);
+        return vbox(std::move(rows));
+    }
+
+    // Stands in for the table without its slave rows (column header and footer), to measure
+    // the space around them
+    static Element placeholder()
+    {
+        return vbox({text(""), text("")});
+    }
+
+    bool onEvent(Event const& e)
+    {
+        std::size_t const page = visible_rows_;
+        std::size_t const last = lastFirst_(sim_->slaveStates()->size());
+        if (e == Event::ArrowDown)
+            first_ = std::min(first_ + 1, last);
+        else if (e == Event::ArrowUp)
+            first_ = first_ > 0 ? first_ - 1 : 0;
+        else if (e == Event::PageDown)
+            first_ = std::min(first_ + page, last);
+        else if (e == Event::PageUp)
+            first_ = first_ > page ? first_ - page : 0;
+        else if (e == Event::Home)
+            first_ = 0;
+        else if (e == Event::End)
+            first_ = last;
+        else
+            return false;
+        return true;
+    }
+
+  private:
+    static Element cell_(std::string s, int width)
+    {
+        return text(std::move(s)) | size(WIDTH, EQUAL, width);
+    }
+
+    static std::string inputs_(simulation::SlaveState const& st)
+    {
+        if (!st.has_inputs)
+        {
+            return "-";
+        }
+        std::string out(8, '0');
+        for (std::size_t b = 0; b < 8; ++b)
+        {
+            if (st.inputs & (1u << b))
+            {
+                out[7 - b] = '1'; // MSB first, DI0 rightmost
+            }
+        }
+        return out;
+    }
+
+    std::size_t lastFirst_(std::size_t n) const
+    {
+        return n > visible_rows_ ? n - visible_rows_ : 0;
+    }
+
+    void sampleRates_(std::shared_ptr<simulation::SlaveStateTable const> const& table)
+    {
+        auto const now = std::chrono::steady_clock::now();
+        if (table != sampled_table_)
+        {
+            // Registry changed (client reconnect): restart the window
+            sampled_table_ = table;
+            prev_.assign(table->size(), 0);
+            rates_.assign(table->size(), 0.0);
+            for (std::size_t i = 0; i < table->size(); ++i)
+            {
+                prev_[i] = (*table)[i]->load().datagrams;
+            }
+            sampled_at_ = now;
+            return;
+        }
+        if (now - sampled_at_ < kRateWindow)
+        {
+            return;
+        }
+        auto const elapsed = std::chrono::duration<double>(now - sampled_at_).count();
+        for (std::size_t i = 0; i < table->size(); ++i)
+        {
+            auto n    = (*table)[i]->load().datagrams;
+            rates_[i] = static_cast<double>(n - prev_[i]) / elapsed;
+            prev_[i]  = n;
+        }
+        sampled_at_ = now;
+    }
+
+    std::shared_ptr<simulation::NetworkSimulator const> sim_;
+    std::size_t first_{0};
+    std::size_t visible_rows_{1};
+    std::shared_ptr<simulation::SlaveStateTable const> sampled_table_;
+    std::vector<std::uint64_t> prev_;
+    std::vector<double> rates_;
+    std::chrono::steady_clock::time_point sampled_at_{};
+};
+
+// Redraw rate of the live views; also bounds how often slave state is read
+constexpr auto kRefreshPeriod = 100ms;
+
+} // namespace
+
 void run_slaves_tui(std::shared_ptr<SlavesController> controller,
                     std::shared_ptr<SlavesModel> model, bool smoke_test)
 {
-    (void) controller; // no interactions yet
-    auto screen   = ScreenInteractive::Fullscreen();
+    auto profiler = controller->profiler();
+    SlaveTable slave_table(controller->simulator());
+    auto screen = ScreenInteractive::Fullscreen();
     auto renderer = Renderer(
         [&]
         {
-            auto snap = model->snapshot();
-            return vbox({
-                       text("Virtual Slaves"),
-                       separator(),
-                       text("endpoint: " + snap.endpoint),
-                       text("count: " + std::to_string(snap.count)),
-                       text(std::string("listening: ") + (snap.listening ? "yes" : "no")),
-                       text(std::string("connected: ") + (snap.connected ? "yes" : "no")),
-                       separator(),
-                       text("keys: [q]/[ESC] quit"),
-                       separator(),
-                       text("status: " + snap.status),
-                   }) |
-                   border;
+            auto snap   = model->snapshot();
+            auto layout = [&](Element slaves)
+            {
+                return vbox({
+                           text("Virtual Slaves"),
+                           separator(),
+                           text("endpoint: " + snap.endpoint),
+                           text("count: " + std::to_string(snap.count)),
+                           text(std::string("listening: ") + (snap.listening ? "yes" : "no")),
+                           text(std::string("connected: ") + (snap.connected ? "yes" : "no")),
+                           separator(),
+                           text("profile (us)"),
+                           profileTable(*profiler),
+                           separator(),
+                           text("slaves"),
+                           std::move(slaves),
+                           separator(),
+                           text("keys: [q]/[ESC] quit  [up]/[down]/[PgUp]/[PgDn]/[Home]/[End] "
+                                "scroll"),
+                           separator(),
+                           text("status: " + snap.status),
+                       }) |
+                       border;
+            };
+            // The slave rows get whatever height the rest of the view leaves on the terminal
+            Element chrome = layout(SlaveTable::placeholder());
+            chrome->ComputeRequirement();
+            int const rows = Terminal::Size().dimy - chrome->requirement().min_y;
+            return layout(slave_table.render(static_cast<std::size_t>(std::max(1, rows))));
         });
     auto events = CatchEvent(renderer,
                              [&](Event e)
@@ -46,7 +257,7 @@ void run_slaves_tui(std::shared_ptr<SlavesController> controller,
                                      screen.Exit();
                                      return true;
                                  }
-                                 return false;
+                                 return slave_table.onEvent(e);
                              });
     if (smoke_test)
     {
@@ -59,7 +270,20 @@ void run_slaves_tui(std::shared_ptr<SlavesController> controller,
             })
             .detach();
     }
+    // Redraw at a fixed rate so the profile and slave table stay live without input events
+    std::atomic_bool done{false};
+    std::thread refresher(
+        [&]
+        {
+            while (!done.load())
+            {
+                std::this_thread::sleep_for(kRefreshPeriod);
+                screen.PostEvent(Event::Custom);
+            }
+        });
     screen.Loop(events);
+    done.store(true);
+    refresher.join();
 }
 
 } // namespace ethercat_sim::app::slaves
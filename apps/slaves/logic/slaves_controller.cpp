@@ -2,6 +2,8 @@
 
 #include <iostream>
 
+#include "framework/logger/logger.h"
+
 namespace ethercat_sim::app::slaves
 {
 
@@ -30,13 +32,37 @@ void SlavesController::run_()
     std::atomic_bool stop_flag{false};
     ep.setStopFlag(&stop_flag);
     ep.setSlavesCount(static_cast<std::size_t>(count_));
+    ep.setIoPolicy(io_);
+    ep.setBackend(backend_);
+    ep.setProfiler(profiler_.get());
+    ep.setSimulator(sim_);
+    framework::profiling::PhaseProfiler::attachLogger(profiler_.get());
     ep.setConnectionCallback([this](bool connected) { this->model_->setConnected(connected); });
 
     model_->setListening(true);
     // Light integration: the endpoint returns only when stopping; we simulate connected status
     // changes in endpoint in future. Here we just run it until stop_ is set, then signal stop to
     // endpoint.
-    std::thread server([&] { ep.run(); });
+    std::thread server(
+        [&]
+        {
+            if (rt_.enabled())
+            {
+                std::string err;
+                if (applyRtToCurrentThread(rt_, &err))
+                {
+                    ethercat_sim::framework::logger::Logger::info(
+                        "server thread RT: prio=%d cpu=%d mlock=%s", rt_.priority, rt_.cpu,
+                        rt_.lock_memory ? "on" : "off");
+                }
+                else
+                {
+                    ethercat_sim::framework::logger::Logger::warn("server thread RT setup: %s",
+                                                                  err.c_str());
+                }
+            }
+            ep.run();
+        });
 
     model_->setStatus("listening");
     while (!stop_.load())
@@ -46,6 +72,7 @@ void SlavesController::run_()
     stop_flag.store(true);
     if (server.joinable())
         server.join();
+    framework::profiling::PhaseProfiler::attachLogger(nullptr);
     model_->setListening(false);
     model_->setStatus("stopped");
 }
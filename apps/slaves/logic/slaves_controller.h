@@ -6,6 +6,8 @@
 #include <thread>
 
 #include "bus/slaves_endpoint.h"
+#include "ethercat_sim/app/rt_config.h"
+#include "ethercat_sim/framework/profiling/phase_profiler.h"
 #include "slaves_model.h"
 
 namespace ethercat_sim::app::slaves
@@ -23,6 +25,22 @@ class SlavesController
         stop();
     }
 
+    // Real-time settings applied by the server thread when it starts; call before start()
+    void setRtConfig(RtConfig cfg)
+    {
+        rt_ = cfg;
+    }
+
+    void setIoPolicy(communication::IoPolicy io)
+    {
+        io_ = io;
+    }
+
+    void setBackend(bus::SlavesEndpoint::Backend backend)
+    {
+        backend_ = backend;
+    }
+
     void start();
     void stop();
 
@@ -31,12 +49,31 @@ class SlavesController
         return model_;
     }
 
+    // Live phase timings and datagram counters of the server loop
+    std::shared_ptr<framework::profiling::PhaseProfiler const> profiler() const
+    {
+        return profiler_;
+    }
+
+    // Simulated segment served by the endpoint; slaveStates() feeds live per-slave views
+    std::shared_ptr<simulation::NetworkSimulator const> simulator() const
+    {
+        return sim_;
+    }
+
   private:
     void run_();
 
     std::string endpoint_;
     int count_{1};
     std::shared_ptr<SlavesModel> model_{std::make_shared<SlavesModel>()};
+    std::shared_ptr<framework::profiling::PhaseProfiler> profiler_{
+        std::make_shared<framework::profiling::PhaseProfiler>()};
+    std::shared_ptr<simulation::NetworkSimulator> sim_{
+        std::make_shared<simulation::NetworkSimulator>()};
+    RtConfig rt_;
+    communication::IoPolicy io_;
+    bus::SlavesEndpoint::Backend backend_{bus::SlavesEndpoint::Backend::Poll};
     std::atomic_bool stop_{false};
     std::thread th_;
 };
@@ -1,9 +1,15 @@
 #pragma once
 
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <chrono>
 #include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
 
+#include "ethercat_sim/framework/concurrency/spsc_ring.h"
 #include "ethercat_sim/simulation/slaves/el1258_constants.h"
 #include "ethercat_sim/simulation/virtual_slave.h"
 #include "framework/logger/logger.h"
@@ -23,6 +29,10 @@ class El1258Slave : public ethercat_sim::simulation::VirtualSlave
                   std::to_string(vendor_id) + ", product=0x" + std::to_string(product_code));
         // Apply default PDO mapping to enable SAFE_OP and OPERATIONAL states
         applyDefaultTxPdoMapping();
+        // MTI process data: SM2 carries the per-channel control words, SM3 the event PDOs
+        configureProcessData(el1258::SM2_ADDRESS, el1258::MTI_OUTPUT_BYTES * el1258::CHANNEL_COUNT,
+                             el1258::SM3_ADDRESS, el1258::MTI_INPUT_BYTES * el1258::CHANNEL_COUNT,
+                             true);
         LOG_DEBUG("El1258Slave[" + std::to_string(station_addr) + "] constructor complete");
     }
 
@@ -75,13 +85,22 @@ class El1258Slave : public ethercat_sim::simulation::VirtualSlave
                 filter.raw_state       = state;
                 filter.debounce_start  = now;
                 filter.debounce_active = true;
+                filter.edge            = edges_[channel - 1].fetch_add(1) + 1;
+                pushEdge_(channel, state, toNs_(now));
+                requestRoutine();
                 LOG_DEBUG("El1258Slave[" + std::to_string(address()) + "] Channel " +
                           std::to_string(channel) + " raw state changed to " +
                           (state ? "HIGH" : "LOW") + ", starting " +
                           std::to_string(el1258::DEBOUNCE_FILTER_MS) + "ms debounce");
+
+                // Commit on the simulator timer wheel once the window closes; a later edge
+                // restarts the window and turns this timer into a no-op
+                auto const edge = filter.edge;
+                callAt(now + std::chrono::milliseconds(el1258::DEBOUNCE_FILTER_MS),
+                       [this, channel, edge, state] { settleChannel_(channel, edge, state); });
             }
 
-            // Check if debounce period has elapsed
+            // Lazy fallback when no simulator is attached: check if debounce period has elapsed
             if (filter.debounce_active)
             {
                 auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
@@ -89,10 +108,7 @@ class El1258Slave : public ethercat_sim::simulation::VirtualSlave
                 if (elapsed.count() >= el1258::DEBOUNCE_FILTER_MS)
                 {
                     filter.debounce_active = false;
-                    channels_[channel - 1] = filter.raw_state;
-                    LOG_DEBUG("El1258Slave[" + std::to_string(address()) + "] Channel " +
-                              std::to_string(channel) + " filtered state set to " +
-                              (filter.raw_state ? "HIGH" : "LOW"));
+                    settleChannel_(channel, filter.edge, filter.raw_state);
                 }
             }
         }
@@ -103,12 +119,64 @@ class El1258Slave : public ethercat_sim::simulation::VirtualSlave
     {
         if (channel >= 1 && channel <= el1258::CHANNEL_MAX)
         {
-            return channels_[channel - 1];
+            return filteredBit_(channel - 1);
         }
         return false;
     }
 
+    // One input edge for the MTI FIFOs: channel 1..8, level after the edge, time in ns on the
+    // simulator clock (only the low 32 bits reach the PDO, as on the device)
+    struct EdgeEvent
+    {
+        std::uint64_t time_ns;
+        std::uint8_t channel;
+        bool state;
+    };
+
+    // Bulk stimulus for load tests: queues edges into the channel FIFOs and moves each channel
+    // to its last level, bypassing the input filter. Call from one stimulus thread per slave (the
+    // one that calls setChannelState()). Returns the number queued; the rest raise the channel's
+    // buffer overflow flag.
+    std::size_t injectEdges(EdgeEvent const* edges, std::size_t count) noexcept
+    {
+        std::size_t queued = 0;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            auto const& e = edges[i];
+            if (e.channel < 1 || e.channel > el1258::CHANNEL_MAX)
+            {
+                continue;
+            }
+            queued += pushEdge_(e.channel, e.state, e.time_ns) ? 1 : 0;
+            auto& filter           = channel_filters_[e.channel - 1];
+            filter.raw_state       = e.state;
+            filter.debounce_active = false;
+            edges_[e.channel - 1].fetch_add(1); // cancels a pending debounce of the channel
+            setFilteredBit_(e.channel - 1u, e.state);
+        }
+        requestRoutine();
+        return queued;
+    }
+
+    // Edges waiting in a channel FIFO (approximate while a stimulus thread is injecting)
+    std::size_t pendingEdges(int channel) const noexcept
+    {
+        if (channel < 1 || channel > el1258::CHANNEL_MAX)
+        {
+            return 0;
+        }
+        return fifos_[channel - 1].size();
+    }
+
   protected:
+    // Once the master has read the previous batch, move up to 10 events per channel from the
+    // FIFOs into the TxPDOs and bump the input cycle counter
+    void onRoutine() noexcept override
+    {
+        applyMtiOutputs_();
+        fillMtiInputs_();
+    }
+
     bool onSdoUpload(uint16_t index, uint8_t subindex, uint32_t& value) const noexcept override
     {
         LOG_DEBUG("El1258Slave[" + std::to_string(address()) + "] SDO Upload: 0x" +
@@ -184,7 +252,7 @@ class El1258Slave : public ethercat_sim::simulation::VirtualSlave
             }
             if (subindex >= 1 && subindex <= el1258::CHANNEL_COUNT_U8)
             {
-                value = channels_[subindex - 1] ? 1 : 0;
+                value = filteredBit_(subindex - 1) ? 1 : 0;
                 LOG_DEBUG("El1258Slave[" + std::to_string(address()) +
                           "] SDO Upload 0x6000:" + std::to_string(subindex) + ": channel " +
                           std::to_string(subindex) + " = " + std::to_string(value));
@@ -203,7 +271,7 @@ class El1258Slave : public ethercat_sim::simulation::VirtualSlave
             if (subindex >= 1 && subindex <= el1258::CHANNEL_COUNT_U8)
             {
                 // Status: bit 0 = input state, bit 1 = error, bit 2 = overrange, bit 3 = underrange
-                value = channels_[subindex - 1] ? el1258::STATUS_INPUT_HIGH : 0u;
+                value = filteredBit_(subindex - 1) ? el1258::STATUS_INPUT_HIGH : 0u;
                 LOG_DEBUG("El1258Slave[" + std::to_string(address()) +
                           "] SDO Upload 0x6001:" + std::to_string(subindex) + ": channel " +
                           std::to_string(subindex) + " status = 0x" + std::to_string(value));
@@ -340,28 +408,171 @@ class El1258Slave : public ethercat_sim::simulation::VirtualSlave
     }
 
   private:
-    // Input filter structure for 3ms debouncing
+    // Input filter structure for 3ms debouncing, owned by the stimulus thread
     struct ChannelFilter
     {
         bool raw_state{false};                                // Raw input state
         bool debounce_active{false};                          // Debounce timer active
         std::chrono::steady_clock::time_point debounce_start; // Debounce start time
+        std::uint32_t edge{0};                                // Edge the debounce waits on
+    };
+
+    // Edge as queued in a channel FIFO
+    struct Edge
+    {
+        std::uint64_t time_ns;
+        bool state;
     };
+    using EdgeFifo = framework::concurrency::SpscRing<Edge, el1258::MTI_FIFO_DEPTH>;
+
+    static std::uint64_t toNs_(std::chrono::steady_clock::time_point t) noexcept
+    {
+        return static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(t.time_since_epoch()).count());
+    }
+
+    bool pushEdge_(int channel, bool state, std::uint64_t time_ns) noexcept
+    {
+        if (fifos_[channel - 1].tryPush(Edge{time_ns, state}))
+        {
+            return true;
+        }
+        overflow_[channel - 1].store(true, std::memory_order_relaxed);
+        return false;
+    }
+
+    void applyMtiOutputs_() noexcept
+    {
+        if (!updateOutputs())
+        {
+            return;
+        }
+        for (std::size_t ch = 0; ch < el1258::CHANNEL_COUNT; ++ch)
+        {
+            std::uint8_t const* ctrl = outputs() + ch * el1258::MTI_OUTPUT_BYTES;
+            if (ctrl[0] & el1258::MTI_CTRL_BUFFER_RESET)
+            {
+                Edge dropped;
+                while (fifos_[ch].tryPop(dropped))
+                {
+                }
+                overflow_[ch].store(false, std::memory_order_relaxed);
+            }
+            order_[ch] = ctrl[2]; // echoed as input order feedback
+        }
+    }
+
+    void fillMtiInputs_() noexcept
+    {
+        if (!inputsConsumed())
+        {
+            return; // the last batch has not reached the master yet
+        }
+        // A new PDO cycle per master read, as the device refreshes its TxPDOs every cycle: the
+        // input cycle counter tells a fresh batch from a re-read one
+        ++cycle_;
+        auto const cycle =
+            static_cast<std::uint8_t>((cycle_ & 3u) << el1258::MTI_STATUS_CYCLE_SHIFT);
+        std::uint8_t* image = inputsBuffer();
+        for (std::size_t ch = 0; ch < el1258::CHANNEL_COUNT; ++ch)
+        {
+            std::uint8_t* pdo    = image + ch * el1258::MTI_INPUT_BYTES;
+            std::uint8_t* times  = pdo + el1258::MTI_INPUT_TIMES_OFFSET;
+            std::uint32_t states = 0;
+            std::size_t n        = 0;
+            Edge e;
+            while (n < el1258::MTI_EVENTS_PER_PDO && fifos_[ch].tryPop(e))
+            {
+                states |= (e.state ? 1u : 0u) << n;
+                auto const t = static_cast<std::uint32_t>(e.time_ns);
+                for (std::size_t b = 0; b < 4; ++b)
+                {
+                    times[4 * n + b] = static_cast<std::uint8_t>(t >> (8 * b));
+                }
+                ++n;
+            }
+            std::memset(times + 4 * n, 0, 4 * (el1258::MTI_EVENTS_PER_PDO - n));
+
+            bool const overflow = overflow_[ch].exchange(false, std::memory_order_relaxed);
+            auto const status   = static_cast<std::uint8_t>(
+                (filteredBit_(ch) ? el1258::MTI_STATUS_INPUT_STATE : 0u) |
+                (overflow ? el1258::MTI_STATUS_BUFFER_OVERFLOW : 0u));
+            auto const remaining =
+                static_cast<std::uint8_t>(std::min<std::size_t>(fifos_[ch].size(), 0xFF));
+
+            pdo[0] = static_cast<std::uint8_t>(n);
+            pdo[1] = static_cast<std::uint8_t>(status | cycle);
+            pdo[2] = remaining;
+            pdo[3] = order_[ch];
+            for (std::size_t b = 0; b < 4; ++b)
+            {
+                pdo[4 + b] = static_cast<std::uint8_t>(states >> (8 * b));
+            }
+        }
+        commitInputs();
+    }
+
+    // Commits a debounced level, run on the simulation thread (or on the stimulus thread without
+    // a simulator). The edge counter is checked after loading the level word and the word is
+    // replaced by compare-exchange, so a stimulus edge that lands in between (counter bumped,
+    // then bit set) either fails the exchange or the re-check: its level is never overwritten.
+    void settleChannel_(int channel, std::uint32_t edge, bool state) noexcept
+    {
+        auto const ch      = static_cast<std::size_t>(channel - 1);
+        uint32_t const bit = 1u << ch;
+        uint32_t bits      = filtered_bits_.load();
+        uint32_t next;
+        do
+        {
+            if (edges_[ch].load() != edge)
+            {
+                return; // a later edge restarted the filter
+            }
+            next = state ? (bits | bit) : (bits & ~bit);
+        } while (!filtered_bits_.compare_exchange_weak(bits, next));
+        LOG_DEBUG("El1258Slave[" + std::to_string(address()) + "] Channel " +
+                  std::to_string(channel) + " filtered state set to " + (state ? "HIGH" : "LOW"));
+    }
+
+    bool filteredBit_(std::size_t ch) const noexcept
+    {
+        return ((filtered_bits_.load(std::memory_order_acquire) >> ch) & 1u) != 0;
+    }
+    void setFilteredBit_(std::size_t ch, bool state) noexcept
+    {
+        uint32_t const bit = 1u << ch;
+        if (state)
+        {
+            filtered_bits_.fetch_or(bit);
+        }
+        else
+        {
+            filtered_bits_.fetch_and(~bit);
+        }
+    }
 
     uint32_t currentAggregate_() const noexcept
     {
-        uint32_t raw = 0;
-        for (std::size_t i = 0; i < el1258::CHANNEL_COUNT; ++i)
-            raw |= (channels_[i] ? (1u << i) : 0u);
-        return (raw ^ invert_mask_) & el1258::CHANNEL_MASK;
+        return (filtered_bits_.load(std::memory_order_acquire) ^ invert_mask_) &
+               el1258::CHANNEL_MASK;
     }
 
-    std::array<bool, el1258::CHANNEL_COUNT> channels_{}; // Filtered channel states
+    // Filtered channel states, bit n = channel n + 1. Written by the stimulus thread (edges that
+    // bypass the filter) and by the debounce on the simulation thread, read by both.
+    std::atomic<uint32_t> filtered_bits_{0};
+    // Raw edges per channel; a debounce only commits if no edge followed the one it waits on
+    std::array<std::atomic<std::uint32_t>, el1258::CHANNEL_COUNT> edges_{};
     std::array<ChannelFilter, el1258::CHANNEL_COUNT>
         channel_filters_{}; // Input filters for each channel
     uint32_t invert_mask_{0};
     uint32_t debounce_ms_{0};
 
+    // MTI edge capture: stimulus thread -> FIFOs -> routine() -> SM3
+    std::array<EdgeFifo, el1258::CHANNEL_COUNT> fifos_{};
+    std::array<std::atomic<bool>, el1258::CHANNEL_COUNT> overflow_{};
+    std::array<std::uint8_t, el1258::CHANNEL_COUNT> order_{};
+    std::uint8_t cycle_{0};
+
     // Status and error handling
     uint32_t error_register_{0};      // Error register (0x8002)
     uint32_t manufacturer_status_{0}; // Manufacturer status register (0x8003)
@@ -373,4 +584,36 @@ class El1258Slave : public ethercat_sim::simulation::VirtualSlave
     bool assigned_{false};
 };
 
+// Load generator for the edge-capture pipeline: on every channel in channel_mask (bit 0 = channel
+// 1) of each slave, edges_per_channel alternating edges (rising first), period_ns apart from
+// start_ns; channels are staggered by period_ns / 8 so their timestamps interleave. Returns the
+// edges queued across all slaves.
+inline std::size_t injectEdgeTrain(std::vector<std::shared_ptr<El1258Slave>> const& slaves,
+                                   std::uint8_t channel_mask, std::uint64_t start_ns,
+                                   std::uint64_t period_ns, std::size_t edges_per_channel)
+{
+    std::vector<El1258Slave::EdgeEvent> train;
+    train.reserve(edges_per_channel * el1258::CHANNEL_COUNT);
+    for (std::size_t k = 0; k < edges_per_channel; ++k)
+    {
+        for (std::size_t ch = 0; ch < el1258::CHANNEL_COUNT; ++ch)
+        {
+            if (channel_mask & (1u << ch))
+            {
+                train.push_back({start_ns + k * period_ns + ch * (period_ns / 8),
+                                 static_cast<std::uint8_t>(ch + 1), (k & 1u) == 0});
+            }
+        }
+    }
+    std::size_t queued = 0;
+    for (auto const& slave : slaves)
+    {
+        if (slave)
+        {
+            queued += slave->injectEdges(train.data(), train.size());
+        }
+    }
+    return queued;
+}
+
 } // namespace ethercat_sim::subs
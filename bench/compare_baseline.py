@@ -0,0 +1,96 @@
+#!/usr/bin/env python3
+"""Compare an ethercat_bench JSON run against a stored baseline.
+
+  ethercat_bench --benchmark_out=run.json --benchmark_out_format=json
+  bench/compare_baseline.py run.json                      # vs bench/baseline.json
+  bench/compare_baseline.py run.json --threshold 0.15     # allow +15% CPU time
+  bench/compare_baseline.py run.json --update             # store run.json as the new baseline
+
+Exits with status 1 when a benchmark present in both files got slower than the threshold, so CI
+and rig scripts can gate on it. With --benchmark_repetitions the median aggregate is compared.
+"""
+
+import argparse
+import json
+import os
+import sys
+
+DEFAULT_BASELINE = os.path.join(os.path.dirname(os.path.abspath(__file__)), "baseline.json")
+
+TO_NS = {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}
+
+
+def load(path):
+    """Returns {name: cpu_time_ns}, preferring median aggregates over single iterations."""
+    with open(path) as f:
+        data = json.load(f)
+    times = {}
+    medians = {}
+    for b in data.get("benchmarks", []):
+        if b.get("error_occurred"):
+            continue
+        ns = float(b["cpu_time"]) * TO_NS[b.get("time_unit", "ns")]
+        if b.get("run_type") == "aggregate":
+            if b.get("aggregate_name") == "median":
+                medians[b["run_name"]] = ns
+        else:
+            times.setdefault(b.get("run_name", b["name"]), ns)
+    times.update(medians)
+    return times
+
+
+def update(run_path, baseline_path):
+    with open(run_path) as f:
+        data = json.load(f)
+    keep = ("name", "run_name", "run_type", "aggregate_name", "iterations", "real_time",
+            "cpu_time", "time_unit")
+    out = {
+        "context": {k: data.get("context", {}).get(k) for k in ("host_name", "num_cpus",
+                                                                 "mhz_per_cpu", "library_build_type")},
+        "benchmarks": [{k: b[k] for k in keep if k in b} for b in data.get("benchmarks", [])
+                       if not b.get("error_occurred")],
+    }
+    with open(baseline_path, "w") as f:
+        json.dump(out, f, indent=2)
+        f.write("\n")
+    print(f"baseline updated: {baseline_path} ({len(out['benchmarks'])} entries)")
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawTextHelpFormatter)
+    ap.add_argument("run", help="google-benchmark JSON output of ethercat_bench")
+    ap.add_argument("--baseline", default=DEFAULT_BASELINE)
+    ap.add_argument("--threshold", type=float, default=0.10,
+                    help="allowed relative CPU time increase (default 0.10 = +10%%)")
+    ap.add_argument("--update", action="store_true", help="write the run as the new baseline")
+    args = ap.parse_args()
+
+    if args.update:
+        update(args.run, args.baseline)
+        return 0
+
+    base = load(args.baseline)
+    run = load(args.run)
+    regressions = 0
+    print(f"{'benchmark':<50} {'baseline':>12} {'current':>12} {'change':>8}")
+    for name in sorted(set(base) | set(run)):
+        if name not in base or name not in run:
+            where = "baseline" if name not in base else "run"
+            print(f"{name:<50} {'':>12} {'':>12}  missing in {where}")
+            continue
+        change = run[name] / base[name] - 1.0
+        flag = ""
+        if change > args.threshold:
+            flag = "  REGRESSION"
+            regressions += 1
+        print(f"{name:<50} {base[name]:>10.1f}ns {run[name]:>10.1f}ns {change:>+7.1%}{flag}")
+
+    if regressions:
+        print(f"{regressions} benchmark(s) slower than baseline by more than "
+              f"{args.threshold:.0%}", file=sys.stderr)
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,58 @@
+// Publish latency of the DDS process image bridge at a fixed cycle rate.
+// Usage: bench_dds_publish_latency [cycles=5000] [period_us=1000] [image_bytes=512]
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include "ethercat_sim/communication/dds_process_image_bridge.h"
+
+int main(int argc, char** argv)
+{
+    using clock          = std::chrono::steady_clock;
+    int const cycles     = argc > 1 ? std::atoi(argv[1]) : 5000;
+    int const period_us  = argc > 2 ? std::atoi(argv[2]) : 1000;
+    std::size_t const sz = argc > 3 ? static_cast<std::size_t>(std::atoi(argv[3])) : 512;
+
+    ethercat_sim::communication::ProcessImageBridge bridge("bench_process_image");
+    if (!bridge.valid())
+    {
+        std::fprintf(stderr, "DDS bridge unavailable (SHM transport?)\n");
+        return 1;
+    }
+
+    std::vector<std::uint8_t> inputs(sz), outputs(sz);
+    std::vector<std::int64_t> lat_ns;
+    lat_ns.reserve(static_cast<std::size_t>(cycles));
+    int failures = 0;
+
+    auto const period = std::chrono::microseconds(period_us);
+    auto deadline     = clock::now() + period;
+    for (int i = 0; i < cycles; ++i)
+    {
+        inputs[0]  = static_cast<std::uint8_t>(i);
+        outputs[0] = static_cast<std::uint8_t>(~i);
+        auto t0    = clock::now();
+        if (!bridge.publish(inputs.data(), inputs.size(), outputs.data(), outputs.size()))
+        {
+            ++failures;
+        }
+        lat_ns.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - t0)
+                             .count());
+        std::this_thread::sleep_until(deadline);
+        deadline += period;
+    }
+
+    std::sort(lat_ns.begin(), lat_ns.end());
+    auto pct = [&](double p)
+    { return lat_ns[static_cast<std::size_t>(p * static_cast<double>(lat_ns.size() - 1))]; };
+    std::printf("dds publish: cycles=%d period=%dus bytes=%zu failures=%d\n", cycles, period_us,
+                sz, failures);
+    std::printf("  p50=%lldns p99=%lldns p99.9=%lldns max=%lldns\n",
+                static_cast<long long>(pct(0.50)), static_cast<long long>(pct(0.99)),
+                static_cast<long long>(pct(0.999)), static_cast<long long>(lat_ns.back()));
+    return 0;
+}
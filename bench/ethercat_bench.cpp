@@ -0,0 +1,346 @@
+// Micro-benchmarks for the simulator frame path (google-benchmark).
+// Usage: ethercat_bench [--benchmark_filter=REGEX] [--benchmark_out=FILE --benchmark_out_format=json]
+// bench/compare_baseline.py compares a JSON run against bench/baseline.json.
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "kickcat/Frame.h"
+#include "kickcat/protocol.h"
+
+#include "bus/slaves_endpoint.h"
+#include "ethercat_sim/kickcat/sim_socket.h"
+#include "ethercat_sim/simulation/axis_bank.h"
+#include "ethercat_sim/simulation/network_simulator.h"
+#include "ethercat_sim/simulation/virtual_slave.h"
+#include "ethercat_sim/simulation/waveform_bank.h"
+#include "framework/logger/logger.h"
+
+namespace
+{
+
+using ethercat_sim::kickcat::SimSocket;
+using ethercat_sim::simulation::AxisBank;
+using ethercat_sim::simulation::NetworkSimulator;
+using ethercat_sim::simulation::VirtualSlave;
+using ethercat_sim::simulation::WaveformBank;
+
+std::shared_ptr<NetworkSimulator> makeSimulator(std::size_t slaves)
+{
+    auto sim = std::make_shared<NetworkSimulator>();
+    sim->initialize();
+    sim->clearSlaves();
+    for (std::size_t i = 0; i < slaves; ++i)
+    {
+        sim->addVirtualSlave(
+            std::make_shared<VirtualSlave>(static_cast<uint16_t>(1 + i), 0x9A, 0x1111, "bench"));
+    }
+    sim->startAllSlaves();
+    return sim;
+}
+
+std::vector<uint8_t> finalize(::kickcat::Frame& frame)
+{
+    int32_t size = frame.finalize();
+    return std::vector<uint8_t>(frame.data(), frame.data() + size);
+}
+
+// Frame mixes seen on a real bus
+enum Mix
+{
+    kStatusPoll, // one FPRD AL_STATUS (state machine polling)
+    kDiscovery,  // BRD + APRD per slave (bus scan)
+    kCyclic,     // LRW process image + FPRD AL_STATUS per slave (cyclic exchange)
+};
+
+constexpr std::size_t kMixSlaves = 8;
+
+std::vector<uint8_t> buildMix(int mix)
+{
+    ::kickcat::Frame frame;
+    uint16_t word = 0;
+    uint8_t image[64]{};
+    switch (mix)
+    {
+    case kStatusPoll:
+        frame.addDatagram(0, ::kickcat::Command::FPRD,
+                          ::kickcat::createAddress(1, ::kickcat::reg::AL_STATUS), &word,
+                          sizeof(word));
+        break;
+    case kDiscovery:
+        frame.addDatagram(0, ::kickcat::Command::BRD,
+                          ::kickcat::createAddress(0, ::kickcat::reg::TYPE), &word, sizeof(word));
+        for (std::size_t i = 0; i < kMixSlaves; ++i)
+        {
+            frame.addDatagram(static_cast<uint8_t>(1 + i), ::kickcat::Command::APRD,
+                              ::kickcat::createAddress(static_cast<uint16_t>(0 - i),
+                                                       ::kickcat::reg::STATION_ADDR),
+                              &word, sizeof(word));
+        }
+        break;
+    default:
+        frame.addDatagram(0, ::kickcat::Command::LRW, 0, image, sizeof(image));
+        for (std::size_t i = 0; i < kMixSlaves; ++i)
+        {
+            frame.addDatagram(static_cast<uint8_t>(1 + i), ::kickcat::Command::FPRD,
+                              ::kickcat::createAddress(static_cast<uint16_t>(1 + i),
+                                                       ::kickcat::reg::AL_STATUS),
+                              &word, sizeof(word));
+        }
+        break;
+    }
+    return finalize(frame);
+}
+
+void roundTrip(benchmark::State& state, SimSocket& sock, std::vector<uint8_t> const& tx,
+               std::vector<uint8_t>& rx)
+{
+    auto const size = static_cast<int32_t>(tx.size());
+    if (sock.write(tx.data(), size) != size ||
+        sock.read(rx.data(), static_cast<int32_t>(rx.size())) != size)
+    {
+        state.SkipWithError("round trip failed");
+    }
+}
+
+// SimSocket write + read of one frame; range(0) = mix, range(1) = direct mode
+void BM_SimSocketWrite(benchmark::State& state)
+{
+    auto sim = makeSimulator(kMixSlaves);
+    SimSocket sock(sim);
+    sock.setDirect(state.range(1) != 0);
+    auto tx = buildMix(static_cast<int>(state.range(0)));
+    std::vector<uint8_t> rx(::kickcat::ETH_MAX_SIZE);
+    for (auto _ : state)
+    {
+        roundTrip(state, sock, tx, rx);
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(tx.size()));
+}
+BENCHMARK(BM_SimSocketWrite)
+    ->ArgNames({"mix", "direct"})
+    ->ArgsProduct({{kStatusPoll, kDiscovery, kCyclic}, {0, 1}});
+
+// SlavesEndpoint frame handler (EL1258 slaves, as served over uds/tcp/eth); range(0) = mix
+void BM_SlavesEndpointProcessFrame(benchmark::State& state)
+{
+    ethercat_sim::bus::SlavesEndpoint ep("uds:///unused");
+    ep.setSlavesCount(kMixSlaves);
+    ep.prepare();
+    auto const tx = buildMix(static_cast<int>(state.range(0)));
+    std::vector<uint8_t> buf(tx.size());
+    for (auto _ : state)
+    {
+        std::memcpy(buf.data(), tx.data(), tx.size());
+        ep.serveFrame(buf.data(), static_cast<int32_t>(buf.size()));
+        benchmark::DoNotOptimize(buf.data());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SlavesEndpointProcessFrame)->ArgName("mix")->DenseRange(kStatusPoll, kCyclic);
+
+// One simulation tick over range(0) slaves, one mapped input per slave
+void BM_NetworkSimulatorRunOnce(benchmark::State& state)
+{
+    auto const slaves = static_cast<std::size_t>(state.range(0));
+    auto sim          = std::make_shared<NetworkSimulator>();
+    sim->initialize();
+    std::vector<std::shared_ptr<VirtualSlave>> registry;
+    for (std::size_t i = 0; i < slaves; ++i)
+    {
+        auto s = std::make_shared<VirtualSlave>(static_cast<uint16_t>(1 + i), 0x9A, 0x1111, "b");
+        sim->addVirtualSlave(s);
+        sim->mapDigitalInputs(s, static_cast<uint32_t>(i % 4096));
+        registry.push_back(std::move(s));
+    }
+    sim->startAllSlaves();
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(sim->runOnce());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(slaves));
+}
+BENCHMARK(BM_NetworkSimulatorRunOnce)->ArgName("slaves")->RangeMultiplier(10)->Range(1, 10000);
+
+// Station-addressed (FP) and auto-increment (AP) register access on the last of range(0) slaves
+void BM_RegisterAccessFP(benchmark::State& state)
+{
+    auto const slaves = static_cast<std::size_t>(state.range(0));
+    auto sim          = makeSimulator(slaves);
+    auto const addr   = static_cast<uint16_t>(slaves);
+    uint8_t buf[2]{};
+    for (auto _ : state)
+    {
+        bool ok = sim->readFromSlave(addr, ::kickcat::reg::AL_STATUS, buf, sizeof(buf));
+        ok &= sim->writeToSlave(addr, ::kickcat::reg::WDG_DIVIDER, buf, sizeof(buf));
+        benchmark::DoNotOptimize(ok);
+    }
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+BENCHMARK(BM_RegisterAccessFP)->ArgName("slaves")->Arg(1)->Arg(100)->Arg(1000);
+
+void BM_RegisterAccessAP(benchmark::State& state)
+{
+    auto const slaves = static_cast<std::size_t>(state.range(0));
+    auto sim          = makeSimulator(slaves);
+    auto const index  = slaves - 1;
+    uint8_t buf[2]{};
+    for (auto _ : state)
+    {
+        bool ok = sim->readFromSlaveByIndex(index, ::kickcat::reg::AL_STATUS, buf, sizeof(buf));
+        ok &= sim->writeToSlaveByIndex(index, ::kickcat::reg::WDG_DIVIDER, buf, sizeof(buf));
+        benchmark::DoNotOptimize(ok);
+    }
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+BENCHMARK(BM_RegisterAccessAP)->ArgName("slaves")->Arg(1)->Arg(100)->Arg(1000);
+
+// LRW of a range(0)-KiB process image, split into full-size datagrams, through SimSocket
+void BM_LrwImage(benchmark::State& state)
+{
+    auto sim = makeSimulator(1);
+    SimSocket sock(sim);
+    sock.setDirect(true);
+
+    auto const image_bytes = static_cast<std::size_t>(state.range(0)) * 1024u;
+    std::vector<uint8_t> image(::kickcat::MAX_ETHERCAT_PAYLOAD_SIZE, 0x5A);
+    std::vector<std::vector<uint8_t>> frames;
+    for (std::size_t off = 0; off < image_bytes; off += ::kickcat::MAX_ETHERCAT_PAYLOAD_SIZE)
+    {
+        auto len = static_cast<uint16_t>(
+            std::min<std::size_t>(::kickcat::MAX_ETHERCAT_PAYLOAD_SIZE, image_bytes - off));
+        ::kickcat::Frame frame;
+        frame.addDatagram(0, ::kickcat::Command::LRW, static_cast<uint32_t>(off), image.data(),
+                          len);
+        frames.push_back(finalize(frame));
+    }
+    std::vector<uint8_t> rx(::kickcat::ETH_MAX_SIZE);
+    for (auto _ : state)
+    {
+        for (auto const& tx : frames)
+        {
+            roundTrip(state, sock, tx, rx);
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(image_bytes));
+    state.counters["frames"] = static_cast<double>(frames.size());
+}
+BENCHMARK(BM_LrwImage)->ArgName("KiB")->RangeMultiplier(4)->Range(1, 64);
+
+// Expedited CoE SDO upload (0x1018:01): mailbox write, SM1 status poll, mailbox read
+void BM_SdoUploadRoundTrip(benchmark::State& state)
+{
+    auto sim = makeSimulator(1);
+    SimSocket sock(sim);
+    sock.setDirect(true);
+
+    constexpr uint16_t kMbxIn  = 0x1000; // VirtualSlave default receive mailbox (SM0)
+    constexpr uint16_t kMbxOut = 0x1200; // VirtualSlave default send mailbox (SM1)
+    constexpr uint16_t kMbxLen = 128;
+
+    uint8_t request[kMbxLen]{};
+    auto* header = reinterpret_cast<::kickcat::mailbox::Header*>(request);
+    auto* coe    = ::kickcat::pointData<::kickcat::CoE::Header>(header);
+    auto* sdo    = ::kickcat::pointData<::kickcat::CoE::ServiceData>(coe);
+    header->len   = 10;
+    header->type  = ::kickcat::mailbox::CoE;
+    header->count = 1;
+    coe->service  = ::kickcat::CoE::SDO_REQUEST;
+    sdo->command  = ::kickcat::CoE::SDO::request::UPLOAD;
+    sdo->index    = 0x1018;
+    sdo->subindex = 1;
+
+    ::kickcat::Frame write_frame;
+    write_frame.addDatagram(0, ::kickcat::Command::FPWR, ::kickcat::createAddress(1, kMbxIn),
+                            request, sizeof(request));
+    auto const tx_write = finalize(write_frame);
+
+    uint8_t status = 0;
+    ::kickcat::Frame status_frame;
+    status_frame.addDatagram(1, ::kickcat::Command::FPRD,
+                             ::kickcat::createAddress(1, ::kickcat::reg::SYNC_MANAGER_1 +
+                                                             ::kickcat::reg::SM_STATS),
+                             &status, sizeof(status));
+    auto const tx_status = finalize(status_frame);
+
+    uint8_t reply[kMbxLen]{};
+    ::kickcat::Frame read_frame;
+    read_frame.addDatagram(2, ::kickcat::Command::FPRD, ::kickcat::createAddress(1, kMbxOut),
+                           reply, sizeof(reply));
+    auto const tx_read = finalize(read_frame);
+
+    std::vector<uint8_t> rx(::kickcat::ETH_MAX_SIZE);
+    for (auto _ : state)
+    {
+        roundTrip(state, sock, tx_write, rx);
+        roundTrip(state, sock, tx_status, rx);
+        roundTrip(state, sock, tx_read, rx);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SdoUploadRoundTrip);
+
+// One sample for range(0) analog channels, a mix of sine, ramp and noise; items are channel
+// samples, so 10k channels at 10 kHz need 1e8 items/s
+void BM_WaveformBankSample(benchmark::State& state)
+{
+    auto const lanes = static_cast<std::size_t>(state.range(0));
+    WaveformBank bank;
+    bank.addLanes(lanes);
+    for (std::size_t i = 0; i < lanes; ++i)
+    {
+        auto const shape = static_cast<WaveformBank::Shape>(1 + i % 3);
+        bank.setWaveform(static_cast<WaveformBank::Lane>(i),
+                         {shape, 0.0f, 10.0f, 50.0f + static_cast<float>(i % 100)});
+    }
+    for (auto _ : state)
+    {
+        bank.generate(1);
+        benchmark::DoNotOptimize(bank.latest(0));
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(lanes));
+}
+BENCHMARK(BM_WaveformBankSample)->ArgName("channels")->RangeMultiplier(10)->Range(100, 10000);
+
+// One step of range(0) drive axes in a mix of CSP, CSV and CST; items are axis steps, so a
+// 64-axis machine at 4 kHz needs 256k items/s
+void BM_AxisBankStep(benchmark::State& state)
+{
+    auto const axes = static_cast<std::size_t>(state.range(0));
+    AxisBank bank;
+    for (std::size_t i = 0; i < axes; ++i)
+    {
+        auto const axis = bank.addAxis();
+        bank.command(axis, static_cast<AxisBank::Mode>(1 + i % 3), 1000.0, 500.0, 10.0);
+    }
+    for (auto _ : state)
+    {
+        bank.step(1);
+        benchmark::DoNotOptimize(bank.position(0));
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(axes));
+}
+BENCHMARK(BM_AxisBankStep)->ArgName("axes")->RangeMultiplier(8)->Range(8, 4096);
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    // The frame path logs every datagram at debug level; keep the measurement about the path
+    ethercat_sim::framework::logger::Logger::setLevel(
+        ethercat_sim::framework::logger::LogLevel::WARN);
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+    {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,71 @@
+// In-process SimSocket throughput: write + read of one FPRD frame, queued vs direct mode.
+// Usage: bench_sim_socket [frames=200000]
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+#include "kickcat/Frame.h"
+#include "kickcat/protocol.h"
+
+#include "ethercat_sim/kickcat/sim_socket.h"
+#include "ethercat_sim/simulation/network_simulator.h"
+#include "ethercat_sim/simulation/virtual_slave.h"
+#include "framework/logger/logger.h"
+
+namespace
+{
+
+double framesPerSecond(bool direct, int frames, std::vector<uint8_t> const& tx)
+{
+    using ethercat_sim::simulation::NetworkSimulator;
+    using ethercat_sim::simulation::VirtualSlave;
+
+    auto sim = std::make_shared<NetworkSimulator>();
+    sim->initialize();
+    sim->clearSlaves();
+    sim->addVirtualSlave(std::make_shared<VirtualSlave>(1, 0x9A, 0x1111, "S1"));
+
+    ethercat_sim::kickcat::SimSocket sock(sim);
+    sock.setDirect(direct);
+
+    auto const size = static_cast<int32_t>(tx.size());
+    std::vector<uint8_t> rx(::kickcat::ETH_MAX_SIZE);
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < frames; ++i)
+    {
+        if (sock.write(tx.data(), size) != size ||
+            sock.read(rx.data(), static_cast<int32_t>(rx.size())) != size)
+        {
+            std::fprintf(stderr, "round trip %d failed\n", i);
+            std::exit(1);
+        }
+    }
+    std::chrono::duration<double> dt = std::chrono::steady_clock::now() - t0;
+    return frames / dt.count();
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    int frames = argc > 1 ? std::atoi(argv[1]) : 200000;
+    ethercat_sim::framework::logger::Logger::setLevel(
+        ethercat_sim::framework::logger::LogLevel::WARN);
+
+    ::kickcat::Frame frame;
+    uint16_t al_status = 0;
+    frame.addDatagram(0, ::kickcat::Command::FPRD,
+                      ::kickcat::createAddress(1, ::kickcat::reg::AL_STATUS), &al_status,
+                      sizeof(al_status));
+    int32_t const size = frame.finalize();
+    std::vector<uint8_t> tx(frame.data(), frame.data() + size);
+
+    double queued = framesPerSecond(false, frames, tx);
+    double direct = framesPerSecond(true, frames, tx);
+    std::printf("sim socket: frames=%d queued=%.0f frames/s direct=%.0f frames/s (x%.2f)\n",
+                frames, queued, direct, direct / queued);
+    return 0;
+}
@@ -0,0 +1,162 @@
+// Round-trip latency of the master <-> slaves stream transport.
+// Runs an in-process SlavesEndpoint and a MasterSocket over UDS and times FPRD frames.
+// --burst N writes N frames before reading the N replies (one round trip per burst, like a cycle
+// whose process image spans several frames); --wire-v1 sends each frame as its own message;
+// --io-uring serves with the io_uring backend instead of the poll backend.
+// Usage: bench_transport_rtt [frames=20000] [--burst N] [--wire-v1] [--io-uring] [--busy-poll]
+//                            [--spin-us N] [--tcp HOST:PORT]
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include "kickcat/Frame.h"
+#include "kickcat/protocol.h"
+
+#include "bus/master_socket.h"
+#include "bus/slaves_endpoint.h"
+#include "ethercat_sim/communication/socket_io.h"
+
+int main(int argc, char** argv)
+{
+    using clock  = std::chrono::steady_clock;
+    int frames   = 20000;
+    int burst    = 1;
+    int wire     = 2;
+    auto backend = ethercat_sim::bus::SlavesEndpoint::Backend::Poll;
+    ethercat_sim::communication::IoPolicy io;
+    std::string endpoint =
+        "uds:///tmp/ethercat_bench_rtt_" + std::to_string(static_cast<long>(::getpid())) + ".sock";
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string a = argv[i];
+        if (a == "--busy-poll")
+        {
+            io.busy_poll = true;
+        }
+        else if (a == "--spin-us" && i + 1 < argc)
+        {
+            io.spin_budget = std::chrono::microseconds(std::atoi(argv[++i]));
+        }
+        else if (a == "--burst" && i + 1 < argc)
+        {
+            burst = std::max(1, std::atoi(argv[++i]));
+        }
+        else if (a == "--io-uring")
+        {
+            backend = ethercat_sim::bus::SlavesEndpoint::Backend::IoUring;
+        }
+        else if (a == "--wire-v1")
+        {
+            wire = 1;
+        }
+        else if (a == "--tcp" && i + 1 < argc)
+        {
+            endpoint = std::string("tcp://") + argv[++i];
+        }
+        else
+        {
+            frames = std::atoi(argv[i]);
+        }
+    }
+
+    std::atomic_bool stop{false};
+    ethercat_sim::bus::SlavesEndpoint server(endpoint);
+    server.setSlavesCount(1);
+    server.setStopFlag(&stop);
+    server.setIoPolicy(io);
+    server.setBackend(backend);
+    std::thread server_thread([&] { server.run(); });
+
+    ethercat_sim::bus::MasterSocket sock(endpoint, io);
+    for (int attempt = 0;; ++attempt)
+    {
+        try
+        {
+            sock.open("");
+            break;
+        }
+        catch (std::exception const&)
+        {
+            if (attempt > 100)
+            {
+                std::fprintf(stderr, "cannot connect to %s\n", endpoint.c_str());
+                stop.store(true);
+                server_thread.join();
+                return 1;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        }
+    }
+    sock.setTimeout(std::chrono::seconds(1));
+    sock.setWireVersion(wire);
+
+    // One FPRD of AL_STATUS, the typical small cyclic datagram
+    ::kickcat::Frame frame;
+    uint16_t al_status = 0;
+    frame.addDatagram(0, ::kickcat::Command::FPRD, ::kickcat::createAddress(1, ::kickcat::reg::AL_STATUS),
+                      &al_status, sizeof(al_status));
+    int32_t const size = frame.finalize();
+    std::vector<uint8_t> tx(frame.data(), frame.data() + size);
+    std::vector<uint8_t> rx(1514);
+
+    std::vector<std::int64_t> rtt_ns;
+    rtt_ns.reserve(static_cast<std::size_t>(frames));
+    int errors = 0;
+    for (int i = 0; i < frames; i += burst)
+    {
+        auto t0 = clock::now();
+        bool ok = true;
+        for (int b = 0; b < burst && ok; ++b)
+        {
+            ok = sock.write(tx.data(), size) == size;
+        }
+        for (int b = 0; b < burst && ok; ++b)
+        {
+            ok = sock.read(rx.data(), 1514) == size;
+        }
+        if (!ok)
+        {
+            ++errors;
+            continue;
+        }
+        rtt_ns.push_back(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - t0).count());
+    }
+    sock.close();
+    auto const served = server.stats();
+    stop.store(true);
+    server_thread.join();
+
+    if (rtt_ns.empty())
+    {
+        std::fprintf(stderr, "no successful round trip (%d errors)\n", errors);
+        return 1;
+    }
+    std::sort(rtt_ns.begin(), rtt_ns.end());
+    auto pct = [&](double p)
+    { return rtt_ns[static_cast<std::size_t>(p * static_cast<double>(rtt_ns.size() - 1))]; };
+    std::printf("transport rtt: %s backend=%s wire=v%d burst=%d busy_poll=%s spin=%lldus "
+                "rounds=%zu errors=%d\n",
+                endpoint.c_str(),
+                backend == ethercat_sim::bus::SlavesEndpoint::Backend::IoUring ? "io_uring"
+                                                                               : "poll",
+                wire, burst, io.busy_poll ? "on" : "off",
+                static_cast<long long>(io.spin_budget.count()), rtt_ns.size(), errors);
+    std::printf("  server: frames=%llu syscalls=%llu (%.2f per frame)\n",
+                static_cast<unsigned long long>(served.frames),
+                static_cast<unsigned long long>(served.syscalls),
+                served.frames ? static_cast<double>(served.syscalls) / served.frames : 0.0);
+    std::printf("  p50=%lldns p99=%lldns p99.9=%lldns max=%lldns\n",
+                static_cast<long long>(pct(0.50)), static_cast<long long>(pct(0.99)),
+                static_cast<long long>(pct(0.999)), static_cast<long long>(rtt_ns.back()));
+    return 0;
+}
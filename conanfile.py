@@ -14,12 +14,14 @@ class EtherCATSimulatorRecipe(ConanFile):
         "with_qt": [True, False],
         "with_fastdds": [True, False],
         "with_ftxui": [True, False],
+        "with_benchmark": [True, False],
     }
     default_options = {
         "with_kickcat": False,
         "with_qt": False,
         "with_fastdds": False,
         "with_ftxui": False,
+        "with_benchmark": False,
     }
 
     def layout(self):
@@ -40,3 +42,5 @@ class EtherCATSimulatorRecipe(ConanFile):
             self.requires("fast-dds/3.2.1")
         if bool(self.options.get_safe("with_ftxui")):
             self.requires("ftxui/5.0.0")
+        if bool(self.options.get_safe("with_benchmark")):
+            self.requires("benchmark/1.8.3")
@@ -0,0 +1,114 @@
+#include "ethercat_sim/communication/dds_process_image_bridge.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fastdds/dds/core/ReturnCode.hpp>
+#include <fastdds/dds/domain/DomainParticipant.hpp>
+#include <fastdds/dds/domain/DomainParticipantFactory.hpp>
+#include <fastdds/dds/publisher/DataWriter.hpp>
+#include <fastdds/dds/publisher/Publisher.hpp>
+#include <fastdds/dds/topic/Topic.hpp>
+#include <fastdds/rtps/transport/shared_mem/SharedMemTransportDescriptor.hpp>
+
+#include "ethercat_sim/communication/dds_process_image.h"
+
+namespace ethercat_sim::communication
+{
+
+using namespace eprosima::fastdds::dds;
+
+ProcessImageBridge::ProcessImageBridge(std::string topic, int domain)
+    : type_(std::make_unique<TypeSupport>(new ProcessImageMsgPubSubType()))
+{
+    auto* factory                          = DomainParticipantFactory::get_instance();
+    DomainParticipantQos qos               = PARTICIPANT_QOS_DEFAULT;
+    qos.transport().use_builtin_transports = false;
+    qos.transport().user_transports.push_back(
+        std::make_shared<eprosima::fastdds::rtps::SharedMemTransportDescriptor>());
+    participant_ = factory->create_participant(domain, qos);
+    if (!participant_)
+    {
+        return;
+    }
+    type_->register_type(participant_);
+
+    topic_     = participant_->create_topic(topic, type_->get_type_name(), TOPIC_QOS_DEFAULT);
+    publisher_ = participant_->create_publisher(PUBLISHER_QOS_DEFAULT, nullptr);
+    if (!topic_ || !publisher_)
+    {
+        return;
+    }
+
+    DataWriterQos wqos      = DATAWRITER_QOS_DEFAULT;
+    wqos.history().kind     = KEEP_LAST_HISTORY_QOS;
+    wqos.history().depth    = 1;
+    wqos.reliability().kind = BEST_EFFORT_RELIABILITY_QOS;
+    wqos.durability().kind  = VOLATILE_DURABILITY_QOS;
+    wqos.data_sharing().automatic();
+    // Preallocated pool sized for loans in flight; never grows at cycle rate
+    wqos.endpoint().history_memory_policy =
+        eprosima::fastdds::rtps::PREALLOCATED_WITH_REALLOC_MEMORY_MODE;
+    wqos.resource_limits().max_samples              = 4;
+    wqos.resource_limits().allocated_samples        = 4;
+    wqos.resource_limits().max_samples_per_instance = 4;
+    writer_ = publisher_->create_datawriter(topic_, wqos, nullptr);
+}
+
+ProcessImageBridge::~ProcessImageBridge()
+{
+    if (participant_)
+    {
+        if (publisher_)
+        {
+            if (writer_)
+            {
+                publisher_->delete_datawriter(writer_);
+            }
+            participant_->delete_publisher(publisher_);
+        }
+        if (topic_)
+        {
+            participant_->delete_topic(topic_);
+        }
+        DomainParticipantFactory::get_instance()->delete_participant(participant_);
+    }
+}
+
+bool ProcessImageBridge::publish(std::uint8_t const* inputs, std::size_t input_size,
+                                 std::uint8_t const* outputs, std::size_t output_size)
+{
+    if (!writer_)
+    {
+        return false;
+    }
+    void* sample = nullptr;
+    if (writer_->loan_sample(sample) != RETCODE_OK)
+    {
+        return false;
+    }
+    auto* msg     = static_cast<ProcessImageMsg*>(sample);
+    msg->sequence = ++sequence_;
+    msg->stamp_ns = static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch())
+            .count());
+    msg->input_size  = static_cast<std::uint32_t>(std::min(input_size, PROCESS_IMAGE_MAX_BYTES));
+    msg->output_size = static_cast<std::uint32_t>(std::min(output_size, PROCESS_IMAGE_MAX_BYTES));
+    if (inputs && msg->input_size > 0)
+    {
+        std::memcpy(msg->inputs, inputs, msg->input_size);
+    }
+    if (outputs && msg->output_size > 0)
+    {
+        std::memcpy(msg->outputs, outputs, msg->output_size);
+    }
+    if (writer_->write(sample) != RETCODE_OK)
+    {
+        writer_->discard_loan(sample);
+        return false;
+    }
+    return true;
+}
+
+} // namespace ethercat_sim::communication
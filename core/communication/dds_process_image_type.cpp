@@ -0,0 +1,72 @@
+#include "ethercat_sim/communication/dds_process_image.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace ethercat_sim::communication
+{
+
+namespace
+{
+// Encapsulation(4) followed by the raw plain layout
+constexpr uint32_t kEncapsulationSize = 4;
+} // namespace
+
+ProcessImageMsgPubSubType::ProcessImageMsgPubSubType()
+{
+    set_name("ProcessImageMsg");
+    max_serialized_type_size = static_cast<uint32_t>(kEncapsulationSize + sizeof(ProcessImageMsg));
+    is_compute_key_provided  = false;
+}
+
+// Only used when the reader cannot share memory with the writer (e.g. another host): the plain
+// layout is copied verbatim behind a little-endian CDR encapsulation header.
+bool ProcessImageMsgPubSubType::serialize(
+    const void* const data, eprosima::fastdds::rtps::SerializedPayload_t& payload,
+    eprosima::fastdds::dds::DataRepresentationId_t /*representation*/)
+{
+    if (payload.max_size < max_serialized_type_size)
+    {
+        return false;
+    }
+    payload.encapsulation = CDR_LE;
+    payload.data[0]       = 0x00;
+    payload.data[1]       = CDR_LE;
+    payload.data[2]       = 0x00;
+    payload.data[3]       = 0x00;
+    std::memcpy(payload.data + kEncapsulationSize, data, sizeof(ProcessImageMsg));
+    payload.length = max_serialized_type_size;
+    return true;
+}
+
+bool ProcessImageMsgPubSubType::deserialize(eprosima::fastdds::rtps::SerializedPayload_t& payload,
+                                            void* data)
+{
+    if (payload.length < max_serialized_type_size)
+    {
+        return false;
+    }
+    auto* msg = static_cast<ProcessImageMsg*>(data);
+    std::memcpy(msg, payload.data + kEncapsulationSize, sizeof(ProcessImageMsg));
+    msg->input_size  = std::min<uint32_t>(msg->input_size, PROCESS_IMAGE_MAX_BYTES);
+    msg->output_size = std::min<uint32_t>(msg->output_size, PROCESS_IMAGE_MAX_BYTES);
+    return true;
+}
+
+uint32_t ProcessImageMsgPubSubType::calculate_serialized_size(
+    const void* const /*data*/, eprosima::fastdds::dds::DataRepresentationId_t /*representation*/)
+{
+    return max_serialized_type_size;
+}
+
+void* ProcessImageMsgPubSubType::create_data()
+{
+    return new ProcessImageMsg();
+}
+
+void ProcessImageMsgPubSubType::delete_data(void* data)
+{
+    delete static_cast<ProcessImageMsg*>(data);
+}
+
+} // namespace ethercat_sim::communication
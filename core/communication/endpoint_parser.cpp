@@ -65,12 +65,33 @@ bool EndpointParser::parseUdsEndpoint(const std::string& ep, std::string& path)
     return true;
 }
 
+bool EndpointParser::parseEthEndpoint(const std::string& ep, std::string& ifname)
+{
+    std::string_view v{ep};
+
+    // Check if it starts with eth://
+    if (v.rfind(ETH_PREFIX, 0) != 0)
+    {
+        return false;
+    }
+
+    // Remove eth:// prefix; interface names are 1..15 characters (IFNAMSIZ - 1)
+    v.remove_prefix(ETH_PREFIX.size());
+    if (v.empty() || v.size() > 15)
+    {
+        return false;
+    }
+    ifname.assign(v);
+    return true;
+}
+
 bool EndpointParser::isValidEndpoint(const std::string& ep)
 {
     std::string host, path;
     uint16_t port;
 
-    return parseTcpEndpoint(ep, host, port) || parseUdsEndpoint(ep, path);
+    return parseTcpEndpoint(ep, host, port) || parseUdsEndpoint(ep, path) ||
+           parseEthEndpoint(ep, path);
 }
 
 std::string EndpointParser::getEndpointType(const std::string& ep)
@@ -83,6 +104,10 @@ std::string EndpointParser::getEndpointType(const std::string& ep)
     {
         return "uds";
     }
+    else if (ep.rfind(ETH_PREFIX, 0) == 0)
+    {
+        return "eth";
+    }
     else
     {
         return "unknown";
@@ -0,0 +1,267 @@
+#include "ethercat_sim/communication/io_uring.h"
+
+#if HAVE_IO_URING
+
+#include <cerrno>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace ethercat_sim::communication
+{
+
+namespace
+{
+
+bool fail(std::string* error, char const* what, int err)
+{
+    if (error)
+    {
+        *error = std::string(what) + ": " + std::strerror(err);
+    }
+    return false;
+}
+
+int sysSetup(unsigned entries, io_uring_params* p)
+{
+    return static_cast<int>(::syscall(__NR_io_uring_setup, entries, p));
+}
+
+int sysEnter(int fd, unsigned to_submit, unsigned min_complete, unsigned flags, void const* arg,
+             std::size_t argsz)
+{
+    return static_cast<int>(
+        ::syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, arg, argsz));
+}
+
+int sysRegister(int fd, unsigned opcode, void const* arg, unsigned nr_args)
+{
+    return static_cast<int>(::syscall(__NR_io_uring_register, fd, opcode, arg, nr_args));
+}
+
+} // namespace
+
+IoUring::~IoUring()
+{
+    close();
+}
+
+bool IoUring::init(unsigned entries, bool cooperative, std::string* error)
+{
+    close();
+    io_uring_params p{};
+    p.flags = IORING_SETUP_SINGLE_ISSUER;
+    if (cooperative)
+    {
+        p.flags |= IORING_SETUP_COOP_TASKRUN;
+    }
+    int fd = sysSetup(entries, &p);
+    if (fd < 0 && errno == EINVAL)
+    {
+        p  = {};
+        fd = sysSetup(entries, &p); // older kernel: plain ring
+    }
+    if (fd < 0)
+    {
+        return fail(error, "io_uring_setup", errno);
+    }
+    ring_fd_ = fd;
+    if (!(p.features & IORING_FEAT_SINGLE_MMAP) || !(p.features & IORING_FEAT_EXT_ARG))
+    {
+        close();
+        return fail(error, "io_uring features", ENOTSUP);
+    }
+
+    std::size_t sq_bytes = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+    std::size_t cq_bytes = p.cq_off.cqes + p.cq_entries * sizeof(io_uring_cqe);
+    ring_bytes_          = sq_bytes > cq_bytes ? sq_bytes : cq_bytes;
+    ring_mem_            = ::mmap(nullptr, ring_bytes_, PROT_READ | PROT_WRITE,
+                                  MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQ_RING);
+    if (ring_mem_ == MAP_FAILED)
+    {
+        ring_mem_ = nullptr;
+        int err   = errno;
+        close();
+        return fail(error, "mmap(SQ/CQ ring)", err);
+    }
+    sqes_bytes_ = p.sq_entries * sizeof(io_uring_sqe);
+    void* sqes  = ::mmap(nullptr, sqes_bytes_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                         ring_fd_, IORING_OFF_SQES);
+    if (sqes == MAP_FAILED)
+    {
+        int err = errno;
+        close();
+        return fail(error, "mmap(SQEs)", err);
+    }
+    sqes_ = static_cast<io_uring_sqe*>(sqes);
+
+    auto* base     = static_cast<std::uint8_t*>(ring_mem_);
+    sq_head_       = reinterpret_cast<unsigned*>(base + p.sq_off.head);
+    sq_tail_       = reinterpret_cast<unsigned*>(base + p.sq_off.tail);
+    sq_array_      = reinterpret_cast<unsigned*>(base + p.sq_off.array);
+    sq_mask_       = *reinterpret_cast<unsigned*>(base + p.sq_off.ring_mask);
+    sq_entries_    = p.sq_entries;
+    sq_tail_local_ = *sq_tail_;
+    cq_head_       = reinterpret_cast<unsigned*>(base + p.cq_off.head);
+    cq_tail_       = reinterpret_cast<unsigned*>(base + p.cq_off.tail);
+    cqes_          = reinterpret_cast<io_uring_cqe*>(base + p.cq_off.cqes);
+    cq_mask_       = *reinterpret_cast<unsigned*>(base + p.cq_off.ring_mask);
+    // SQ slots map 1:1 onto SQEs, so the indirection array is filled once
+    for (unsigned i = 0; i < sq_entries_; ++i)
+    {
+        sq_array_[i] = i;
+    }
+    return true;
+}
+
+void IoUring::close() noexcept
+{
+    if (pbuf_ring_)
+    {
+        ::munmap(pbuf_ring_, pbuf_ring_bytes_);
+        pbuf_ring_ = nullptr;
+    }
+    std::free(pbuf_mem_);
+    pbuf_mem_ = nullptr;
+    if (sqes_)
+    {
+        ::munmap(sqes_, sqes_bytes_);
+        sqes_ = nullptr;
+    }
+    if (ring_mem_)
+    {
+        ::munmap(ring_mem_, ring_bytes_);
+        ring_mem_ = nullptr;
+    }
+    if (ring_fd_ >= 0)
+    {
+        ::close(ring_fd_);
+        ring_fd_ = -1;
+    }
+}
+
+io_uring_sqe* IoUring::getSqe() noexcept
+{
+    unsigned head = __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+    if (sq_tail_local_ - head >= sq_entries_)
+    {
+        return nullptr;
+    }
+    io_uring_sqe* sqe = &sqes_[sq_tail_local_ & sq_mask_];
+    std::memset(sqe, 0, sizeof(*sqe));
+    ++sq_tail_local_;
+    return sqe;
+}
+
+bool IoUring::submitAndWait(unsigned wait_nr, std::chrono::nanoseconds timeout)
+{
+    __atomic_store_n(sq_tail_, sq_tail_local_, __ATOMIC_RELEASE);
+    unsigned to_submit = sq_tail_local_ - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+    if (to_submit == 0 && wait_nr == 0)
+    {
+        return true;
+    }
+
+    __kernel_timespec ts{};
+    io_uring_getevents_arg arg{};
+    unsigned flags = 0;
+    if (wait_nr > 0)
+    {
+        flags |= IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG;
+        auto secs      = std::chrono::duration_cast<std::chrono::seconds>(timeout);
+        ts.tv_sec      = secs.count();
+        ts.tv_nsec     = (timeout - secs).count();
+        arg.sigmask_sz = _NSIG / 8;
+        arg.ts         = reinterpret_cast<std::uint64_t>(&ts);
+    }
+    while (true)
+    {
+        ++enter_calls_;
+        int rc = sysEnter(ring_fd_, to_submit, wait_nr, flags, wait_nr > 0 ? &arg : nullptr,
+                          wait_nr > 0 ? sizeof(arg) : 0);
+        if (rc < 0 && errno != EINTR)
+        {
+            // ETIME: the wait timed out. EAGAIN/EBUSY: CQ overflow back-pressure, the caller
+            // reaps completions and comes back.
+            return errno == ETIME || errno == EAGAIN || errno == EBUSY;
+        }
+        // The kernel returns without waiting when it takes only part of the queue, and a signal
+        // can interrupt either half; go again for whatever is left
+        unsigned left = sq_tail_local_ - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+        if (left == 0 ? rc >= 0 || wait_nr == 0 : rc == 0)
+        {
+            return true; // done, or the kernel took nothing and retrying would spin
+        }
+        to_submit = left;
+    }
+}
+
+bool IoUring::registerBuffers(iovec const* iov, unsigned count, std::string* error)
+{
+    if (sysRegister(ring_fd_, IORING_REGISTER_BUFFERS, iov, count) < 0)
+    {
+        return fail(error, "IORING_REGISTER_BUFFERS", errno);
+    }
+    return true;
+}
+
+bool IoUring::setupBufferRing(std::uint16_t group, unsigned count, unsigned buf_size,
+                              std::string* error)
+{
+    if (count == 0 || (count & (count - 1)) != 0 || count > 32768)
+    {
+        return fail(error, "setupBufferRing", EINVAL);
+    }
+    pbuf_ring_bytes_ = count * sizeof(io_uring_buf);
+    void* ring = ::mmap(nullptr, pbuf_ring_bytes_, PROT_READ | PROT_WRITE,
+                        MAP_PRIVATE | MAP_ANONYMOUS | MAP_POPULATE, -1, 0);
+    if (ring == MAP_FAILED)
+    {
+        return fail(error, "mmap(buffer ring)", errno);
+    }
+    pbuf_ring_ = static_cast<io_uring_buf_ring*>(ring);
+
+    void* mem = nullptr;
+    if (::posix_memalign(&mem, 4096, static_cast<std::size_t>(count) * buf_size) != 0)
+    {
+        return fail(error, "posix_memalign(buffers)", ENOMEM);
+    }
+    pbuf_mem_   = static_cast<std::uint8_t*>(mem);
+    pbuf_size_  = buf_size;
+    pbuf_mask_  = count - 1;
+    pbuf_group_ = group;
+    pbuf_tail_  = 0;
+
+    io_uring_buf_reg reg{};
+    reg.ring_addr    = reinterpret_cast<std::uint64_t>(pbuf_ring_);
+    reg.ring_entries = count;
+    reg.bgid         = group;
+    if (sysRegister(ring_fd_, IORING_REGISTER_PBUF_RING, &reg, 1) < 0)
+    {
+        return fail(error, "IORING_REGISTER_PBUF_RING", errno);
+    }
+    for (unsigned i = 0; i < count; ++i)
+    {
+        recycleBuffer(static_cast<std::uint16_t>(i));
+    }
+    return true;
+}
+
+void IoUring::recycleBuffer(std::uint16_t bid) noexcept
+{
+    // Index the entries from the ring base: in C++ the header's flexible-array wrapper puts
+    // `bufs` at offset 8 instead of 0 (the tail overlays the first entry's resv field)
+    io_uring_buf& b = reinterpret_cast<io_uring_buf*>(pbuf_ring_)[pbuf_tail_ & pbuf_mask_];
+    b.addr          = reinterpret_cast<std::uint64_t>(providedBuffer(bid));
+    b.len           = pbuf_size_;
+    b.bid           = bid;
+    ++pbuf_tail_;
+    __atomic_store_n(&pbuf_ring_->tail, pbuf_tail_, __ATOMIC_RELEASE);
+}
+
+} // namespace ethercat_sim::communication
+
+#endif // HAVE_IO_URING
@@ -0,0 +1,241 @@
+#include "ethercat_sim/communication/packet_ring.h"
+
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstring>
+#include <linux/if_packet.h>
+#include <net/ethernet.h>
+#include <net/if.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace ethercat_sim::communication
+{
+
+namespace
+{
+
+bool fail(std::string* error, char const* what)
+{
+    if (error)
+    {
+        *error = std::string(what) + ": " + std::strerror(errno);
+    }
+    return false;
+}
+
+tpacket2_hdr* slotHeader(std::uint8_t* ring, std::size_t slot)
+{
+    return reinterpret_cast<tpacket2_hdr*>(ring + slot * PacketRing::kFrameSlotSize);
+}
+
+bool slotReady(tpacket2_hdr const* hdr)
+{
+    return (__atomic_load_n(&hdr->tp_status, __ATOMIC_ACQUIRE) & TP_STATUS_USER) != 0;
+}
+
+void releaseSlot(tpacket2_hdr* hdr)
+{
+    __atomic_store_n(&hdr->tp_status, TP_STATUS_KERNEL, __ATOMIC_RELEASE);
+}
+
+} // namespace
+
+PacketRing::~PacketRing()
+{
+    close();
+}
+
+bool PacketRing::open(std::string const& ifname, std::uint16_t ethertype, std::string* error)
+{
+    close();
+    fd_ = ::socket(AF_PACKET, SOCK_RAW, htons(ethertype));
+    if (fd_ < 0)
+    {
+        return fail(error, "socket(AF_PACKET)");
+    }
+    ifindex_ = static_cast<int>(::if_nametoindex(ifname.c_str()));
+    if (ifindex_ == 0)
+    {
+        fail(error, "if_nametoindex");
+        close();
+        return false;
+    }
+
+    // TPACKET_V2: every slot carries its own status word, so a frame is visible as soon as the
+    // kernel wrote it (see the note in SlavesEndpoint about TPACKET_V3 block retirement).
+    int version = TPACKET_V2;
+    if (::setsockopt(fd_, SOL_PACKET, PACKET_VERSION, &version, sizeof(version)) < 0)
+    {
+        fail(error, "PACKET_VERSION");
+        close();
+        return false;
+    }
+    tpacket_req req{};
+    req.tp_block_size = kBlockSize;
+    req.tp_block_nr   = kBlockCount;
+    req.tp_frame_size = kFrameSlotSize;
+    req.tp_frame_nr   = static_cast<unsigned>(kBlockSize / kFrameSlotSize * kBlockCount);
+    if (::setsockopt(fd_, SOL_PACKET, PACKET_RX_RING, &req, sizeof(req)) < 0)
+    {
+        fail(error, "PACKET_RX_RING");
+        close();
+        return false;
+    }
+    ring_bytes_ = static_cast<std::size_t>(req.tp_block_size) * req.tp_block_nr;
+    void* mem   = ::mmap(nullptr, ring_bytes_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+    if (mem == MAP_FAILED)
+    {
+        ring_bytes_ = 0;
+        fail(error, "mmap(PACKET_RX_RING)");
+        close();
+        return false;
+    }
+    ring_       = static_cast<std::uint8_t*>(mem);
+    slot_count_ = req.tp_frame_nr;
+    next_slot_  = 0;
+
+#ifdef PACKET_IGNORE_OUTGOING
+    int one = 1;
+    (void) ::setsockopt(fd_, SOL_PACKET, PACKET_IGNORE_OUTGOING, &one, sizeof(one));
+#endif
+
+    sockaddr_ll sll{};
+    sll.sll_family   = AF_PACKET;
+    sll.sll_protocol = htons(ethertype);
+    sll.sll_ifindex  = ifindex_;
+    if (::bind(fd_, reinterpret_cast<sockaddr*>(&sll), sizeof(sll)) < 0)
+    {
+        fail(error, "bind(AF_PACKET)");
+        close();
+        return false;
+    }
+
+    // Masters address frames to broadcast or to arbitrary MACs; accept them all
+    packet_mreq mr{};
+    mr.mr_ifindex = ifindex_;
+    mr.mr_type    = PACKET_MR_PROMISC;
+    (void) ::setsockopt(fd_, SOL_PACKET, PACKET_ADD_MEMBERSHIP, &mr, sizeof(mr));
+    return true;
+}
+
+void PacketRing::close() noexcept
+{
+    if (ring_)
+    {
+        ::munmap(ring_, ring_bytes_);
+        ring_       = nullptr;
+        ring_bytes_ = 0;
+    }
+    if (fd_ >= 0)
+    {
+        ::close(fd_);
+        fd_ = -1;
+    }
+    slot_count_ = 0;
+    next_slot_  = 0;
+}
+
+int PacketRing::poll(FrameHandler const& handler, int timeout_ms)
+{
+    if (fd_ < 0)
+    {
+        return -1;
+    }
+    if (!slotReady(slotHeader(ring_, next_slot_)))
+    {
+        pollfd pfd{fd_, POLLIN, 0};
+        int pr = ::poll(&pfd, 1, timeout_ms);
+        if (pr < 0)
+        {
+            return errno == EINTR ? 0 : -1;
+        }
+        if (pr > 0 && (pfd.revents & (POLLERR | POLLNVAL)))
+        {
+            return -1;
+        }
+    }
+    int total = 0;
+    while (true)
+    {
+        int n = drainBatch_(handler);
+        if (n < 0)
+        {
+            return -1;
+        }
+        total += n;
+        if (n < static_cast<int>(kMaxBatch))
+        {
+            return total;
+        }
+    }
+}
+
+int PacketRing::drainBatch_(FrameHandler const& handler)
+{
+    tpacket2_hdr* taken[kMaxBatch];
+    mmsghdr msgs[kMaxBatch];
+    iovec iov[kMaxBatch];
+    std::size_t count   = 0;
+    std::size_t replies = 0;
+
+    while (count < kMaxBatch)
+    {
+        tpacket2_hdr* hdr = slotHeader(ring_, next_slot_);
+        if (!slotReady(hdr))
+        {
+            break;
+        }
+        taken[count++] = hdr;
+        next_slot_     = (next_slot_ + 1) % slot_count_;
+
+        auto const* sll =
+            reinterpret_cast<sockaddr_ll const*>(reinterpret_cast<std::uint8_t*>(hdr) +
+                                                 TPACKET_ALIGN(sizeof(tpacket2_hdr)));
+        if (sll->sll_pkttype == PACKET_OUTGOING || hdr->tp_snaplen != hdr->tp_len)
+        {
+            continue; // our own transmissions, or a frame truncated by the slot size
+        }
+        ++rx_frames_;
+        std::uint8_t* frame = reinterpret_cast<std::uint8_t*>(hdr) + hdr->tp_mac;
+        std::size_t len     = hdr->tp_snaplen;
+        std::size_t room    = kFrameSlotSize - hdr->tp_mac;
+        if (!handler(frame, len) || len == 0 || len > room)
+        {
+            continue;
+        }
+        iov[replies]                     = {frame, len};
+        msgs[replies]                    = {};
+        msgs[replies].msg_hdr.msg_iov    = &iov[replies];
+        msgs[replies].msg_hdr.msg_iovlen = 1;
+        ++replies;
+    }
+
+    // Replies go out straight from the ring slots; only then are the slots handed back
+    std::size_t sent = 0;
+    for (int attempt = 0; sent < replies && attempt < 100; ++attempt)
+    {
+        int n = ::sendmmsg(fd_, msgs + sent, static_cast<unsigned>(replies - sent), 0);
+        if (n < 0)
+        {
+            if (errno == EINTR || errno == EAGAIN || errno == ENOBUFS)
+            {
+                pollfd pfd{fd_, POLLOUT, 0};
+                (void) ::poll(&pfd, 1, 10);
+                continue;
+            }
+            break; // drop the rest of the batch, like a congested link would
+        }
+        sent += static_cast<std::size_t>(n);
+    }
+    tx_frames_ += sent;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        releaseSlot(taken[i]);
+    }
+    return static_cast<int>(count);
+}
+
+} // namespace ethercat_sim::communication
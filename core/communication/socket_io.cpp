@@ -0,0 +1,194 @@
+#include "ethercat_sim/communication/socket_io.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sched.h>
+#include <sys/socket.h>
+
+namespace ethercat_sim::communication
+{
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+constexpr int kStopCheckMs = 200;
+
+// Remaining wait for poll() in ms, bounded so the stop flag is honoured
+int pollTimeoutMs(Clock::time_point deadline, bool forever)
+{
+    if (forever)
+    {
+        return kStopCheckMs;
+    }
+    auto left = std::chrono::duration_cast<std::chrono::microseconds>(deadline - Clock::now());
+    if (left.count() <= 0)
+    {
+        return 0;
+    }
+    // Round up so short timeouts still sleep instead of spinning on poll(…, 0)
+    auto ms = (left.count() + 999) / 1000;
+    return static_cast<int>(std::min<std::int64_t>(ms, kStopCheckMs));
+}
+
+void countSyscall(IoPolicy const& policy)
+{
+    if (policy.stats)
+    {
+        policy.stats->syscalls.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+template <typename Op>
+bool transferExact(int fd, std::size_t len, short events, IoPolicy const& policy,
+                   std::chrono::nanoseconds timeout, std::atomic_bool const* stop, Op&& op)
+{
+    bool const forever = timeout == kIoWaitForever;
+    auto const start   = Clock::now();
+    auto const deadline =
+        forever ? Clock::time_point::max()
+                : start + std::chrono::duration_cast<Clock::duration>(timeout);
+    auto count = [&policy] { countSyscall(policy); };
+    std::size_t done = 0;
+    while (done < len)
+    {
+        count();
+        ssize_t n = op(done);
+        if (n > 0)
+        {
+            done += static_cast<std::size_t>(n);
+            continue;
+        }
+        if (n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR))
+        {
+            return false; // peer closed or hard error
+        }
+        if (stop && stop->load(std::memory_order_relaxed))
+        {
+            return false;
+        }
+        auto now = Clock::now();
+        if (!forever && now >= deadline)
+        {
+            return false;
+        }
+        if (policy.busy_poll && now - start < policy.spin_budget)
+        {
+            // Spin: retry the non-blocking call. Yielding keeps the spin cheap when the peer
+            // shares our CPU and returns immediately when nothing else is runnable.
+            count();
+            ::sched_yield();
+            continue;
+        }
+        pollfd pfd{fd, events, 0};
+        count();
+        int pr = ::poll(&pfd, 1, pollTimeoutMs(deadline, forever));
+        if (pr < 0 && errno != EINTR)
+        {
+            return false;
+        }
+        if (pr > 0 && (pfd.revents & (POLLERR | POLLNVAL)))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+bool configureSocket(int fd, IoPolicy const& policy)
+{
+    countSyscall(policy);
+    int flags = ::fcntl(fd, F_GETFL, 0);
+    if (flags < 0)
+    {
+        return false;
+    }
+    countSyscall(policy);
+    if (::fcntl(fd, F_SETFL, flags | O_NONBLOCK) < 0)
+    {
+        return false;
+    }
+    int domain     = 0;
+    socklen_t dlen = sizeof(domain);
+    countSyscall(policy);
+    if (::getsockopt(fd, SOL_SOCKET, SO_DOMAIN, &domain, &dlen) == 0 &&
+        (domain == AF_INET || domain == AF_INET6))
+    {
+        int one = 1;
+        countSyscall(policy);
+        (void) ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    }
+#ifdef SO_BUSY_POLL
+    if (policy.busy_poll && policy.so_busy_poll_us > 0)
+    {
+        int us = policy.so_busy_poll_us;
+        countSyscall(policy);
+        (void) ::setsockopt(fd, SOL_SOCKET, SO_BUSY_POLL, &us, sizeof(us));
+    }
+#endif
+    return true;
+}
+
+bool readExact(int fd, void* buf, std::size_t len, IoPolicy const& policy,
+               std::chrono::nanoseconds timeout, std::atomic_bool const* stop)
+{
+    auto* p = static_cast<std::uint8_t*>(buf);
+    return transferExact(fd, len, POLLIN, policy, timeout, stop,
+                         [&](std::size_t done)
+                         { return ::recv(fd, p + done, len - done, MSG_DONTWAIT); });
+}
+
+bool writeExact(int fd, void const* buf, std::size_t len, IoPolicy const& policy,
+                std::chrono::nanoseconds timeout, std::atomic_bool const* stop)
+{
+    auto const* p = static_cast<std::uint8_t const*>(buf);
+    return transferExact(fd, len, POLLOUT, policy, timeout, stop,
+                         [&](std::size_t done)
+                         { return ::send(fd, p + done, len - done, MSG_DONTWAIT | MSG_NOSIGNAL); });
+}
+
+bool writeVectored(int fd, iovec* iov, std::size_t count, IoPolicy const& policy,
+                   std::chrono::nanoseconds timeout, std::atomic_bool const* stop)
+{
+    std::size_t total = 0;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        total += iov[i].iov_len;
+    }
+    std::size_t first = 0; // first iovec with bytes left
+    auto sendSome     = [&](std::size_t /*done*/) -> ssize_t
+    {
+        msghdr msg{};
+        msg.msg_iov    = iov + first;
+        msg.msg_iovlen = count - first;
+        ssize_t n      = ::sendmsg(fd, &msg, MSG_DONTWAIT | MSG_NOSIGNAL);
+        if (n <= 0)
+        {
+            return n;
+        }
+        // Skip what the kernel accepted so a partial send resumes mid-iovec
+        auto left = static_cast<std::size_t>(n);
+        while (first < count && left >= iov[first].iov_len)
+        {
+            left -= iov[first].iov_len;
+            ++first;
+        }
+        if (first < count)
+        {
+            iov[first].iov_base = static_cast<std::uint8_t*>(iov[first].iov_base) + left;
+            iov[first].iov_len -= left;
+        }
+        return n;
+    };
+    return transferExact(fd, total, POLLOUT, policy, timeout, stop, sendSome);
+}
+
+} // namespace ethercat_sim::communication
@@ -0,0 +1,102 @@
+#include "ethercat_sim/communication/wire_protocol.h"
+
+#include <ctime>
+
+namespace ethercat_sim::communication::wire
+{
+
+namespace
+{
+
+void put16(std::uint8_t* p, std::uint16_t v) noexcept
+{
+    p[0] = static_cast<std::uint8_t>(v >> 8);
+    p[1] = static_cast<std::uint8_t>(v);
+}
+
+void put32(std::uint8_t* p, std::uint32_t v) noexcept
+{
+    put16(p, static_cast<std::uint16_t>(v >> 16));
+    put16(p + 2, static_cast<std::uint16_t>(v));
+}
+
+void put64(std::uint8_t* p, std::uint64_t v) noexcept
+{
+    put32(p, static_cast<std::uint32_t>(v >> 32));
+    put32(p + 4, static_cast<std::uint32_t>(v));
+}
+
+std::uint16_t get16(std::uint8_t const* p) noexcept
+{
+    return static_cast<std::uint16_t>((p[0] << 8) | p[1]);
+}
+
+std::uint32_t get32(std::uint8_t const* p) noexcept
+{
+    return (static_cast<std::uint32_t>(get16(p)) << 16) | get16(p + 2);
+}
+
+std::uint64_t get64(std::uint8_t const* p) noexcept
+{
+    return (static_cast<std::uint64_t>(get32(p)) << 32) | get32(p + 4);
+}
+
+} // namespace
+
+bool isV2(std::uint8_t const first[2]) noexcept
+{
+    return get16(first) == kMagic;
+}
+
+void encodeHeader(std::uint8_t* out, Prelude const& prelude, FrameDescriptor const* frames) noexcept
+{
+    put16(out, kMagic);
+    out[2] = kVersion;
+    out[3] = prelude.count;
+    put32(out + 4, prelude.seq);
+    std::uint8_t* d = out + kPreludeSize;
+    for (std::size_t i = 0; i < prelude.count; ++i, d += kDescriptorSize)
+    {
+        put16(d, frames[i].len);
+        put16(d + 2, frames[i].index);
+        put64(d + 4, frames[i].tx_ns);
+        put64(d + 12, frames[i].rx_ns);
+    }
+}
+
+bool decodePrelude(std::uint8_t const* in, Prelude& prelude) noexcept
+{
+    if (get16(in) != kMagic || in[2] != kVersion)
+    {
+        return false;
+    }
+    prelude.count = in[3];
+    prelude.seq   = get32(in + 4);
+    return prelude.count >= 1 && prelude.count <= kMaxFrames;
+}
+
+bool decodeDescriptors(std::uint8_t const* in, std::size_t count, FrameDescriptor* out) noexcept
+{
+    for (std::size_t i = 0; i < count; ++i, in += kDescriptorSize)
+    {
+        out[i].len   = get16(in);
+        out[i].index = get16(in + 2);
+        out[i].tx_ns = get64(in + 4);
+        out[i].rx_ns = get64(in + 12);
+        if (out[i].len == 0 || out[i].len > kMaxFrameSize)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::uint64_t nowNs() noexcept
+{
+    timespec ts{};
+    ::clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<std::uint64_t>(ts.tv_sec) * 1000000000ull +
+           static_cast<std::uint64_t>(ts.tv_nsec);
+}
+
+} // namespace ethercat_sim::communication::wire
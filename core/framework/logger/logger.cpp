@@ -11,6 +11,7 @@ std::string Logger::current_component_ = "default";
 std::ostream* Logger::output_stream_ = &std::cout;
 bool Logger::timestamp_enabled_ = true;
 std::mutex Logger::log_mutex_;
+std::atomic<void (*)(std::uint64_t)> Logger::timing_hook_{nullptr};
 
 void Logger::setLevel(LogLevel level)
 {
@@ -36,6 +37,11 @@ void Logger::setTimestampEnabled(bool enabled)
     timestamp_enabled_ = enabled;
 }
 
+void Logger::setTimingHook(void (*hook)(std::uint64_t ns))
+{
+    timing_hook_.store(hook, std::memory_order_release);
+}
+
 void Logger::debug(const std::string& message)
 {
     log(LogLevel::DEBUG, message);
@@ -64,6 +70,9 @@ void Logger::log(LogLevel level, const std::string& message)
         return;
     }
 
+    auto hook  = timing_hook_.load(std::memory_order_acquire);
+    auto start = hook ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point{};
+
     std::lock_guard<std::mutex> lock(log_mutex_);
 
     std::ostringstream oss;
@@ -87,6 +96,13 @@ void Logger::log(LogLevel level, const std::string& message)
     // Output to stream with consistent formatting
     *output_stream_ << oss.str() << "\n";
     output_stream_->flush();
+
+    if (hook)
+    {
+        hook(static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                            std::chrono::steady_clock::now() - start)
+                                            .count()));
+    }
 }
 
 std::string Logger::formatTimestamp()
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <atomic>
+#include <cstdint>
 #include <string>
 #include <mutex>
 #include <chrono>
@@ -26,6 +28,8 @@ public:
     static void setComponent(const std::string& component);
     static void setOutput(std::ostream& stream);
     static void setTimestampEnabled(bool enabled);
+    // Profiling hook: when set, receives the time spent emitting each log line (ns)
+    static void setTimingHook(void (*hook)(std::uint64_t ns));
 
     // Logging methods
     static void debug(const std::string& message);
@@ -88,6 +92,7 @@ private:
     static std::ostream* output_stream_;
     static bool timestamp_enabled_;
     static std::mutex log_mutex_;
+    static std::atomic<void (*)(std::uint64_t)> timing_hook_;
 };
 
 // Convenience macros for component-specific logging
@@ -0,0 +1,150 @@
+#include "ethercat_sim/framework/profiling/phase_profiler.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+
+#include "framework/logger/logger.h"
+
+namespace ethercat_sim::framework::profiling
+{
+
+namespace
+{
+
+// EtherCAT command codes as on the wire (see kickcat::Command)
+constexpr char const* kCommandNames[PhaseProfiler::kCommands] = {
+    "NOP", "APRD", "APWR", "APRW", "FPRD", "FPWR", "FPRW", "BRD",
+    "BWR", "BRW",  "LRD",  "LWR",  "LRW",  "ARMW", "FRMW", "other"};
+
+std::atomic<PhaseProfiler*> g_logger_profiler{nullptr};
+
+void recordLogLine(std::uint64_t ns)
+{
+    if (auto* p = g_logger_profiler.load(std::memory_order_acquire))
+    {
+        p->record(Phase::Logging, ns);
+    }
+}
+
+} // namespace
+
+std::uint64_t Log2Histogram::Snapshot::percentileNs(double p) const noexcept
+{
+    if (count == 0)
+    {
+        return 0;
+    }
+    auto const rank = static_cast<std::uint64_t>(p * static_cast<double>(count - 1)) + 1;
+    std::uint64_t seen = 0;
+    for (std::size_t b = 0; b < kBuckets; ++b)
+    {
+        seen += buckets[b];
+        if (seen >= rank)
+        {
+            std::uint64_t upper = b == 0 ? 0 : (b >= 64 ? ~0ull : (1ull << b) - 1);
+            return std::min(upper, max_ns);
+        }
+    }
+    return max_ns;
+}
+
+Log2Histogram::Snapshot Log2Histogram::snapshot() const noexcept
+{
+    Snapshot s;
+    for (std::size_t b = 0; b < kBuckets; ++b)
+    {
+        s.buckets[b] = buckets_[b].load(std::memory_order_relaxed);
+        s.count += s.buckets[b];
+    }
+    // Counters are read one by one while the writer runs: derive count from the buckets so the
+    // percentiles stay consistent
+    s.sum_ns = sum_ns_.load(std::memory_order_relaxed);
+    s.max_ns = max_ns_.load(std::memory_order_relaxed);
+    return s;
+}
+
+void Log2Histogram::reset() noexcept
+{
+    for (auto& b : buckets_)
+    {
+        b.store(0, std::memory_order_relaxed);
+    }
+    sum_ns_.store(0, std::memory_order_relaxed);
+    max_ns_.store(0, std::memory_order_relaxed);
+}
+
+char const* phaseName(Phase phase) noexcept
+{
+    switch (phase)
+    {
+    case Phase::SocketRead:
+        return "socket read";
+    case Phase::ProcessFrame:
+        return "process frame";
+    case Phase::SlaveRoutines:
+        return "slave routines";
+    case Phase::InputMapping:
+        return "input mapping";
+    case Phase::SocketWrite:
+        return "socket write";
+    case Phase::Logging:
+        return "logging";
+    default:
+        return "?";
+    }
+}
+
+void PhaseProfiler::reset() noexcept
+{
+    for (auto& h : phases_)
+    {
+        h.reset();
+    }
+    for (auto& d : datagrams_)
+    {
+        d.store(0, std::memory_order_relaxed);
+    }
+}
+
+void PhaseProfiler::attachLogger(PhaseProfiler* profiler) noexcept
+{
+    g_logger_profiler.store(profiler, std::memory_order_release);
+    logger::Logger::setTimingHook(profiler ? &recordLogLine : nullptr);
+}
+
+std::string PhaseProfiler::report() const
+{
+    std::string out;
+    char line[160];
+    std::snprintf(line, sizeof(line), "%-15s %10s %10s %10s %10s %10s %12s\n", "phase", "count",
+                  "mean_us", "p50_us", "p99_us", "max_us", "total_ms");
+    out += line;
+    for (std::size_t i = 0; i < kPhases; ++i)
+    {
+        auto const s = phases_[i].snapshot();
+        std::snprintf(line, sizeof(line), "%-15s %10" PRIu64 " %10.1f %10.1f %10.1f %10.1f %12.1f\n",
+                      phaseName(static_cast<Phase>(i)), s.count,
+                      static_cast<double>(s.meanNs()) / 1e3,
+                      static_cast<double>(s.percentileNs(0.50)) / 1e3,
+                      static_cast<double>(s.percentileNs(0.99)) / 1e3,
+                      static_cast<double>(s.max_ns) / 1e3, static_cast<double>(s.sum_ns) / 1e6);
+        out += line;
+    }
+    out += "datagrams:";
+    bool any = false;
+    for (std::size_t c = 0; c < kCommands; ++c)
+    {
+        auto n = datagrams_[c].load(std::memory_order_relaxed);
+        if (n)
+        {
+            std::snprintf(line, sizeof(line), " %s=%" PRIu64, kCommandNames[c], n);
+            out += line;
+            any = true;
+        }
+    }
+    out += any ? "\n" : " none\n";
+    return out;
+}
+
+} // namespace ethercat_sim::framework::profiling
@@ -1,6 +1,7 @@
 #include "ethercat_sim/kickcat/sim_socket.h"
 
 #include <algorithm>
+#include <cstring>
 
 #include "kickcat/Frame.h"
 #include "kickcat/protocol.h"
@@ -19,11 +20,22 @@ void SimSocket::open(std::string const& interface)
 void SimSocket::setTimeout(std::chrono::nanoseconds timeout)
 {
     timeout_ = timeout;
-    (void) timeout_; // currently unused in stub
 }
 
 void SimSocket::close() noexcept {}
 
+void SimSocket::setDirect(bool direct)
+{
+    direct_ = direct;
+    if (direct_ && slots_.empty())
+    {
+        slots_.resize(kDirectSlots);
+        slot_sizes_.assign(kDirectSlots, 0);
+    }
+    slot_head_ = 0;
+    slot_tail_ = 0;
+}
+
 int32_t SimSocket::write(uint8_t const* frame, int32_t frame_size)
 {
     if (!sim_)
@@ -36,10 +48,40 @@ int32_t SimSocket::write(uint8_t const* frame, int32_t frame_size)
     {
         return -1;
     }
+    if (frame_size <= 0 || frame_size > ::kickcat::ETH_MAX_SIZE)
+    {
+        return -1;
+    }
+
+    if (direct_)
+    {
+        if (slot_tail_ - slot_head_ == kDirectSlots)
+        {
+            return -1; // reader fell behind: behave like a full TX ring
+        }
+        std::size_t i       = slot_tail_ % kDirectSlots;
+        ::kickcat::Frame& f = slots_[i];
+        std::memcpy(f.data(), frame, static_cast<std::size_t>(frame_size));
+        f.resetContext();
+        processDatagrams_(f);
+        slot_sizes_[i] = frame_size;
+        ++slot_tail_;
+        return frame_size;
+    }
 
     // Build a KickCAT frame view to access datagrams and WKC pointers
     ::kickcat::Frame f(frame, frame_size);
+    processDatagrams_(f);
 
+    // Enqueue processed frame to the simulator receive queue
+    communication::EtherCATFrame tx;
+    tx.payload.assign(f.data(), f.data() + frame_size);
+    bool ok = sim_->sendFrame(tx);
+    return ok ? frame_size : -1;
+}
+
+void SimSocket::processDatagrams_(::kickcat::Frame& f)
+{
     while (true)
     {
         auto [hdr, data, wkc] = f.peekDatagram();
@@ -214,12 +256,6 @@ int32_t SimSocket::write(uint8_t const* frame, int32_t frame_size)
                 "SimSocket response cmd=%d ack=%u", static_cast<int>(hdr->command), ack);
         }
     }
-
-    // Enqueue processed frame to the simulator receive queue
-    communication::EtherCATFrame tx;
-    tx.payload.assign(f.data(), f.data() + frame_size);
-    bool ok = sim_->sendFrame(tx);
-    return ok ? frame_size : -1;
 }
 
 int32_t SimSocket::read(uint8_t* frame, int32_t frame_size)
@@ -228,11 +264,24 @@ int32_t SimSocket::read(uint8_t* frame, int32_t frame_size)
     {
         return -1;
     }
+    if (direct_)
+    {
+        if (slot_head_ == slot_tail_)
+        {
+            return 0; // nothing written: a zero-latency link has nothing in flight
+        }
+        std::size_t i = slot_head_ % kDirectSlots;
+        int32_t n     = std::min(slot_sizes_[i], frame_size);
+        std::memcpy(frame, slots_[i].data(), static_cast<std::size_t>(n));
+        ++slot_head_;
+        return n;
+    }
     communication::EtherCATFrame rx;
-    bool ok = sim_->receiveFrame(rx);
+    // Sleeps until a frame is deliverable (honouring the simulated latency) or timeout_ expires
+    bool ok = sim_->receiveFrame(rx, timeout_);
     if (!ok)
     {
-        return 0; // non-blocking stub: no data available
+        return 0; // timed out: no data available
     }
     int32_t n = static_cast<int32_t>(std::min(rx.payload.size(), static_cast<size_t>(frame_size)));
     std::copy(rx.payload.begin(), rx.payload.begin() + n, frame);
@@ -1,7 +1,9 @@
 #include "ethercat_sim/simulation/network_simulator.h"
 
+#include <algorithm>
 #include <chrono>
 #include <iostream>
+#include <unordered_map>
 
 #include "framework/logger/logger.h"
 
@@ -15,48 +17,141 @@ void NetworkSimulator::initialize(const std::string& config) noexcept
     ethercat_sim::framework::logger::Logger::info("NetworkSimulator initialized");
 }
 
+NetworkSimulator::~NetworkSimulator()
+{
+    // Slaves may outlive the simulator (shared with tests, UIs): stop them marking into dirty_
+    std::lock_guard<std::mutex> lock(mutex_);
+    detachSlavesNoLock(0);
+}
+
 int NetworkSimulator::runOnce() noexcept
 {
-    // Periodic processing: update logical memory from mapped inputs
+    // Event-driven processing: only slaves that changed or whose timer expired
     {
         std::lock_guard<std::mutex> lock(mutex_);
+        if (table_stale_.load(std::memory_order_relaxed))
+        {
+            publishStateTableNoLock();
+        }
+        due_.clear();
+        dirty_.drain(SlaveScheduler::Clock::now(), due_);
 
-        // Call routine() on all slaves (like the working KickCAT example)
-        for (auto& slave : slaves_)
         {
-            if (slave && slave->online())
+            framework::profiling::ScopedPhase routines(profiler_,
+                                                       framework::profiling::Phase::SlaveRoutines);
+            for (auto slot : due_)
             {
-                slave->routine();
+                VirtualSlave* slave = slot < slaves_.size() ? slaves_[slot].get() : nullptr;
+                if (slave && slave->online())
+                {
+                    slave->routine();
+                }
             }
         }
 
-        for (auto it = input_maps_.begin(); it != input_maps_.end();)
+        // Datagram counters of the frame, for the slaves whose routine did not just publish them
+        for (auto const& slave : counted_)
+        {
+            slave->publishCounts();
+        }
+        counted_.clear();
+
+        // Update logical memory from the mapped inputs of the due slaves
+        framework::profiling::ScopedPhase mapping(profiler_,
+                                                  framework::profiling::Phase::InputMapping);
+        for (auto slot : due_)
         {
-            if (auto s = it->slave.lock())
+            if (slot < maps_by_slot_.size())
             {
-                uint32_t bits = 0;
-                if (s->readDigitalInputsBitfield(bits))
+                for (auto id : maps_by_slot_[slot])
                 {
-                    for (std::size_t i = 0; i < it->width_bytes; ++i)
-                    {
-                        if ((it->logical_address + i) < logical_.size())
-                        {
-                            logical_[it->logical_address + i] =
-                                static_cast<uint8_t>((bits >> (8 * i)) & 0xFF);
-                        }
-                    }
+                    refreshInputMapNoLock(input_maps_[id]);
                 }
-                ++it;
-            }
-            else
-            {
-                it = input_maps_.erase(it);
             }
         }
+        for (auto id : unslotted_maps_)
+        {
+            refreshInputMapNoLock(input_maps_[id]);
+        }
     }
     return 0;
 }
 
+void NetworkSimulator::refreshInputMapNoLock(InputMap const& m) noexcept
+{
+    auto s = m.slave.lock();
+    uint32_t bits = 0;
+    if (!s || !s->readDigitalInputsBitfield(bits))
+    {
+        return;
+    }
+    for (std::size_t i = 0; i < m.width_bytes; ++i)
+    {
+        if ((m.logical_address + i) < logical_.size())
+        {
+            logical_[m.logical_address + i] = static_cast<uint8_t>((bits >> (8 * i)) & 0xFF);
+        }
+    }
+}
+
+void NetworkSimulator::attachSlaveNoLock(std::size_t slot) noexcept
+{
+    if (slaves_[slot])
+    {
+        slaves_[slot]->attachScheduler(&dirty_, slot); // also marks it due once
+    }
+}
+
+void NetworkSimulator::detachSlavesNoLock(std::size_t from) noexcept
+{
+    for (std::size_t i = from; i < slaves_.size(); ++i)
+    {
+        if (slaves_[i])
+        {
+            slaves_[i]->attachScheduler(nullptr, 0);
+        }
+    }
+}
+
+void NetworkSimulator::reindexInputMapsNoLock()
+{
+    // Drop mappings of destroyed slaves, then bucket the rest by registry slot
+    ranges_stale_ = true;
+    input_maps_.erase(std::remove_if(input_maps_.begin(), input_maps_.end(),
+                                     [](InputMap const& m) { return m.slave.expired(); }),
+                      input_maps_.end());
+    slot_of_.clear();
+    slot_of_.reserve(slaves_.size());
+    for (std::size_t i = 0; i < slaves_.size(); ++i)
+    {
+        if (slaves_[i])
+        {
+            slot_of_.emplace(slaves_[i].get(), i);
+        }
+    }
+    maps_by_slot_.assign(slaves_.size(), {});
+    unslotted_maps_.clear();
+    for (std::size_t id = 0; id < input_maps_.size(); ++id)
+    {
+        bucketInputMapNoLock(id);
+    }
+}
+
+void NetworkSimulator::bucketInputMapNoLock(std::size_t id)
+{
+    auto& m = input_maps_[id];
+    auto it = slot_of_.find(m.slave.lock().get());
+    m.slot  = it == slot_of_.end() ? kNoSlot : it->second;
+    if (m.slot == kNoSlot)
+    {
+        unslotted_maps_.push_back(id);
+    }
+    else
+    {
+        maps_by_slot_[m.slot].push_back(id);
+    }
+}
+
 void NetworkSimulator::setLinkUp(bool up) noexcept
 {
     linkUp_ = up;
@@ -65,7 +160,6 @@ void NetworkSimulator::setLinkUp(bool up) noexcept
 void NetworkSimulator::setLatencyMs(std::uint32_t ms) noexcept
 {
     latencyMs_ = ms;
-    (void) latencyMs_; // not used yet
 }
 
 void NetworkSimulator::setVirtualSlaveCount(std::size_t n) noexcept
@@ -77,19 +171,45 @@ void NetworkSimulator::setVirtualSlaveCount(std::size_t n) noexcept
         std::uint16_t next_addr =
             slaves_.empty() ? 1u : static_cast<std::uint16_t>(slaves_.back()->address() + 1u);
         slaves_.push_back(std::make_shared<VirtualSlave>(next_addr, 0, 0, "stub"));
+        attachSlaveNoLock(slaves_.size() - 1);
     }
-    while (slaves_.size() > n)
+    if (slaves_.size() > n)
     {
-        slaves_.pop_back();
+        detachSlavesNoLock(n);
+        slaves_.resize(n);
+        dirty_.truncate(n);
     }
     virtualSlaveCount_ = slaves_.size();
+    reindexInputMapsNoLock();
+    publishStateTableNoLock();
 }
 
 void NetworkSimulator::addVirtualSlave(std::shared_ptr<VirtualSlave> slave) noexcept
 {
     std::lock_guard<std::mutex> lock(mutex_);
+    // Registration is O(1): the new slot extends the input map index in place and the state
+    // table is republished once, by the next reader, runOnce() or startAllSlaves()
+    std::size_t const slot = slaves_.size();
     slaves_.push_back(std::move(slave));
     virtualSlaveCount_ = slaves_.size();
+    maps_by_slot_.emplace_back();
+    if (slaves_[slot])
+    {
+        slot_of_.emplace(slaves_[slot].get(), slot);
+        // Maps made before the slave was registered now belong to its slot
+        auto const owned = std::stable_partition(
+            unslotted_maps_.begin(), unslotted_maps_.end(), [&](std::size_t id) {
+                return input_maps_[id].slave.lock() != slaves_[slot];
+            });
+        for (auto it = owned; it != unslotted_maps_.end(); ++it)
+        {
+            input_maps_[*it].slot = slot;
+            maps_by_slot_[slot].push_back(*it);
+        }
+        unslotted_maps_.erase(owned, unslotted_maps_.end());
+    }
+    attachSlaveNoLock(slot);
+    table_stale_.store(true, std::memory_order_release);
 }
 
 void NetworkSimulator::startAllSlaves() noexcept
@@ -102,13 +222,22 @@ void NetworkSimulator::startAllSlaves() noexcept
             slave->start();
         }
     }
+    if (table_stale_.load(std::memory_order_relaxed))
+    {
+        publishStateTableNoLock();
+    }
 }
 
 void NetworkSimulator::clearSlaves() noexcept
 {
     std::lock_guard<std::mutex> lock(mutex_);
+    detachSlavesNoLock(0);
     slaves_.clear();
+    counted_.clear();
     virtualSlaveCount_ = 0;
+    dirty_.truncate(0);
+    reindexInputMapsNoLock();
+    publishStateTableNoLock();
 }
 
 std::size_t NetworkSimulator::onlineSlaveCount() const noexcept
@@ -140,31 +269,60 @@ bool NetworkSimulator::sendFrame(const communication::EtherCATFrame& frame) noex
     FrameItem item;
     item.frame    = frame;
     item.ready_at = now + std::chrono::milliseconds(latencyMs_);
-    std::lock_guard<std::mutex> lock(mutex_);
-    queue_.push_back(std::move(item));
+    {
+        std::lock_guard<std::mutex> lock(rx_mutex_);
+        queue_.push_back(std::move(item));
+    }
+    rx_cv_.notify_all();
     return true;
 }
 
 bool NetworkSimulator::receiveFrame(communication::EtherCATFrame& out) noexcept
 {
+    return receiveFrame(out, std::chrono::nanoseconds::zero());
+}
+
+bool NetworkSimulator::receiveFrame(communication::EtherCATFrame& out,
+                                    std::chrono::nanoseconds timeout) noexcept
+{
+    using clock = std::chrono::steady_clock;
     if (!linkUp_)
     {
         return false;
     }
-    auto now = std::chrono::steady_clock::now();
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (queue_.empty())
-    {
-        return false;
-    }
-    auto& item = queue_.front();
-    if (now < item.ready_at)
+    bool const forever = timeout < std::chrono::nanoseconds::zero();
+    auto const now     = clock::now();
+    // Clamp so now + timeout cannot overflow the clock's representation
+    auto const deadline =
+        forever || timeout > std::chrono::hours(24)
+            ? clock::time_point::max()
+            : now + std::chrono::duration_cast<clock::duration>(timeout);
+
+    std::unique_lock<std::mutex> lock(rx_mutex_);
+    while (true)
     {
-        return false;
+        auto t = clock::now();
+        if (!queue_.empty() && t >= queue_.front().ready_at)
+        {
+            out = std::move(queue_.front().frame);
+            queue_.pop_front();
+            return true;
+        }
+        if (!linkUp_ || t >= deadline)
+        {
+            return false;
+        }
+        // Wake on the next send, or exactly when the head frame's latency delay expires
+        auto wake = queue_.empty() ? deadline : std::min(deadline, queue_.front().ready_at);
+        if (wake == clock::time_point::max())
+        {
+            rx_cv_.wait_for(lock, std::chrono::milliseconds(200));
+        }
+        else
+        {
+            rx_cv_.wait_until(lock, wake);
+        }
     }
-    out = item.frame;
-    queue_.pop_front();
-    return true;
 }
 
 std::shared_ptr<VirtualSlave>
@@ -190,6 +348,44 @@ NetworkSimulator::getSlaveByIndexNoLock(std::size_t index) const noexcept
     return nullptr;
 }
 
+std::shared_ptr<SlaveStateTable const> NetworkSimulator::slaveStates() const noexcept
+{
+    if (table_stale_.load(std::memory_order_acquire))
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (table_stale_.load(std::memory_order_relaxed))
+        {
+            publishStateTableNoLock();
+        }
+    }
+    return std::atomic_load(&state_table_);
+}
+
+void NetworkSimulator::publishStateTableNoLock() const noexcept
+{
+    auto table = std::make_shared<SlaveStateTable>();
+    table->reserve(slaves_.size());
+    for (auto const& s : slaves_)
+    {
+        if (s)
+        {
+            table->push_back(s->publishedState());
+        }
+    }
+    std::shared_ptr<SlaveStateTable const> published = std::move(table);
+    std::atomic_store(&state_table_, std::move(published));
+    table_stale_.store(false, std::memory_order_release);
+}
+
+void NetworkSimulator::countDatagramNoLock(std::shared_ptr<VirtualSlave> const& slave,
+                                           bool acknowledged)
+{
+    if (slave->countDatagram(acknowledged))
+    {
+        counted_.push_back(slave);
+    }
+}
+
 bool NetworkSimulator::writeToSlave(std::uint16_t station_address, std::uint16_t reg,
                                     const std::uint8_t* data, std::size_t len) noexcept
 {
@@ -210,7 +406,9 @@ bool NetworkSimulator::writeToSlave(std::uint16_t station_address, std::uint16_t
             ethercat_sim::framework::logger::Logger::debug(
                 "direct write station=%d AL_CONTROL=0x%x len=%d", station_address, ctrl, len);
         }
-        return s->write(reg, data, len);
+        bool ok = s->write(reg, data, len);
+        countDatagramNoLock(s, ok);
+        return ok;
     }
     // If registry does not contain explicit slaves but virtualSlaveCount_ suggests presence,
     // accept write as no-op success for minimal compatibility.
@@ -222,12 +420,14 @@ bool NetworkSimulator::writeToSlave(std::uint16_t station_address, std::uint16_t
 }
 
 bool NetworkSimulator::readFromSlave(std::uint16_t station_address, std::uint16_t reg,
-                                     std::uint8_t* out, std::size_t len) const noexcept
+                                     std::uint8_t* out, std::size_t len) noexcept
 {
     std::lock_guard<std::mutex> lock(mutex_);
     if (auto s = getSlaveByStationAddressNoLock(station_address))
     {
-        return s->read(reg, out, len);
+        bool ok = s->read(reg, out, len);
+        countDatagramNoLock(s, ok);
+        return ok;
     }
     if (slaves_.empty() && station_address >= 1 && station_address <= virtualSlaveCount_)
     {
@@ -260,20 +460,26 @@ bool NetworkSimulator::writeToSlaveByIndex(std::size_t index, std::uint16_t reg,
                 ethercat_sim::framework::logger::Logger::debug("idx=%d AL_CONTROL=0x%x len=%d",
                                                                index, ctrl, len);
             }
-            return s->write(reg, data, len);
+            bool ok = s->write(reg, data, len);
+            countDatagramNoLock(s, ok);
+            return ok;
         }
     }
     return false;
 }
 
 bool NetworkSimulator::readFromSlaveByIndex(std::size_t index, std::uint16_t reg, std::uint8_t* out,
-                                            std::size_t len) const noexcept
+                                            std::size_t len) noexcept
 {
     std::lock_guard<std::mutex> lock(mutex_);
     if (auto s = getSlaveByIndexNoLock(index))
     {
         if (s->online())
-            return s->read(reg, out, len);
+        {
+            bool ok = s->read(reg, out, len);
+            countDatagramNoLock(s, ok);
+            return ok;
+        }
     }
     return false;
 }
@@ -282,33 +488,135 @@ bool NetworkSimulator::writeLogical(std::uint32_t logical_address, const std::ui
                                     std::size_t len) noexcept
 {
     std::lock_guard<std::mutex> lock(mutex_);
+    return writeLogicalNoLock(logical_address, data, len);
+}
+
+bool NetworkSimulator::readLogical(std::uint32_t logical_address, std::uint8_t* out,
+                                   std::size_t len) const noexcept
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return readLogicalNoLock(logical_address, out, len);
+}
+
+bool NetworkSimulator::readWriteLogical(std::uint32_t logical_address, std::uint8_t* data,
+                                        std::size_t len) noexcept
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return writeLogicalNoLock(logical_address, data, len) &&
+           readLogicalNoLock(logical_address, data, len);
+}
+
+bool NetworkSimulator::writeLogicalNoLock(std::uint32_t logical_address, const std::uint8_t* data,
+                                          std::size_t len) noexcept
+{
     if ((static_cast<std::size_t>(logical_address) + len) > logical_.size())
     {
         return false;
     }
-    std::copy(data, data + len, logical_.begin() + logical_address);
+    indexLogicalRangesNoLock();
+    // Bytes of digital input maps are read-only to the master, as behind an FMMU read mapping:
+    // copy only what lies between them. Overlaps come by descending start, so reversed they
+    // ascend in lo.
+    input_spans_.clear();
+    digital_ranges_.forEachOverlap(
+        logical_address, len, [&](LogicalRanges::Range const&, std::size_t lo, std::size_t hi) {
+            input_spans_.emplace_back(lo, hi);
+        });
+    std::reverse(input_spans_.begin(), input_spans_.end());
+    std::size_t pos = logical_address;
+    for (auto const& [lo, hi] : input_spans_)
+    {
+        if (lo > pos)
+        {
+            std::copy(data + (pos - logical_address), data + (lo - logical_address),
+                      logical_.begin() + pos);
+        }
+        pos = std::max(pos, hi);
+    }
+    std::copy(data + (pos - logical_address), data + len, logical_.begin() + pos);
+    output_ranges_.forEachOverlap(
+        logical_address, len, [&](LogicalRanges::Range const& r, std::size_t lo, std::size_t hi) {
+            if (auto s = process_maps_[r.map].slave.lock())
+            {
+                s->writeProcessOutputs(lo - r.begin, data + (lo - logical_address), hi - lo);
+            }
+        });
     return true;
 }
 
-bool NetworkSimulator::readLogical(std::uint32_t logical_address, std::uint8_t* out,
-                                   std::size_t len) const noexcept
+bool NetworkSimulator::readLogicalNoLock(std::uint32_t logical_address, std::uint8_t* out,
+                                         std::size_t len) const noexcept
 {
-    std::lock_guard<std::mutex> lock(mutex_);
     if ((static_cast<std::size_t>(logical_address) + len) > logical_.size())
     {
         return false;
     }
     std::copy(logical_.begin() + logical_address, logical_.begin() + logical_address + len, out);
+    indexLogicalRangesNoLock();
+    input_ranges_.forEachOverlap(
+        logical_address, len, [&](LogicalRanges::Range const& r, std::size_t lo, std::size_t hi) {
+            if (auto s = process_maps_[r.map].slave.lock())
+            {
+                s->readProcessInputs(lo - r.begin, out + (lo - logical_address), hi - lo);
+            }
+        });
     return true;
 }
 
+void NetworkSimulator::indexLogicalRangesNoLock() const
+{
+    if (!ranges_stale_)
+    {
+        return;
+    }
+    output_ranges_.clear();
+    input_ranges_.clear();
+    for (std::size_t i = 0; i < process_maps_.size(); ++i)
+    {
+        if (auto s = process_maps_[i].slave.lock())
+        {
+            output_ranges_.add(process_maps_[i].logical_outputs, s->outputsSize(), i);
+            input_ranges_.add(process_maps_[i].logical_inputs, s->inputsSize(), i);
+        }
+    }
+    digital_ranges_.clear();
+    for (std::size_t i = 0; i < input_maps_.size(); ++i)
+    {
+        digital_ranges_.add(input_maps_[i].logical_address, input_maps_[i].width_bytes, i);
+    }
+    output_ranges_.build();
+    input_ranges_.build();
+    digital_ranges_.build();
+    ranges_stale_ = false;
+}
+
 void NetworkSimulator::mapDigitalInputs(const std::shared_ptr<VirtualSlave>& slave,
                                         std::uint32_t logical_address,
                                         std::size_t width_bytes) noexcept
 {
     std::lock_guard<std::mutex> lock(mutex_);
     input_maps_.push_back(InputMap{slave, logical_address, width_bytes});
+    bucketInputMapNoLock(input_maps_.size() - 1);
+    ranges_stale_ = true;
     if (slave)
+    {
+        slave->setInputPDOMapped(true);
+        auto const slot = input_maps_.back().slot;
+        if (slot != kNoSlot)
+        {
+            dirty_.markDirty(slot); // fill the image on the next cycle
+        }
+    }
+}
+
+void NetworkSimulator::mapProcessData(const std::shared_ptr<VirtualSlave>& slave,
+                                      std::uint32_t logical_outputs,
+                                      std::uint32_t logical_inputs) noexcept
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    process_maps_.push_back(ProcessDataMap{slave, logical_outputs, logical_inputs});
+    ranges_stale_ = true;
+    if (slave && slave->inputsSize() > 0)
     {
         slave->setInputPDOMapped(true);
     }
@@ -324,7 +632,17 @@ void NetworkSimulator::clearInputMappings() noexcept
             s->setInputPDOMapped(false);
         }
     }
+    for (auto& m : process_maps_)
+    {
+        if (auto s = m.slave.lock())
+        {
+            s->setInputPDOMapped(false);
+        }
+    }
     input_maps_.clear();
+    process_maps_.clear();
+    ranges_stale_ = true;
+    reindexInputMapsNoLock();
 }
 
 } // namespace ethercat_sim::simulation
@@ -0,0 +1,152 @@
+#include "ethercat_sim/simulation/slave_scheduler.h"
+
+#include <algorithm>
+
+namespace ethercat_sim::simulation
+{
+
+DirtySlaveSet::DirtySlaveSet(std::chrono::nanoseconds tick) : wheel_(tick) {}
+
+void DirtySlaveSet::truncate(std::size_t slots)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (std::size_t i = slots; i < generations_.size(); ++i)
+    {
+        ++generations_[i];
+        if (periodic_[i] != TimerWheel::kNoTimer)
+        {
+            wheel_.cancel(periodic_[i]);
+            periodic_[i] = TimerWheel::kNoTimer;
+        }
+    }
+    if (flags_.size() > slots)
+    {
+        flags_.resize(slots);
+    }
+    dirty_.erase(std::remove_if(dirty_.begin(), dirty_.end(),
+                                [slots](std::size_t slot) { return slot >= slots; }),
+                 dirty_.end());
+}
+
+bool DirtySlaveSet::liveNoLock_(std::uint64_t key) const noexcept
+{
+    auto const slot       = static_cast<std::size_t>(key & 0xFFFFFFFFu);
+    auto const generation = static_cast<std::uint32_t>(key >> 32);
+    return slot < generations_.size() && generations_[slot] == generation;
+}
+
+void DirtySlaveSet::growNoLock_(std::size_t slot)
+{
+    if (slot >= flags_.size())
+    {
+        flags_.resize(slot + 1, 0);
+    }
+    if (slot >= generations_.size())
+    {
+        // Generations only grow, so a slot that is dropped and reused never revives old timers
+        generations_.resize(slot + 1, 0);
+        periodic_.resize(slot + 1, TimerWheel::kNoTimer);
+    }
+}
+
+void DirtySlaveSet::markNoLock_(std::size_t slot)
+{
+    growNoLock_(slot);
+    if (!flags_[slot])
+    {
+        flags_[slot] = 1;
+        dirty_.push_back(slot);
+    }
+}
+
+void DirtySlaveSet::markDirty(std::size_t slot) noexcept
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    markNoLock_(slot);
+}
+
+void DirtySlaveSet::wakeAt(std::size_t slot, Clock::time_point when) noexcept
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (when <= wheel_.now())
+    {
+        markNoLock_(slot);
+        return;
+    }
+    growNoLock_(slot);
+    auto const key = key_(slot, generations_[slot]);
+    wheel_.scheduleAt(when, [this, key] { fire_(key, nullptr); });
+}
+
+void DirtySlaveSet::callAt(std::size_t slot, Clock::time_point when, std::function<void()> fn)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    growNoLock_(slot);
+    auto const key = key_(slot, generations_[slot]);
+    wheel_.scheduleAt(when, [this, key, fn = std::move(fn)] { fire_(key, &fn); });
+}
+
+void DirtySlaveSet::setUpdatePeriod(std::size_t slot, std::chrono::nanoseconds period)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    growNoLock_(slot);
+    if (periodic_[slot] != TimerWheel::kNoTimer)
+    {
+        wheel_.cancel(periodic_[slot]);
+        periodic_[slot] = TimerWheel::kNoTimer;
+    }
+    if (period.count() > 0)
+    {
+        auto const key  = key_(slot, generations_[slot]);
+        periodic_[slot] = wheel_.scheduleEvery(period, [this, key] { fire_(key, nullptr); });
+    }
+}
+
+void DirtySlaveSet::fire_(std::uint64_t key, std::function<void()> const* fn)
+{
+    if (fn && *fn)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!liveNoLock_(key))
+            {
+                return;
+            }
+        }
+        (*fn)(); // unlocked: the function may arm further timers
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (liveNoLock_(key))
+    {
+        markNoLock_(static_cast<std::size_t>(key & 0xFFFFFFFFu));
+    }
+}
+
+void DirtySlaveSet::drain(Clock::time_point now, std::vector<std::size_t>& out)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        wheel_.expire(now, expired_);
+    }
+    for (auto& cb : expired_)
+    {
+        cb();
+    }
+    expired_.clear();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto slot : dirty_)
+    {
+        flags_[slot] = 0; // marks arriving from here on queue the slot again
+        out.push_back(slot);
+    }
+    dirty_.clear();
+}
+
+bool DirtySlaveSet::idle() const noexcept
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return dirty_.empty() && wheel_.pending() == 0;
+}
+
+} // namespace ethercat_sim::simulation
@@ -0,0 +1,241 @@
+#include "ethercat_sim/simulation/timer_wheel.h"
+
+#include <algorithm>
+
+namespace ethercat_sim::simulation
+{
+
+TimerWheel::TimerWheel(std::chrono::nanoseconds tick, Clock::time_point start)
+    : start_(start), tick_(tick.count() > 0 ? tick : kDefaultTick)
+{
+    heads_.fill(kNil);
+}
+
+std::uint64_t TimerWheel::ticksUntil_(Clock::time_point when) const noexcept
+{
+    if (when <= start_)
+    {
+        return 0;
+    }
+    auto const ns = std::chrono::duration_cast<std::chrono::nanoseconds>(when - start_).count();
+    return static_cast<std::uint64_t>((ns + tick_.count() - 1) / tick_.count()); // round up
+}
+
+std::uint64_t TimerWheel::ticksOf_(std::chrono::nanoseconds d) const noexcept
+{
+    auto const n = d.count() <= 0 ? 0 : (d.count() + tick_.count() - 1) / tick_.count();
+    return std::max<std::uint64_t>(1, static_cast<std::uint64_t>(n));
+}
+
+TimerWheel::TimerId TimerWheel::scheduleAt(Clock::time_point when, Callback cb)
+{
+    return add_(ticksUntil_(when), 0, std::move(cb));
+}
+
+TimerWheel::TimerId TimerWheel::scheduleAfter(std::chrono::nanoseconds delay, Callback cb)
+{
+    return scheduleAt(now() + delay, std::move(cb));
+}
+
+TimerWheel::TimerId TimerWheel::scheduleEvery(std::chrono::nanoseconds period, Callback cb)
+{
+    auto const ticks = ticksOf_(period);
+    return add_(now_tick_ + ticks, ticks, std::move(cb));
+}
+
+TimerWheel::TimerId TimerWheel::add_(std::uint64_t expiry, std::uint64_t period, Callback cb)
+{
+    std::uint32_t idx;
+    if (!free_.empty())
+    {
+        idx = free_.back();
+        free_.pop_back();
+    }
+    else
+    {
+        idx = static_cast<std::uint32_t>(nodes_.size());
+        nodes_.emplace_back();
+    }
+    Node& n  = nodes_[idx];
+    n.cb     = std::move(cb);
+    n.expiry = std::max(expiry, now_tick_ + 1); // the current tick has been processed already
+    n.period = period;
+    n.armed  = true;
+    file_(idx);
+    ++pending_;
+    return (static_cast<TimerId>(n.generation) << 32) | idx;
+}
+
+bool TimerWheel::cancel(TimerId id) noexcept
+{
+    auto const idx = static_cast<std::uint32_t>(id & 0xFFFFFFFFu);
+    auto const gen = static_cast<std::uint32_t>(id >> 32);
+    if (idx >= nodes_.size() || !nodes_[idx].armed || nodes_[idx].generation != gen)
+    {
+        return false;
+    }
+    unlink_(idx);
+    release_(idx);
+    return true;
+}
+
+void TimerWheel::file_(std::uint32_t idx) noexcept
+{
+    Node& n                   = nodes_[idx];
+    std::uint64_t const delta = n.expiry - now_tick_; // expiry >= now_tick_ here
+    std::size_t level         = 0;
+    while (level + 1 < kLevels && delta >= (std::uint64_t{1} << (kSlotBits * (level + 1))))
+    {
+        ++level;
+    }
+    // Beyond the last level: park in the farthest slot, re-filed when it cascades
+    std::uint64_t const horizon = (std::uint64_t{1} << (kSlotBits * kLevels)) - 1;
+    std::uint64_t const at      = delta > horizon ? now_tick_ + horizon : n.expiry;
+    std::size_t const slot      = (at >> (kSlotBits * level)) & (kSlots - 1);
+    std::size_t const bucket    = level * kSlots + slot;
+
+    n.bucket = static_cast<std::uint16_t>(bucket);
+    n.prev   = kNil;
+    n.next   = heads_[bucket];
+    if (n.next != kNil)
+    {
+        nodes_[n.next].prev = idx;
+    }
+    heads_[bucket] = idx;
+    occupied_[level] |= std::uint64_t{1} << slot;
+}
+
+void TimerWheel::unlink_(std::uint32_t idx) noexcept
+{
+    Node& n = nodes_[idx];
+    if (n.prev == kNil)
+    {
+        heads_[n.bucket] = n.next;
+    }
+    else
+    {
+        nodes_[n.prev].next = n.next;
+    }
+    if (n.next != kNil)
+    {
+        nodes_[n.next].prev = n.prev;
+    }
+    if (heads_[n.bucket] == kNil)
+    {
+        occupied_[n.bucket / kSlots] &= ~(std::uint64_t{1} << (n.bucket % kSlots));
+    }
+}
+
+void TimerWheel::release_(std::uint32_t idx) noexcept
+{
+    Node& n      = nodes_[idx];
+    n.cb         = nullptr;
+    n.armed      = false;
+    n.generation = n.generation + 1 == 0 ? 1 : n.generation + 1; // ids are never 0
+    free_.push_back(idx);
+    --pending_;
+}
+
+void TimerWheel::cascade_(std::size_t level) noexcept
+{
+    std::size_t const slot   = (now_tick_ >> (kSlotBits * level)) & (kSlots - 1);
+    std::size_t const bucket = level * kSlots + slot;
+    std::uint32_t idx        = heads_[bucket];
+    heads_[bucket]           = kNil;
+    occupied_[level] &= ~(std::uint64_t{1} << slot);
+    while (idx != kNil)
+    {
+        std::uint32_t const next = nodes_[idx].next;
+        file_(idx);
+        idx = next;
+    }
+}
+
+void TimerWheel::fireSlot_(std::vector<Callback>& due, std::size_t& fired)
+{
+    std::size_t const slot = now_tick_ & (kSlots - 1);
+    std::uint32_t idx      = heads_[slot];
+    heads_[slot]           = kNil;
+    occupied_[0] &= ~(std::uint64_t{1} << slot);
+    while (idx != kNil)
+    {
+        Node& n                  = nodes_[idx];
+        std::uint32_t const next = n.next;
+        if (n.period != 0)
+        {
+            due.push_back(n.cb);
+            n.expiry += n.period;
+            file_(idx);
+        }
+        else
+        {
+            due.push_back(std::move(n.cb));
+            release_(idx);
+        }
+        ++fired;
+        idx = next;
+    }
+}
+
+std::size_t TimerWheel::expire(Clock::time_point now, std::vector<Callback>& due)
+{
+    std::uint64_t target = 0;
+    if (now > start_)
+    {
+        target = static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(now - start_).count() /
+            tick_.count());
+    }
+    std::size_t fired = 0;
+    while (now_tick_ < target)
+    {
+        if (pending_ == 0)
+        {
+            now_tick_ = target;
+            break;
+        }
+        // With levels below L empty, nothing happens before level L next cascades
+        std::size_t empty = 0;
+        while (empty + 1 < kLevels && occupied_[empty] == 0)
+        {
+            ++empty;
+        }
+        std::uint64_t next = now_tick_ + 1;
+        if (empty > 0)
+        {
+            next = ((now_tick_ >> (kSlotBits * empty)) + 1) << (kSlotBits * empty);
+            if (next > target)
+            {
+                now_tick_ = target;
+                break;
+            }
+        }
+        now_tick_ = next;
+        for (std::size_t level = 1; level < kLevels; ++level)
+        {
+            if ((now_tick_ & ((std::uint64_t{1} << (kSlotBits * level)) - 1)) != 0)
+            {
+                break;
+            }
+            cascade_(level);
+        }
+        fireSlot_(due, fired);
+    }
+    return fired;
+}
+
+std::size_t TimerWheel::advanceTo(Clock::time_point now)
+{
+    std::vector<Callback> due;
+    auto const fired = expire(now, due);
+    for (auto& cb : due)
+    {
+        if (cb)
+        {
+            cb();
+        }
+    }
+    return fired;
+}
+
+} // namespace ethercat_sim::simulation
@@ -0,0 +1,216 @@
+#include "ethercat_sim/simulation/waveform_bank.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ethercat_sim::simulation
+{
+
+namespace
+{
+
+constexpr float kTwoPi           = 6.28318530718f;
+constexpr std::size_t kMinStride = 64;
+
+float fraction(double turns) noexcept
+{
+    return static_cast<float>(turns - std::floor(turns));
+}
+
+// One sample for every lane. Every generator runs for every lane and the weights select one:
+// no per-lane branch, so the loop compiles to straight-line SIMD. The arrays never overlap;
+// __restrict saves the compiler from proving it with run-time alias checks on ten streams,
+// which it gives up on.
+void generateRow(float* __restrict out, float* __restrict phase, std::uint32_t* __restrict rng,
+                 float const* __restrict offset, float const* __restrict amplitude,
+                 float const* __restrict increment, float const* __restrict sine_w,
+                 float const* __restrict ramp_w, float const* __restrict noise_w,
+                 std::size_t lanes) noexcept
+{
+    constexpr float kNoiseLsb = 1.0f / 2147483648.0f;
+    for (std::size_t i = 0; i < lanes; ++i)
+    {
+        float const p = phase[i];
+
+        // sin(2 pi p): fold p to y in [-1/4, 1/4] turns with sin(2 pi y) == sin(2 pi p), then
+        // a degree-9 Taylor polynomial (error < 4e-6 on that interval). Rounding goes through
+        // int truncation (p >= 0), which vectorizes where a compare or floorf would not.
+        float const x  = p - static_cast<float>(static_cast<int>(p + 0.5f));
+        float const y  = std::copysign(0.25f - std::fabs(std::fabs(x) - 0.25f), x);
+        float const z  = kTwoPi * y;
+        float const z2 = z * z;
+        float const s =
+            z * (1.0f + z2 * (-1.0f / 6.0f +
+                              z2 * (1.0f / 120.0f + z2 * (-1.0f / 5040.0f + z2 / 362880.0f))));
+
+        float const saw = 2.0f * p - 1.0f;
+
+        std::uint32_t r = rng[i]; // xorshift32
+        r ^= r << 13;
+        r ^= r >> 17;
+        r ^= r << 5;
+        rng[i]            = r;
+        float const noise = static_cast<float>(static_cast<std::int32_t>(r)) * kNoiseLsb;
+
+        out[i] = offset[i] + amplitude[i] * (sine_w[i] * s + ramp_w[i] * saw + noise_w[i] * noise);
+
+        float const next = p + increment[i];
+        phase[i]         = next - static_cast<float>(static_cast<int>(next));
+    }
+}
+
+} // namespace
+
+WaveformBank::WaveformBank(std::chrono::nanoseconds sample_period, std::size_t history,
+                           Clock::time_point start)
+    : start_(start), period_(sample_period.count() > 0 ? sample_period : kDefaultSamplePeriod),
+      rows_(std::max<std::size_t>(history, 1))
+{
+}
+
+WaveformBank::Lane WaveformBank::addLanes(std::size_t count)
+{
+    auto const first = static_cast<Lane>(lanes_);
+    reserveLanes_(lanes_ + count);
+    lanes_ += count;
+    offset_.resize(lanes_, 0.0f);
+    amplitude_.resize(lanes_, 0.0f);
+    phase_.resize(lanes_, 0.0f);
+    increment_.resize(lanes_, 0.0f);
+    sine_.resize(lanes_, 0.0f);
+    ramp_.resize(lanes_, 0.0f);
+    noise_.resize(lanes_, 0.0f);
+    rng_.resize(lanes_);
+    for (std::size_t lane = first; lane < lanes_; ++lane)
+    {
+        rng_[lane] = laneSeed_(static_cast<Lane>(lane));
+    }
+    return first;
+}
+
+void WaveformBank::reserveLanes_(std::size_t lanes)
+{
+    if (lanes <= stride_)
+    {
+        return;
+    }
+    // Rows are laid out stride_ apart; grow geometrically so that adding slaves one by one
+    // re-lays the history only a logarithmic number of times
+    std::size_t const stride = std::max({lanes, 2 * stride_, kMinStride});
+    std::vector<float> history(rows_ * stride, 0.0f);
+    for (std::size_t r = 0; r < rows_; ++r)
+    {
+        std::copy_n(history_.begin() + static_cast<std::ptrdiff_t>(r * stride_), lanes_,
+                    history.begin() + static_cast<std::ptrdiff_t>(r * stride));
+    }
+    history_.swap(history);
+    stride_ = stride;
+}
+
+void WaveformBank::setWaveform(Lane lane, Waveform const& waveform)
+{
+    if (lane >= lanes_)
+    {
+        return;
+    }
+    double const seconds = std::chrono::duration<double>(period_).count();
+    offset_[lane]        = waveform.offset;
+    amplitude_[lane]     = waveform.amplitude;
+    phase_[lane]         = fraction(waveform.phase);
+    increment_[lane]     = fraction(static_cast<double>(waveform.frequency) * seconds);
+    sine_[lane]          = waveform.shape == Shape::Sine ? 1.0f : 0.0f;
+    ramp_[lane]          = waveform.shape == Shape::Ramp ? 1.0f : 0.0f;
+    noise_[lane]         = waveform.shape == Shape::Noise ? 1.0f : 0.0f;
+    rng_[lane]           = waveform.seed != 0 ? waveform.seed : laneSeed_(lane); // 0 is a fixpoint
+
+    replays_.erase(std::remove_if(replays_.begin(), replays_.end(),
+                                  [lane](Replay const& r) { return r.lane == lane; }),
+                   replays_.end());
+    if (waveform.shape == Shape::Replay && waveform.recording && !waveform.recording->empty())
+    {
+        replays_.push_back(Replay{lane, waveform.recording, 0});
+    }
+}
+
+std::size_t WaveformBank::advanceTo(Clock::time_point now)
+{
+    if (now <= start_)
+    {
+        return 0;
+    }
+    auto const due = static_cast<std::uint64_t>((now - start_) / period_);
+    if (due <= samples_)
+    {
+        return 0;
+    }
+    std::uint64_t const count = due - samples_;
+    if (count > rows_)
+    {
+        skip_(count - rows_); // only the last rows_ samples stay observable
+    }
+    generate(static_cast<std::size_t>(std::min<std::uint64_t>(count, rows_)));
+    return static_cast<std::size_t>(count);
+}
+
+void WaveformBank::generate(std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        step_();
+    }
+}
+
+void WaveformBank::step_() noexcept
+{
+    head_ = head_ + 1 == rows_ ? 0 : head_ + 1;
+    ++samples_;
+
+    float* out = history_.data() + head_ * stride_;
+    generateRow(out, phase_.data(), rng_.data(), offset_.data(), amplitude_.data(),
+                increment_.data(), sine_.data(), ramp_.data(), noise_.data(), lanes_);
+
+    float const* offset    = offset_.data();
+    float const* amplitude = amplitude_.data();
+    for (auto& replay : replays_)
+    {
+        auto const& rec  = *replay.recording;
+        out[replay.lane] = offset[replay.lane] + amplitude[replay.lane] * rec[replay.position];
+        replay.position  = replay.position + 1 == rec.size() ? 0 : replay.position + 1;
+    }
+}
+
+void WaveformBank::skip_(std::uint64_t count) noexcept
+{
+    for (std::size_t i = 0; i < lanes_; ++i)
+    {
+        phase_[i] = fraction(static_cast<double>(phase_[i]) +
+                             static_cast<double>(increment_[i]) * static_cast<double>(count));
+    }
+    for (auto& replay : replays_)
+    {
+        replay.position = static_cast<std::size_t>(
+            (replay.position + count % replay.recording->size()) % replay.recording->size());
+    }
+    samples_ += count; // noise needs no catching up: any state is as good as another
+}
+
+float const* WaveformBank::row_(std::size_t age) const noexcept
+{
+    return history_.data() + ((head_ + rows_ - age % rows_) % rows_) * stride_;
+}
+
+float WaveformBank::latest(Lane lane) const noexcept
+{
+    return lane < lanes_ ? row_(0)[lane] : 0.0f;
+}
+
+void WaveformBank::recent(Lane lane, std::size_t n, float* out) const noexcept
+{
+    n = std::min(n, rows_);
+    for (std::size_t k = 0; k < n; ++k)
+    {
+        out[k] = lane < lanes_ ? row_(n - 1 - k)[lane] : 0.0f;
+    }
+}
+
+} // namespace ethercat_sim::simulation
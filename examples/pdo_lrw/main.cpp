@@ -18,6 +18,7 @@ int main()
     sim->setVirtualSlaveCount(1); // 하나의 가상 슬레이브
 
     auto nominal = std::make_shared<ethercat_sim::kickcat::SimSocket>(sim);
+    nominal->setDirect(true); // 단일 스레드 예제: 큐를 거치지 않는 직접 경로
     auto redun   = std::make_shared<::kickcat::SocketNull>();
     auto link    = std::make_shared<::kickcat::Link>(nominal, redun, [] {});
 
@@ -27,8 +27,36 @@ inline void signalHandler(int) noexcept
     }
 }
 
+inline std::atomic_bool*& signalDumpFlag() noexcept
+{
+    static std::atomic_bool* flag = nullptr;
+    return flag;
+}
+
+inline void dumpSignalHandler(int) noexcept
+{
+    if (auto* flag = signalDumpFlag())
+    {
+        flag->store(true);
+    }
+}
+
 } // namespace detail
 
+// SIGUSR1 sets dump_flag; the main loop prints its statistics and clears it
+inline void installDumpSignalHandler(std::atomic_bool& dump_flag) noexcept
+{
+    detail::signalDumpFlag() = &dump_flag;
+
+    struct sigaction sa
+    {
+    };
+    sa.sa_handler = detail::dumpSignalHandler;
+    sigemptyset(&sa.sa_mask);
+    sa.sa_flags = SA_RESTART;
+    sigaction(SIGUSR1, &sa, nullptr);
+}
+
 inline void installSignalHandlers(std::atomic_bool& stop_flag) noexcept
 {
     detail::signalStopFlag() = &stop_flag;
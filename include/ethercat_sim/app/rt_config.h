@@ -0,0 +1,187 @@
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <malloc.h>
+#include <pthread.h>
+#include <sched.h>
+#include <string>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace ethercat_sim::app
+{
+
+// Real-time settings for the cyclic threads (master cycle, slaves server loop).
+// All options are off by default; SCHED_FIFO and mlockall usually need CAP_SYS_NICE /
+// CAP_IPC_LOCK (or matching rlimits), so failures are reported and the app keeps running.
+struct RtConfig
+{
+    int priority{0};         // SCHED_FIFO priority (1..99), 0 keeps SCHED_OTHER
+    int cpu{-1};             // pin the cyclic thread to this CPU, -1 keeps the default mask
+    bool lock_memory{false}; // mlockall(MCL_CURRENT | MCL_FUTURE) and heap prefault
+    std::size_t prefault_heap{8u * 1024u * 1024u};
+
+    bool enabled() const noexcept
+    {
+        return priority > 0 || cpu >= 0 || lock_memory;
+    }
+};
+
+// Stack bytes touched by applyRtToCurrentThread() so the loop does not fault on first use
+inline constexpr std::size_t kRtPrefaultStackBytes = 256u * 1024u;
+
+namespace detail
+{
+// Whole-string decimal in [lo, hi]; anything else (empty, trailing garbage, overflow) fails
+inline bool parseIntIn(char const* text, long lo, long hi, int& out) noexcept
+{
+    char* end = nullptr;
+    errno     = 0;
+    long v    = std::strtol(text, &end, 10);
+    if (end == text || *end != '\0' || errno == ERANGE || v < lo || v > hi)
+    {
+        return false;
+    }
+    out = static_cast<int>(v);
+    return true;
+}
+} // namespace detail
+
+// Consumes --rt-prio N, --cpu N and --mlock at argv[i]; returns false for other arguments. A
+// consumed option with an invalid value leaves cfg unchanged and sets error (callers print it
+// with their usage and exit).
+inline bool parseRtOption(int argc, char** argv, int& i, RtConfig& cfg,
+                          std::string* error = nullptr)
+{
+    std::string a = argv[i];
+    auto invalid  = [&](char const* range)
+    {
+        if (error)
+        {
+            *error = a + ": expected " + range + ", got '" + argv[i] + "'";
+        }
+        return true;
+    };
+    if (a == "--rt-prio" && i + 1 < argc)
+    {
+        return detail::parseIntIn(argv[++i], 0, 99, cfg.priority) || invalid("0..99");
+    }
+    if (a == "--cpu" && i + 1 < argc)
+    {
+        long const cpus = std::min<long>(CPU_SETSIZE, ::sysconf(_SC_NPROCESSORS_CONF));
+        return detail::parseIntIn(argv[++i], 0, (cpus > 0 ? cpus : CPU_SETSIZE) - 1, cfg.cpu) ||
+               invalid("a configured CPU number");
+    }
+    if (a == "--mlock")
+    {
+        cfg.lock_memory = true;
+        return true;
+    }
+    return false;
+}
+
+inline char const* rtUsage() noexcept
+{
+    return "[--rt-prio N] [--cpu N] [--mlock]";
+}
+
+// Process-wide part: lock current and future pages and prefault a heap arena that glibc keeps
+// (no trimming, no mmap'd chunks), so later allocations in the loop do not page-fault.
+// Call once from main() before the cyclic threads start.
+inline bool lockProcessMemory(RtConfig const& cfg, std::string* error = nullptr)
+{
+    if (!cfg.lock_memory)
+    {
+        return true;
+    }
+    if (::mlockall(MCL_CURRENT | MCL_FUTURE) != 0)
+    {
+        if (error)
+        {
+            *error = std::string("mlockall: ") + std::strerror(errno);
+        }
+        return false;
+    }
+    ::mallopt(M_TRIM_THRESHOLD, -1);
+    ::mallopt(M_MMAP_MAX, 0);
+    if (cfg.prefault_heap > 0)
+    {
+        long page = ::sysconf(_SC_PAGESIZE);
+        auto* mem = static_cast<volatile unsigned char*>(std::malloc(cfg.prefault_heap));
+        if (mem)
+        {
+            for (std::size_t off = 0; off < cfg.prefault_heap;
+                 off += static_cast<std::size_t>(page > 0 ? page : 4096))
+            {
+                mem[off] = 0;
+            }
+            std::free(const_cast<unsigned char*>(mem));
+        }
+    }
+    return true;
+}
+
+namespace detail
+{
+__attribute__((noinline)) inline void prefaultStack() noexcept
+{
+    volatile unsigned char stack[kRtPrefaultStackBytes];
+    for (std::size_t off = 0; off < sizeof(stack); off += 4096)
+    {
+        stack[off] = 0;
+    }
+}
+} // namespace detail
+
+// Per-thread part: SCHED_FIFO priority, CPU affinity and stack prefault for the calling thread.
+inline bool applyRtToCurrentThread(RtConfig const& cfg, std::string* error = nullptr)
+{
+    bool ok   = true;
+    auto fail = [&](char const* what, int err)
+    {
+        ok = false;
+        if (error)
+        {
+            if (!error->empty())
+            {
+                *error += "; ";
+            }
+            *error += std::string(what) + ": " + std::strerror(err);
+        }
+    };
+
+    if (cfg.cpu >= CPU_SETSIZE)
+    {
+        fail("cpu", EINVAL); // CPU_SET is undefined past the set
+    }
+    else if (cfg.cpu >= 0)
+    {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cfg.cpu, &set);
+        if (int rc = ::pthread_setaffinity_np(::pthread_self(), sizeof(set), &set); rc != 0)
+        {
+            fail("pthread_setaffinity_np", rc);
+        }
+    }
+    if (cfg.priority > 0)
+    {
+        sched_param sp{};
+        sp.sched_priority = cfg.priority;
+        if (int rc = ::pthread_setschedparam(::pthread_self(), SCHED_FIFO, &sp); rc != 0)
+        {
+            fail("pthread_setschedparam(SCHED_FIFO)", rc);
+        }
+    }
+    if (cfg.lock_memory)
+    {
+        detail::prefaultStack();
+    }
+    return ok;
+}
+
+} // namespace ethercat_sim::app
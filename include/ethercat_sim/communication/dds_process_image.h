@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <fastdds/dds/topic/TopicDataType.hpp>
+#include <fastdds/dds/topic/TypeSupport.hpp>
+#include <fastdds/rtps/common/SerializedPayload.hpp>
+#include <new>
+
+namespace ethercat_sim::communication
+{
+
+// Upper bound for each process data section carried on the wire.
+inline constexpr std::size_t PROCESS_IMAGE_MAX_BYTES = 2048u;
+
+// Plain (fixed-size, no pointers) sample so Fast DDS can use data-sharing and loaned samples:
+// with a loan the writer fills shared memory directly and no serialization copy happens.
+struct ProcessImageMsg
+{
+    std::uint64_t sequence{0};
+    std::uint64_t stamp_ns{0}; // steady clock, publisher side
+    std::uint32_t input_size{0};
+    std::uint32_t output_size{0};
+    std::uint8_t inputs[PROCESS_IMAGE_MAX_BYTES]{};
+    std::uint8_t outputs[PROCESS_IMAGE_MAX_BYTES]{};
+};
+
+class ProcessImageMsgPubSubType : public eprosima::fastdds::dds::TopicDataType
+{
+  public:
+    ProcessImageMsgPubSubType();
+    bool serialize(const void* const data, eprosima::fastdds::rtps::SerializedPayload_t& payload,
+                   eprosima::fastdds::dds::DataRepresentationId_t representation) override;
+    bool deserialize(eprosima::fastdds::rtps::SerializedPayload_t& payload, void* data) override;
+    uint32_t calculate_serialized_size(
+        const void* const data,
+        eprosima::fastdds::dds::DataRepresentationId_t representation) override;
+    void* create_data() override;
+    void delete_data(void* data) override;
+    bool compute_key(eprosima::fastdds::rtps::SerializedPayload_t&,
+                     eprosima::fastdds::rtps::InstanceHandle_t&, bool) override
+    {
+        return false;
+    }
+    bool compute_key(const void* const, eprosima::fastdds::rtps::InstanceHandle_t&, bool) override
+    {
+        return false;
+    }
+
+    bool is_bounded() const override
+    {
+        return true;
+    }
+    bool is_plain(eprosima::fastdds::dds::DataRepresentationId_t) const override
+    {
+        return true;
+    }
+    bool construct_sample(void* memory) const override
+    {
+        new (memory) ProcessImageMsg();
+        return true;
+    }
+};
+
+} // namespace ethercat_sim::communication
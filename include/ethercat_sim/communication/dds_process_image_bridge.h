@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace eprosima::fastdds::dds
+{
+class DomainParticipant;
+class Publisher;
+class Topic;
+class DataWriter;
+class TypeSupport;
+} // namespace eprosima::fastdds::dds
+
+namespace ethercat_sim::communication
+{
+
+// Publishes master input/output images on a DDS topic at cycle rate.
+// The participant is SHM-only and the writer uses data-sharing with KEEP_LAST(1), best-effort
+// QoS, so local subscribers (soft-PLC, loggers) read the sample straight out of shared memory.
+// publish() loans a sample from the writer and fills it in place: no serialization copy.
+class ProcessImageBridge
+{
+  public:
+    explicit ProcessImageBridge(std::string topic = "ethercat_process_image", int domain = 0);
+    ~ProcessImageBridge();
+
+    ProcessImageBridge(ProcessImageBridge const&)            = delete;
+    ProcessImageBridge& operator=(ProcessImageBridge const&) = delete;
+
+    bool valid() const noexcept
+    {
+        return writer_ != nullptr;
+    }
+
+    // Sections larger than PROCESS_IMAGE_MAX_BYTES are truncated. Returns false when the loan or
+    // write failed (the sample is then dropped; the cycle must not wait for DDS).
+    bool publish(std::uint8_t const* inputs, std::size_t input_size, std::uint8_t const* outputs,
+                 std::size_t output_size);
+
+    std::uint64_t published() const noexcept
+    {
+        return sequence_;
+    }
+
+  private:
+    std::unique_ptr<eprosima::fastdds::dds::TypeSupport> type_;
+    eprosima::fastdds::dds::DomainParticipant* participant_{nullptr};
+    eprosima::fastdds::dds::Publisher* publisher_{nullptr};
+    eprosima::fastdds::dds::Topic* topic_{nullptr};
+    eprosima::fastdds::dds::DataWriter* writer_{nullptr};
+    std::uint64_t sequence_{0};
+};
+
+} // namespace ethercat_sim::communication
@@ -16,15 +16,19 @@ class EndpointParser
     // Parse UDS endpoint format: uds:///path/to/socket or uds://@abstract
     static bool parseUdsEndpoint(const std::string& ep, std::string& path);
 
+    // Parse raw Ethernet endpoint format: eth://ifname (e.g. eth://veth1)
+    static bool parseEthEndpoint(const std::string& ep, std::string& ifname);
+
     // Validate endpoint format
     static bool isValidEndpoint(const std::string& ep);
 
-    // Get endpoint type (tcp, uds, unknown)
+    // Get endpoint type (tcp, uds, eth, unknown)
     static std::string getEndpointType(const std::string& ep);
 
   private:
     static constexpr std::string_view TCP_PREFIX = "tcp://";
     static constexpr std::string_view UDS_PREFIX = "uds://";
+    static constexpr std::string_view ETH_PREFIX = "eth://";
 };
 
 } // namespace ethercat_sim::communication
\ No newline at end of file
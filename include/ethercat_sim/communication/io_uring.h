@@ -0,0 +1,125 @@
+#pragma once
+
+#if HAVE_IO_URING
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <linux/io_uring.h>
+#include <string>
+#include <sys/uio.h>
+
+namespace ethercat_sim::communication
+{
+
+// Minimal io_uring ring on top of the kernel ABI (no liburing dependency): one SQ/CQ pair,
+// registered (fixed) buffers and one provided-buffer ring for multishot receives.
+// Not thread-safe; owned by a single event-loop thread.
+class IoUring
+{
+  public:
+    IoUring() = default;
+    ~IoUring();
+    IoUring(IoUring const&)            = delete;
+    IoUring& operator=(IoUring const&) = delete;
+
+    // Sets up a ring with at least `entries` submission slots. Fails when the kernel lacks
+    // io_uring or a needed feature (single mmap, extended enter arguments).
+    // cooperative: completions are only reaped inside submitAndWait(), so the kernel need not
+    // interrupt the thread to post them (IORING_SETUP_COOP_TASKRUN). Leave it off when the caller
+    // spins on hasCompletions() without entering the kernel.
+    bool init(unsigned entries, bool cooperative, std::string* error = nullptr);
+    void close() noexcept;
+    bool isOpen() const noexcept
+    {
+        return ring_fd_ >= 0;
+    }
+
+    // Next free SQE (zeroed), or nullptr when the submission queue is full
+    io_uring_sqe* getSqe() noexcept;
+
+    // Submits queued SQEs and, when wait_nr > 0, waits up to timeout for that many completions.
+    // Returns false on a hard error; a timeout is not an error.
+    bool submitAndWait(unsigned wait_nr, std::chrono::nanoseconds timeout);
+    bool submit()
+    {
+        return submitAndWait(0, std::chrono::nanoseconds::zero());
+    }
+    bool hasPendingSubmissions() const noexcept
+    {
+        return sq_tail_local_ != __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+    }
+
+    // Calls fn(io_uring_cqe const&) for every ready completion and consumes them
+    template <typename Fn>
+    unsigned forEachCompletion(Fn&& fn)
+    {
+        unsigned head  = *cq_head_;
+        unsigned tail  = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+        unsigned count = 0;
+        for (; head != tail; ++head, ++count)
+        {
+            fn(cqes_[head & cq_mask_]);
+        }
+        __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+        return count;
+    }
+    bool hasCompletions() const noexcept
+    {
+        return *cq_head_ != __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+    }
+
+    // Registers iov[0..count) for IORING_OP_{READ,WRITE}_FIXED (buf_index = position)
+    bool registerBuffers(iovec const* iov, unsigned count, std::string* error = nullptr);
+
+    // Provides count buffers of buf_size bytes each, carved out of an internal allocation, to
+    // buffer group `group` for IOSQE_BUFFER_SELECT receives. count must be a power of two.
+    bool setupBufferRing(std::uint16_t group, unsigned count, unsigned buf_size,
+                         std::string* error = nullptr);
+    std::uint8_t* providedBuffer(std::uint16_t bid) const noexcept
+    {
+        return pbuf_mem_ + static_cast<std::size_t>(bid) * pbuf_size_;
+    }
+    // Hands a consumed provided buffer back to the kernel
+    void recycleBuffer(std::uint16_t bid) noexcept;
+
+    // io_uring_enter() calls made so far (the only syscall on the steady-state path)
+    std::uint64_t enterCalls() const noexcept
+    {
+        return enter_calls_;
+    }
+
+  private:
+    int ring_fd_{-1};
+    void* ring_mem_{nullptr};
+    std::size_t ring_bytes_{0};
+    io_uring_sqe* sqes_{nullptr};
+    std::size_t sqes_bytes_{0};
+
+    unsigned* sq_head_{nullptr};
+    unsigned* sq_tail_{nullptr};
+    unsigned* sq_array_{nullptr};
+    unsigned sq_mask_{0};
+    unsigned sq_entries_{0};
+    unsigned sq_tail_local_{0};
+
+    unsigned* cq_head_{nullptr};
+    unsigned* cq_tail_{nullptr};
+    io_uring_cqe* cqes_{nullptr};
+    unsigned cq_mask_{0};
+
+    io_uring_buf_ring* pbuf_ring_{nullptr};
+    std::size_t pbuf_ring_bytes_{0};
+    std::uint8_t* pbuf_mem_{nullptr};
+    unsigned pbuf_size_{0};
+    unsigned pbuf_mask_{0};
+    std::uint16_t pbuf_tail_{0};
+    std::uint16_t pbuf_group_{0};
+
+    std::uint64_t enter_calls_{0};
+};
+
+} // namespace ethercat_sim::communication
+
+#endif // HAVE_IO_URING
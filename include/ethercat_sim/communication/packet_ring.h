@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace ethercat_sim::communication
+{
+
+// AF_PACKET socket with a PACKET_MMAP receive ring, bound to one interface and EtherType.
+// Frames are handed to the caller in place inside the ring (no copy on receive); replies written
+// back into the same slot are sent with one sendmmsg() per batch straight from ring memory before
+// the slots are returned to the kernel. Needs CAP_NET_RAW.
+class PacketRing
+{
+  public:
+    // Called for each received frame; may rewrite frame[0..len) and len (up to the slot capacity).
+    // Return true to send the (rewritten) frame back out of the interface.
+    using FrameHandler = std::function<bool(std::uint8_t* frame, std::size_t& len)>;
+
+    static constexpr std::size_t kFrameSlotSize = 2048; // one slot: tpacket header + 1518-byte frame
+    static constexpr std::size_t kBlockSize     = 16384;
+    static constexpr std::size_t kBlockCount    = 32;
+    static constexpr std::size_t kMaxBatch      = 32;
+
+    PacketRing() = default;
+    ~PacketRing();
+    PacketRing(PacketRing const&)            = delete;
+    PacketRing& operator=(PacketRing const&) = delete;
+
+    // Opens the ring on ifname for frames of the given EtherType (host byte order) and puts the
+    // interface in promiscuous mode; frames sent by this socket are not looped back to it.
+    bool open(std::string const& ifname, std::uint16_t ethertype, std::string* error = nullptr);
+    void close() noexcept;
+    bool isOpen() const noexcept
+    {
+        return fd_ >= 0;
+    }
+
+    // Waits up to timeout_ms for frames, then drains every ready slot (in batches of kMaxBatch).
+    // Returns the number of frames handled, 0 on timeout, -1 on error.
+    int poll(FrameHandler const& handler, int timeout_ms);
+
+    std::uint64_t framesReceived() const noexcept
+    {
+        return rx_frames_;
+    }
+    std::uint64_t framesSent() const noexcept
+    {
+        return tx_frames_;
+    }
+
+  private:
+    int drainBatch_(FrameHandler const& handler);
+
+    int fd_{-1};
+    int ifindex_{0};
+    std::uint8_t* ring_{nullptr};
+    std::size_t ring_bytes_{0};
+    std::size_t slot_count_{0};
+    std::size_t next_slot_{0};
+    std::uint64_t rx_frames_{0};
+    std::uint64_t tx_frames_{0};
+};
+
+} // namespace ethercat_sim::communication
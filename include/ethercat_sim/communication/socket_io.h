@@ -0,0 +1,52 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <sys/uio.h>
+
+namespace ethercat_sim::communication
+{
+
+// How a stream endpoint waits for data.
+// - Default: sleep in poll() until the socket is ready (lowest CPU usage).
+// - busy_poll: spin on non-blocking recv()/send() for up to spin_budget before falling back to
+//   poll(), trading one core for wake-up latency; on sockets that support it (TCP/UDP over a NIC
+//   driver with NAPI) SO_BUSY_POLL additionally lets the kernel poll the device queue.
+struct IoStats
+{
+    std::atomic<std::uint64_t> syscalls{0};
+};
+
+struct IoPolicy
+{
+    bool busy_poll{false};
+    std::chrono::microseconds spin_budget{200};
+    int so_busy_poll_us{50};
+    IoStats* stats{nullptr}; // optional: counts the syscalls issued by the helpers below
+};
+
+inline constexpr auto kIoWaitForever = std::chrono::nanoseconds::max();
+
+// Switches fd to non-blocking mode (all helpers below rely on it), disables Nagle on TCP and
+// applies SO_BUSY_POLL when requested. SO_BUSY_POLL is best effort: AF_UNIX and unprivileged
+// callers simply skip it.
+bool configureSocket(int fd, IoPolicy const& policy);
+
+// Transfers exactly len bytes. Returns false on error, peer close, timeout or stop request; the
+// stop flag is checked at least every 200 ms while blocked.
+bool readExact(int fd, void* buf, std::size_t len, IoPolicy const& policy,
+               std::chrono::nanoseconds timeout = kIoWaitForever,
+               std::atomic_bool const* stop   = nullptr);
+bool writeExact(int fd, void const* buf, std::size_t len, IoPolicy const& policy,
+                std::chrono::nanoseconds timeout = kIoWaitForever,
+                std::atomic_bool const* stop   = nullptr);
+
+// Gathers iov[0..count) into as few sendmsg() calls as possible (one when the socket buffer has
+// room), so a header and its payloads leave as a single segment. iov is modified.
+bool writeVectored(int fd, iovec* iov, std::size_t count, IoPolicy const& policy,
+                   std::chrono::nanoseconds timeout = kIoWaitForever,
+                   std::atomic_bool const* stop   = nullptr);
+
+} // namespace ethercat_sim::communication
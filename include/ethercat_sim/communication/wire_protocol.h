@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ethercat_sim::communication::wire
+{
+
+// Master <-> slaves stream framing.
+//
+// v1: [len:u16][frame]            one frame per message, len <= 1500 (legacy limit)
+// v2: [magic:u16][ver:u8][count:u8][seq:u32]
+//     count x [len:u16][index:u16][tx_ns:u64][rx_ns:u64]
+//     count x frame bytes (concatenated, in descriptor order)
+//
+// All integers are big-endian. The v2 magic (0xECA2) is larger than any valid v1 length, so a
+// receiver tells the versions apart from the first two bytes of every message.
+// Timestamps are CLOCK_MONOTONIC nanoseconds, comparable between processes on the same host:
+// a request carries the master send time in tx_ns; the reply carries the slaves receive time in
+// rx_ns and the slaves send time in tx_ns.
+
+inline constexpr std::uint16_t kMagic          = 0xECA2;
+inline constexpr std::uint8_t kVersion         = 2;
+inline constexpr std::size_t kPreludeSize      = 8;
+inline constexpr std::size_t kDescriptorSize   = 20;
+inline constexpr std::size_t kMaxFrames        = 16;
+inline constexpr std::size_t kMaxFrameSize     = 1518; // Ethernet header + MTU + FCS
+inline constexpr std::uint16_t kMaxV1FrameSize = 1500;
+
+struct Prelude
+{
+    std::uint8_t count{0};
+    std::uint32_t seq{0};
+};
+
+struct FrameDescriptor
+{
+    std::uint16_t len{0};
+    std::uint16_t index{0};
+    std::uint64_t tx_ns{0};
+    std::uint64_t rx_ns{0};
+};
+
+inline constexpr std::size_t headerSize(std::size_t count) noexcept
+{
+    return kPreludeSize + count * kDescriptorSize;
+}
+
+// True when the first two bytes of a message start a v2 header
+bool isV2(std::uint8_t const first[2]) noexcept;
+
+// Writes prelude + descriptors into out (headerSize(count) bytes)
+void encodeHeader(std::uint8_t* out, Prelude const& prelude,
+                  FrameDescriptor const* frames) noexcept;
+
+// Parses the 8-byte prelude; rejects a bad magic/version or a frame count outside 1..kMaxFrames
+bool decodePrelude(std::uint8_t const* in, Prelude& prelude) noexcept;
+
+// Parses count descriptors; rejects frames that are empty or larger than kMaxFrameSize
+bool decodeDescriptors(std::uint8_t const* in, std::size_t count, FrameDescriptor* out) noexcept;
+
+// CLOCK_MONOTONIC in nanoseconds
+std::uint64_t nowNs() noexcept;
+
+} // namespace ethercat_sim::communication::wire
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+
+namespace ethercat_sim::framework::concurrency
+{
+
+// Single-writer sequence lock around a small trivially copyable record.
+// - The writer calls store(); it never waits, so it can sit on a hot path.
+// - Any number of readers call load()/tryLoad() and get a consistent copy; a reader that overlaps
+//   a store retries. Readers never block the writer.
+// The payload is kept in relaxed atomic words, so racing copies are well defined.
+template <typename T>
+class SeqLock
+{
+    static_assert(std::is_trivially_copyable_v<T>, "SeqLock payload must be trivially copyable");
+
+  public:
+    SeqLock() noexcept
+    {
+        store(T{});
+    }
+    explicit SeqLock(T const& initial) noexcept
+    {
+        store(initial);
+    }
+
+    SeqLock(SeqLock const&)            = delete;
+    SeqLock& operator=(SeqLock const&) = delete;
+
+    // Writer side (one thread at a time)
+    void store(T const& value) noexcept
+    {
+        std::array<std::uint64_t, kWords> words{};
+        // via void*: T may have default member initializers, which -Wclass-memaccess flags even
+        // though the static_assert above makes the copy well defined
+        std::memcpy(words.data(), static_cast<void const*>(&value), sizeof(T));
+        auto const seq = seq_.load(std::memory_order_relaxed);
+        seq_.store(seq + 1, std::memory_order_relaxed); // odd: write in progress
+        std::atomic_thread_fence(std::memory_order_release);
+        for (std::size_t i = 0; i < kWords; ++i)
+        {
+            data_[i].store(words[i], std::memory_order_relaxed);
+        }
+        seq_.store(seq + 2, std::memory_order_release);
+    }
+
+    // Reader side: false when a store overlapped the copy (out is then unspecified)
+    bool tryLoad(T& out) const noexcept
+    {
+        auto const before = seq_.load(std::memory_order_acquire);
+        if (before & 1u)
+        {
+            return false;
+        }
+        std::array<std::uint64_t, kWords> words;
+        for (std::size_t i = 0; i < kWords; ++i)
+        {
+            words[i] = data_[i].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (seq_.load(std::memory_order_relaxed) != before)
+        {
+            return false;
+        }
+        std::memcpy(static_cast<void*>(&out), words.data(), sizeof(T));
+        return true;
+    }
+
+    T load() const noexcept
+    {
+        T out{};
+        for (unsigned spins = 0; !tryLoad(out); ++spins)
+        {
+            if (spins >= 64)
+            {
+                std::this_thread::yield(); // writer preempted mid-store
+            }
+        }
+        return out;
+    }
+
+    // Number of completed stores so far
+    std::uint64_t version() const noexcept
+    {
+        return seq_.load(std::memory_order_acquire) / 2;
+    }
+
+  private:
+    static constexpr std::size_t kWords = (sizeof(T) + sizeof(std::uint64_t) - 1) /
+                                          sizeof(std::uint64_t);
+
+    std::atomic<std::uint64_t> seq_{0};
+    std::array<std::atomic<std::uint64_t>, kWords> data_{};
+};
+
+} // namespace ethercat_sim::framework::concurrency
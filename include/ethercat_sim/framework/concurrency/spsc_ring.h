@@ -0,0 +1,119 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+
+namespace ethercat_sim::framework::concurrency
+{
+
+// Bounded lock-free single-producer/single-consumer FIFO.
+// Capacity must be a power of two; one producer thread calls tryPush(), one consumer thread calls
+// tryPop(). Head and tail live on separate cache lines so the two sides do not false-share.
+template <typename T, std::size_t Capacity>
+class SpscRing
+{
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                  "SpscRing capacity must be a power of two");
+
+  public:
+    bool tryPush(T const& value) noexcept
+    {
+        std::size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - head_cache_ == Capacity)
+        {
+            head_cache_ = head_.load(std::memory_order_acquire);
+            if (tail - head_cache_ == Capacity)
+            {
+                return false;
+            }
+        }
+        slots_[tail & (Capacity - 1)] = value;
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool tryPop(T& out) noexcept
+    {
+        std::size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tail_cache_)
+        {
+            tail_cache_ = tail_.load(std::memory_order_acquire);
+            if (head == tail_cache_)
+            {
+                return false;
+            }
+        }
+        out = slots_[head & (Capacity - 1)];
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Approximate from any thread; exact from the consumer for "is there something to pop"
+    bool empty() const noexcept
+    {
+        return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+    }
+
+    // Approximate from any thread; exact from the consumer for "how much is left after this pop"
+    std::size_t size() const noexcept
+    {
+        return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+    }
+
+    static constexpr std::size_t capacity() noexcept
+    {
+        return Capacity;
+    }
+
+  private:
+    static constexpr std::size_t kLine = 64;
+
+    alignas(kLine) std::atomic<std::size_t> head_{0}; // consumer
+    std::size_t tail_cache_{0};                       // consumer's view of tail_
+    alignas(kLine) std::atomic<std::size_t> tail_{0}; // producer
+    std::size_t head_cache_{0};                       // producer's view of head_
+    alignas(kLine) std::array<T, Capacity> slots_{};
+};
+
+// Sleep/wake helper for a consumer that ran out of work on a lock-free queue.
+// The producer calls ring() after publishing; it only touches the mutex when a consumer is
+// actually asleep, so the hot path stays lock-free. Waits are always bounded so callers can
+// re-check their stop conditions.
+class Doorbell
+{
+  public:
+    void ring()
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (sleepers_.load(std::memory_order_relaxed) > 0)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+            }
+            cv_.notify_one();
+        }
+    }
+
+    // Blocks until ready() holds or the timeout expires; returns ready()
+    template <typename Pred>
+    bool wait(Pred ready, std::chrono::nanoseconds timeout)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        sleepers_.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        bool ok = cv_.wait_for(lock, timeout, ready);
+        sleepers_.fetch_sub(1, std::memory_order_relaxed);
+        return ok;
+    }
+
+  private:
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::atomic<int> sleepers_{0};
+};
+
+} // namespace ethercat_sim::framework::concurrency
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace ethercat_sim::framework::concurrency
+{
+
+// Single-producer/single-consumer triple buffer of raw bytes (size chosen at runtime).
+// - The producer fills writeBuffer() and calls publish(); it never waits for the consumer.
+// - The consumer calls update() to pick up the most recent published buffer and reads it through
+//   readBuffer(); intermediate values are skipped, never torn.
+// resize() is not thread-safe and must be called before the buffer is shared.
+class TripleBuffer
+{
+  public:
+    TripleBuffer() = default;
+    explicit TripleBuffer(std::size_t bytes)
+    {
+        resize(bytes);
+    }
+
+    TripleBuffer(TripleBuffer const&)            = delete;
+    TripleBuffer& operator=(TripleBuffer const&) = delete;
+
+    void resize(std::size_t bytes)
+    {
+        size_   = bytes;
+        stride_ = (bytes + kAlign - 1) / kAlign * kAlign;
+        storage_.assign(stride_ * 3 + kAlign, 0);
+        back_  = 0;
+        front_ = 1;
+        middle_.store(2, std::memory_order_relaxed);
+    }
+
+    std::size_t size() const noexcept
+    {
+        return size_;
+    }
+
+    // Producer side
+    std::uint8_t* writeBuffer() noexcept
+    {
+        return slot_(back_);
+    }
+
+    void publish() noexcept
+    {
+        back_ = middle_.exchange(back_ | kFresh, std::memory_order_acq_rel) & kIndexMask;
+    }
+
+    // Publishes and seeds the next write buffer with the published bytes, so a producer that only
+    // touches part of the image keeps the rest of it.
+    void publishKeep() noexcept
+    {
+        std::uint8_t const* published = slot_(back_);
+        publish();
+        std::memcpy(slot_(back_), published, size_);
+    }
+
+    // Producer side: true once the consumer has taken the last published buffer (or nothing was
+    // published yet), i.e. publishing now cannot overwrite data it has not seen
+    bool consumed() const noexcept
+    {
+        return (middle_.load(std::memory_order_acquire) & kFresh) == 0;
+    }
+
+    // Consumer side: returns true when a newer buffer was taken
+    bool update() noexcept
+    {
+        if ((middle_.load(std::memory_order_relaxed) & kFresh) == 0)
+        {
+            return false;
+        }
+        front_ = middle_.exchange(front_, std::memory_order_acq_rel) & kIndexMask;
+        return true;
+    }
+
+    std::uint8_t const* readBuffer() const noexcept
+    {
+        return slot_(front_);
+    }
+
+  private:
+    static constexpr std::size_t kAlign      = 64; // keep slots on separate cache lines
+    static constexpr std::uint8_t kFresh     = 0x4;
+    static constexpr std::uint8_t kIndexMask = 0x3;
+
+    std::uint8_t* slot_(std::uint8_t index) const noexcept
+    {
+        auto base = reinterpret_cast<std::uintptr_t>(storage_.data());
+        base      = (base + kAlign - 1) & ~(std::uintptr_t{kAlign} - 1);
+        return reinterpret_cast<std::uint8_t*>(base) + index * stride_;
+    }
+
+    std::vector<std::uint8_t> storage_;
+    std::size_t size_{0};
+    std::size_t stride_{0};
+    std::uint8_t back_{0};  // producer-owned
+    std::uint8_t front_{1}; // consumer-owned
+    alignas(kAlign) std::atomic<std::uint8_t> middle_{2};
+};
+
+} // namespace ethercat_sim::framework::concurrency
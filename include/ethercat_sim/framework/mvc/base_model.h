@@ -1,49 +1,16 @@
 #pragma once
 
-#include <functional>
-#include <memory>
 #include <mutex>
-#include <vector>
 
-namespace ethercat_sim::framework
-{
+#include "ethercat_sim/framework/mvc/cow_observable.h"
 
-// Observer pattern for model updates
-template <typename T> class Observable
+namespace ethercat_sim::framework
 {
-  public:
-    using Observer = std::function<void(const T&)>;
-
-    void addObserver(Observer observer)
-    {
-        std::lock_guard<std::mutex> lock(mutex_);
-        observers_.push_back(std::move(observer));
-    }
-
-    void removeObserver(const Observer& observer)
-    {
-        std::lock_guard<std::mutex> lock(mutex_);
-        observers_.erase(std::remove(observers_.begin(), observers_.end(), observer),
-                         observers_.end());
-    }
-
-  protected:
-    void notifyObservers(const T& data)
-    {
-        std::lock_guard<std::mutex> lock(mutex_);
-        for (const auto& observer : observers_)
-        {
-            observer(data);
-        }
-    }
-
-  private:
-    mutable std::mutex mutex_;
-    std::vector<Observer> observers_;
-};
 
-// Base model class with thread-safe data access
-template <typename DataType> class BaseModel : public Observable<DataType>
+// Base model class with thread-safe data access. Observers are notified through a
+// CowObservable: synchronous ones run on the updating thread, async ones (addAsyncObserver(),
+// e.g. for a UI) never hold an update up, and observers may subscribe from their callback.
+template <typename DataType> class BaseModel : public CowObservable<DataType>
 {
   public:
     using Data = DataType;
@@ -62,7 +29,7 @@ template <typename DataType> class BaseModel : public Observable<DataType>
             std::lock_guard<std::mutex> lock(mutex_);
             data_ = newData;
         }
-        this->notifyObservers(data_);
+        this->notifyObservers(newData);
     }
 
     // Update data without notifying observers
@@ -0,0 +1,289 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace ethercat_sim::framework
+{
+
+// Observer pattern variant for real-time publishers.
+// - The observer list is an immutable vector swapped on subscribe/unsubscribe. notifyObservers()
+//   copies the current list and runs the callbacks without holding any lock, so observers may
+//   (un)subscribe from inside a callback and a slow callback never holds up a subscriber. The
+//   copy itself is std::atomic_load on a shared_ptr, which libstdc++ guards with a mutex from a
+//   small internal pool; that lock covers the pointer copy only.
+// - Async observers are fed through a bounded queue drained by their own thread; when the queue
+//   is full the oldest pending value is replaced (coalescing) or the new one dropped. The
+//   publisher takes the queue's mutex just to enqueue, never while the consumer's callback runs,
+//   so a slow consumer does not make it wait.
+template <typename T> class CowObservable
+{
+  public:
+    using Observer   = std::function<void(const T&)>;
+    using ObserverId = size_t;
+
+    CowObservable() = default;
+    ~CowObservable()
+    {
+        clearObservers();
+    }
+
+    CowObservable(CowObservable const&)            = delete;
+    CowObservable& operator=(CowObservable const&) = delete;
+
+    // Synchronous observer: invoked on the publisher thread
+    ObserverId addObserver(Observer observer)
+    {
+        Entry e;
+        e.observer = std::move(observer);
+        return add_(std::move(e));
+    }
+
+    // Asynchronous observer: invoked on a dedicated thread with at most queue_depth pending values.
+    // With coalesce=true a full queue drops its oldest value (the consumer always ends up with the
+    // latest state); otherwise the incoming value is dropped.
+    ObserverId addAsyncObserver(Observer observer, std::size_t queue_depth = 1,
+                                bool coalesce = true)
+    {
+        Entry e;
+        e.async = std::make_shared<AsyncDelivery>(std::move(observer), queue_depth, coalesce);
+        return add_(std::move(e));
+    }
+
+    bool removeObserver(ObserverId id)
+    {
+        std::shared_ptr<AsyncDelivery> retired;
+        {
+            std::lock_guard<std::mutex> lock(write_mutex_);
+            auto cur = load_();
+            auto it  = std::find_if(cur->begin(), cur->end(),
+                                    [id](Entry const& e) { return e.id == id; });
+            if (it == cur->end())
+            {
+                return false;
+            }
+            auto next = std::make_shared<List>(*cur);
+            next->erase(next->begin() + (it - cur->begin()));
+            retired = it->async;
+            store_(std::move(next));
+        }
+        if (retired)
+        {
+            retired->shutdown();
+        }
+        return true;
+    }
+
+    void clearObservers()
+    {
+        std::shared_ptr<List const> old;
+        {
+            std::lock_guard<std::mutex> lock(write_mutex_);
+            old = load_();
+            store_(std::make_shared<List>());
+        }
+        for (auto const& e : *old)
+        {
+            if (e.async)
+            {
+                e.async->shutdown();
+            }
+        }
+    }
+
+    size_t observerCount() const
+    {
+        return load_()->size();
+    }
+
+    // Values dropped or coalesced away across all async observers since construction
+    std::size_t droppedCount() const noexcept
+    {
+        return dropped_.load(std::memory_order_relaxed);
+    }
+
+  protected:
+    void notifyObservers(const T& data)
+    {
+        auto list = load_();
+        for (auto const& e : *list)
+        {
+            if (e.async)
+            {
+                if (!e.async->push(data))
+                {
+                    dropped_.fetch_add(1, std::memory_order_relaxed);
+                }
+                continue;
+            }
+            try
+            {
+                e.observer(data);
+            }
+            catch (...)
+            {
+                // Ignore observer exceptions to prevent one bad observer
+                // from breaking others
+            }
+        }
+    }
+
+  private:
+    class AsyncDelivery
+    {
+      public:
+        AsyncDelivery(Observer observer, std::size_t depth, bool coalesce)
+            : state_(std::make_shared<State>())
+        {
+            state_->observer = std::move(observer);
+            state_->slots.resize(std::max<std::size_t>(depth, 1));
+            state_->coalesce = coalesce;
+            worker_          = std::thread(&AsyncDelivery::loop_, state_);
+        }
+
+        ~AsyncDelivery()
+        {
+            shutdown();
+        }
+
+        // Returns false when the value (or an older pending one) had to be discarded
+        bool push(const T& value)
+        {
+            auto& s = *state_;
+            bool ok = true;
+            {
+                std::lock_guard<std::mutex> lock(s.m);
+                if (s.stop)
+                {
+                    return true;
+                }
+                if (s.count == s.slots.size())
+                {
+                    ok = false;
+                    if (!s.coalesce)
+                    {
+                        return false;
+                    }
+                    s.head = (s.head + 1) % s.slots.size();
+                    --s.count;
+                }
+                s.slots[(s.head + s.count) % s.slots.size()] = value;
+                ++s.count;
+            }
+            s.cv.notify_one();
+            return ok;
+        }
+
+        void shutdown()
+        {
+            {
+                std::lock_guard<std::mutex> lock(state_->m);
+                state_->stop = true;
+            }
+            state_->cv.notify_one();
+            if (!worker_.joinable())
+            {
+                return;
+            }
+            if (worker_.get_id() == std::this_thread::get_id())
+            {
+                worker_.detach(); // unsubscribed from its own callback; state outlives us
+            }
+            else
+            {
+                worker_.join();
+            }
+        }
+
+      private:
+        struct State
+        {
+            std::mutex m;
+            std::condition_variable cv;
+            std::vector<T> slots;
+            std::size_t head{0};
+            std::size_t count{0};
+            bool coalesce{true};
+            bool stop{false};
+            Observer observer;
+        };
+
+        static void loop_(std::shared_ptr<State> s)
+        {
+            T value{};
+            while (true)
+            {
+                {
+                    std::unique_lock<std::mutex> lock(s->m);
+                    // Bounded wait so the stop flag is re-checked even without a notify
+                    if (!s->cv.wait_for(lock, std::chrono::milliseconds(100),
+                                        [&] { return s->stop || s->count > 0; }))
+                    {
+                        continue;
+                    }
+                    if (s->stop)
+                    {
+                        return;
+                    }
+                    value   = std::move(s->slots[s->head]);
+                    s->head = (s->head + 1) % s->slots.size();
+                    --s->count;
+                }
+                try
+                {
+                    s->observer(value);
+                }
+                catch (...)
+                {
+                }
+            }
+        }
+
+        std::shared_ptr<State> state_;
+        std::thread worker_;
+    };
+
+    struct Entry
+    {
+        ObserverId id{0};
+        Observer observer;
+        std::shared_ptr<AsyncDelivery> async;
+    };
+    using List = std::vector<Entry>;
+
+    ObserverId add_(Entry e)
+    {
+        std::lock_guard<std::mutex> lock(write_mutex_);
+        e.id      = next_id_++;
+        auto id   = e.id;
+        auto next = std::make_shared<List>(*load_());
+        next->push_back(std::move(e));
+        store_(std::move(next));
+        return id;
+    }
+
+    std::shared_ptr<List const> load_() const
+    {
+        return std::atomic_load_explicit(&observers_, std::memory_order_acquire);
+    }
+    void store_(std::shared_ptr<List const> next)
+    {
+        std::atomic_store_explicit(&observers_, std::move(next), std::memory_order_release);
+    }
+
+    std::mutex write_mutex_; // serializes subscribe/unsubscribe; publishers never take it
+    std::shared_ptr<List const> observers_{std::make_shared<List const>()};
+    ObserverId next_id_{0};
+    std::atomic<std::size_t> dropped_{0};
+};
+
+} // namespace ethercat_sim::framework
@@ -0,0 +1,148 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace ethercat_sim::framework::profiling
+{
+
+// Duration histogram with power-of-two buckets: bucket b counts samples in [2^(b-1), 2^b) ns
+// (bucket 0 holds 0 ns). Writers only do relaxed atomic increments, so recording is wait-free and
+// a reader can take a snapshot at any time while the loop keeps running.
+class Log2Histogram
+{
+  public:
+    static constexpr std::size_t kBuckets = 40; // last bucket is open ended (>= ~275 s)
+
+    struct Snapshot
+    {
+        std::uint64_t count{0};
+        std::uint64_t sum_ns{0};
+        std::uint64_t max_ns{0};
+        std::array<std::uint64_t, kBuckets> buckets{};
+
+        std::uint64_t meanNs() const noexcept
+        {
+            return count ? sum_ns / count : 0;
+        }
+        // Upper bound of the bucket holding the p-quantile (0 < p <= 1), clamped to max_ns
+        std::uint64_t percentileNs(double p) const noexcept;
+    };
+
+    static std::size_t bucketOf(std::uint64_t ns) noexcept
+    {
+        std::size_t b = ns ? static_cast<std::size_t>(64 - __builtin_clzll(ns)) : 0;
+        return b < kBuckets ? b : kBuckets - 1;
+    }
+
+    void record(std::uint64_t ns) noexcept
+    {
+        buckets_[bucketOf(ns)].fetch_add(1, std::memory_order_relaxed);
+        sum_ns_.fetch_add(ns, std::memory_order_relaxed);
+        std::uint64_t prev = max_ns_.load(std::memory_order_relaxed);
+        while (ns > prev && !max_ns_.compare_exchange_weak(prev, ns, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    Snapshot snapshot() const noexcept;
+    void reset() noexcept;
+
+  private:
+    std::array<std::atomic<std::uint64_t>, kBuckets> buckets_{};
+    std::atomic<std::uint64_t> sum_ns_{0};
+    std::atomic<std::uint64_t> max_ns_{0};
+};
+
+// Where a slaves cycle spends its time
+enum class Phase : std::uint8_t
+{
+    SocketRead,    // reading one request, from its first bytes on (idle wait excluded)
+    ProcessFrame,  // datagram handling (register/logical access) for one frame
+    SlaveRoutines, // VirtualSlave::routine() over the due slaves, per runOnce()
+    InputMapping,  // digital input -> logical image copy of the due slaves, per runOnce()
+    SocketWrite,   // sending one reply
+    Logging,       // emitting one log line
+    Count
+};
+
+char const* phaseName(Phase phase) noexcept;
+
+// Per-phase histograms plus per-command datagram counters, shared between the server loop (writer)
+// and the TUI / SIGUSR1 dump (readers).
+class PhaseProfiler
+{
+  public:
+    static constexpr std::size_t kPhases   = static_cast<std::size_t>(Phase::Count);
+    static constexpr std::size_t kCommands = 16; // EtherCAT command codes 0..14, 15 = other
+
+    static std::uint64_t nowNs() noexcept
+    {
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                              std::chrono::steady_clock::now().time_since_epoch())
+                                              .count());
+    }
+
+    void record(Phase phase, std::uint64_t ns) noexcept
+    {
+        phases_[static_cast<std::size_t>(phase)].record(ns);
+    }
+    void countDatagram(std::uint8_t command) noexcept
+    {
+        datagrams_[command < kCommands ? command : kCommands - 1].fetch_add(
+            1, std::memory_order_relaxed);
+    }
+
+    Log2Histogram::Snapshot phase(Phase phase) const noexcept
+    {
+        return phases_[static_cast<std::size_t>(phase)].snapshot();
+    }
+    std::uint64_t datagrams(std::uint8_t command) const noexcept
+    {
+        return datagrams_[command < kCommands ? command : kCommands - 1].load(
+            std::memory_order_relaxed);
+    }
+
+    void reset() noexcept;
+
+    // Multi-line table: per phase count/mean/p50/p99/max, then non-zero datagram counters
+    std::string report() const;
+
+    // Routes the time spent in Logger output into the Logging phase of profiler (the logger is
+    // process wide, so the last attached profiler wins); nullptr detaches
+    static void attachLogger(PhaseProfiler* profiler) noexcept;
+
+  private:
+    std::array<Log2Histogram, kPhases> phases_{};
+    std::array<std::atomic<std::uint64_t>, kCommands> datagrams_{};
+};
+
+// Times a scope into one phase; a null profiler skips the clock reads entirely
+class ScopedPhase
+{
+  public:
+    ScopedPhase(PhaseProfiler* profiler, Phase phase) noexcept
+        : profiler_(profiler), phase_(phase), start_(profiler ? PhaseProfiler::nowNs() : 0)
+    {
+    }
+    ~ScopedPhase()
+    {
+        if (profiler_)
+        {
+            profiler_->record(phase_, PhaseProfiler::nowNs() - start_);
+        }
+    }
+    ScopedPhase(ScopedPhase const&)            = delete;
+    ScopedPhase& operator=(ScopedPhase const&) = delete;
+
+  private:
+    PhaseProfiler* profiler_;
+    Phase phase_;
+    std::uint64_t start_;
+};
+
+} // namespace ethercat_sim::framework::profiling
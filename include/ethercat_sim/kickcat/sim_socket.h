@@ -1,10 +1,12 @@
 #pragma once
 
 #include <chrono>
+#include <cstddef>
 #include <memory>
 #include <vector>
 
 #include "kickcat/AbstractSocket.h"
+#include "kickcat/Frame.h"
 
 #include "ethercat_sim/simulation/network_simulator.h"
 
@@ -22,9 +24,30 @@ class SimSocket : public ::kickcat::AbstractSocket
     int32_t read(uint8_t* frame, int32_t frame_size) override;
     int32_t write(uint8_t const* frame, int32_t frame_size) override;
 
+    // Zero-latency fast path for single-threaded in-process use (unit tests, embedded
+    // simulation): write() processes the frame inside a preallocated slot and the next read()
+    // copies it straight out, bypassing the simulator queue, its lock and the EtherCATFrame
+    // copies. Simulated latency and timeouts do not apply. Call before the first write().
+    void setDirect(bool direct);
+    bool direct() const noexcept
+    {
+        return direct_;
+    }
+
+    // Frames that can be written ahead of read() in direct mode
+    static constexpr std::size_t kDirectSlots = 32;
+
   private:
+    void processDatagrams_(::kickcat::Frame& f);
+
     std::shared_ptr<simulation::NetworkSimulator> sim_;
     std::chrono::nanoseconds timeout_{std::chrono::milliseconds(2)};
+
+    bool direct_{false};
+    std::vector<::kickcat::Frame> slots_;
+    std::vector<int32_t> slot_sizes_;
+    std::size_t slot_head_{0}; // next slot to read
+    std::size_t slot_tail_{0}; // next slot to write
 };
 
 } // namespace ethercat_sim::kickcat
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ethercat_sim::simulation
+{
+
+// Mechanics and servo loops of simulated drive axes. Every axis is a mass-spring-damper
+// (inertia J, viscous damping c, spring k towards position 0) driven by the torque u of its
+// servo loop:
+//   Position: u = kp (target_position - x) + kd (target_velocity - v), target_velocity being
+//             the velocity feed-forward
+//   Velocity: u = kv (target_velocity - v)
+//   Torque:   u = target_torque
+//   Off:      u = 0, the axis coasts
+// u is limited to +-max_torque, then J a = u - c v - k x is integrated semi-implicitly.
+//
+// All axes advance together on a fixed step clock (4 kHz by default). The axis state is stored
+// as structure-of-arrays and the mode selects the loop through 0/1 weights instead of a branch,
+// so a step is a single vectorizable pass over all axes of all drives rather than a physics
+// update per slave. Units are the drive's: counts, counts/s and per mille of rated torque.
+//
+// The drives sharing a bank command and advance it from their routines, which the simulator runs
+// one at a time on its thread; the bank has no locking of its own, so code stepping it directly
+// must not run alongside the simulator.
+class AxisBank
+{
+  public:
+    using Clock = std::chrono::steady_clock;
+    using Axis  = std::uint32_t;
+
+    enum class Mode : std::uint8_t
+    {
+        Off,
+        Position,
+        Velocity,
+        Torque
+    };
+
+    struct Params
+    {
+        double inertia{1e-3};        // per mille per count/s^2
+        double damping{0.0};         // per mille per count/s
+        double stiffness{0.0};       // per mille per count
+        double max_torque{3000.0};   // per mille
+        double position_loop{30.0};  // Hz, bandwidth of the critically damped position loop
+        double velocity_loop{100.0}; // Hz, bandwidth of the velocity loop
+    };
+
+    static constexpr std::chrono::nanoseconds kDefaultStep{std::chrono::microseconds(250)};
+    static constexpr unsigned kDefaultSubsteps = 4;
+    // advanceTo() integrates at most this many steps; a longer stall of the clock is dropped
+    static constexpr std::size_t kMaxCatchUp = 4000;
+
+    explicit AxisBank(std::chrono::nanoseconds step = kDefaultStep,
+                      unsigned substeps             = kDefaultSubsteps,
+                      Clock::time_point start       = Clock::now());
+
+    // Appends an axis at rest at position 0, mode Off
+    Axis addAxis();
+    Axis addAxis(Params const& params);
+
+    // Takes effect from the next step; targets the mode does not use are ignored
+    void command(Axis axis, Mode mode, double target_position, double target_velocity,
+                 double target_torque) noexcept;
+    // Moves an axis, e.g. to home it
+    void setState(Axis axis, double position, double velocity) noexcept;
+
+    // Integrates the steps due up to now. Returns the number of steps the clock advanced.
+    std::size_t advanceTo(Clock::time_point now);
+    // Integrates count steps regardless of the clock
+    void step(std::size_t count);
+
+    double position(Axis axis) const noexcept
+    {
+        return axis < axes_ ? position_[axis] : 0.0;
+    }
+    double velocity(Axis axis) const noexcept
+    {
+        return axis < axes_ ? velocity_[axis] : 0.0;
+    }
+    // Torque applied by the servo loop in the last substep
+    double torque(Axis axis) const noexcept
+    {
+        return axis < axes_ ? torque_[axis] : 0.0;
+    }
+
+    std::size_t axes() const noexcept
+    {
+        return axes_;
+    }
+    std::chrono::nanoseconds stepPeriod() const noexcept
+    {
+        return period_;
+    }
+    // Steps integrated (or dropped) since start
+    std::uint64_t steps() const noexcept
+    {
+        return steps_;
+    }
+
+  private:
+    Clock::time_point start_;
+    std::chrono::nanoseconds period_;
+    unsigned substeps_;
+    double h_; // substep, seconds
+    std::size_t axes_{0};
+    std::uint64_t steps_{0};
+
+    // Axis state and parameters, one entry per axis
+    std::vector<double> position_;
+    std::vector<double> velocity_;
+    std::vector<double> torque_;
+    std::vector<double> inverse_inertia_;
+    std::vector<double> damping_;
+    std::vector<double> stiffness_;
+    std::vector<double> max_torque_;
+    std::vector<double> kp_;
+    std::vector<double> kd_;
+    std::vector<double> kv_;
+    std::vector<double> target_position_;
+    std::vector<double> target_velocity_;
+    std::vector<double> target_torque_;
+    std::vector<double> position_w_; // loop weights: 1 for the axis' mode, else 0
+    std::vector<double> velocity_w_;
+    std::vector<double> torque_w_;
+};
+
+} // namespace ethercat_sim::simulation
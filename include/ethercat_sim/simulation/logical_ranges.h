@@ -0,0 +1,85 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ethercat_sim::simulation
+{
+
+// Logical address ranges of the FMMU-like mappings of a NetworkSimulator, for finding the ones a
+// logical datagram touches. Ranges are sorted by start and may overlap; max_end_[i] is the largest
+// end among the first i + 1, so a lookup binary-searches the end of the access and walks back
+// only while earlier ranges can still reach it. An access costs O(log n + overlapping ranges)
+// instead of a pass over every mapping.
+class LogicalRanges
+{
+  public:
+    struct Range
+    {
+        std::size_t begin;
+        std::size_t end;
+        std::size_t map; // index of the mapping in its owner's list
+    };
+
+    void clear() noexcept
+    {
+        ranges_.clear();
+        max_end_.clear();
+    }
+    // Empty ranges are dropped; call build() after the last add()
+    void add(std::size_t begin, std::size_t size, std::size_t map)
+    {
+        if (size > 0)
+        {
+            ranges_.push_back(Range{begin, begin + size, map});
+        }
+    }
+    void build()
+    {
+        std::sort(ranges_.begin(), ranges_.end(),
+                  [](Range const& a, Range const& b) { return a.begin < b.begin; });
+        max_end_.resize(ranges_.size());
+        std::size_t reach = 0;
+        for (std::size_t i = 0; i < ranges_.size(); ++i)
+        {
+            reach       = std::max(reach, ranges_[i].end);
+            max_end_[i] = reach;
+        }
+    }
+
+    // Calls f(range, lo, hi) for every range intersecting [begin, begin + len), with [lo, hi)
+    // the intersection; ranges are visited by descending start
+    template <typename F>
+    void forEachOverlap(std::size_t begin, std::size_t len, F&& f) const
+    {
+        std::size_t const end = begin + len;
+        auto const first_after =
+            std::lower_bound(ranges_.begin(), ranges_.end(), end,
+                             [](Range const& r, std::size_t e) { return r.begin < e; });
+        for (auto i = static_cast<std::size_t>(first_after - ranges_.begin()); i-- > 0;)
+        {
+            if (max_end_[i] <= begin)
+            {
+                break;
+            }
+            auto const& r = ranges_[i];
+            if (r.end > begin)
+            {
+                f(r, std::max(begin, r.begin), std::min(end, r.end));
+            }
+        }
+    }
+
+    std::size_t size() const noexcept
+    {
+        return ranges_.size();
+    }
+
+  private:
+    std::vector<Range> ranges_;
+    std::vector<std::size_t> max_end_;
+};
+
+} // namespace ethercat_sim::simulation
@@ -1,14 +1,22 @@
 #pragma once
 
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <cstdint>
 #include <deque>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "ethercat_sim/communication/ethercat_frame.h"
+#include "ethercat_sim/framework/profiling/phase_profiler.h"
+#include "ethercat_sim/simulation/logical_ranges.h"
+#include "ethercat_sim/simulation/slave_scheduler.h"
+#include "ethercat_sim/simulation/slave_state.h"
 #include "ethercat_sim/simulation/virtual_slave.h"
 
 namespace ethercat_sim::simulation
@@ -18,12 +26,24 @@ class NetworkSimulator
 {
   public:
     NetworkSimulator() = default;
+    ~NetworkSimulator();
+    NetworkSimulator(NetworkSimulator const&)            = delete;
+    NetworkSimulator& operator=(NetworkSimulator const&) = delete;
+
     void initialize(const std::string& config = "") noexcept;
-    int runOnce() noexcept; // returns 0 on success
+    // Runs routine() and refreshes the input mappings of the slaves that asked for it (register
+    // writes, input/state changes, expired timers) since the last call; idle slaves cost nothing.
+    // Returns 0 on success.
+    int runOnce() noexcept;
+    // Times slave routines and input mapping of every runOnce() (nullptr disables)
+    void setProfiler(framework::profiling::PhaseProfiler* profiler) noexcept
+    {
+        profiler_ = profiler;
+    }
 
     // KickCAT-like concept: simple frame I/O to a simulated link
     void setLinkUp(bool up) noexcept;
-    void setLatencyMs(std::uint32_t ms) noexcept; // delivery delay simulation (not enforced yet)
+    void setLatencyMs(std::uint32_t ms) noexcept; // delivery delay applied to each sent frame
     bool isLinkUp() const noexcept
     {
         return linkUp_;
@@ -44,28 +64,41 @@ class NetworkSimulator
     void addVirtualSlave(std::shared_ptr<VirtualSlave> slave) noexcept;
     void clearSlaves() noexcept;
     void startAllSlaves() noexcept;
+    // Published state of every registered slave, in registry order. Observers read it without
+    // taking the registry mutex; the table is replaced whenever slaves are added or removed.
+    // Additions are batched: the first call after them (or runOnce(), startAllSlaves())
+    // republishes the table once under the mutex.
+    std::shared_ptr<SlaveStateTable const> slaveStates() const noexcept;
 
-    // Non-blocking send/receive stubs
+    // Frame queue between the master side and the simulated segment
     bool sendFrame(const communication::EtherCATFrame& frame) noexcept;
-    bool receiveFrame(communication::EtherCATFrame& out) noexcept;
+    bool receiveFrame(communication::EtherCATFrame& out) noexcept; // non-blocking
+    // Waits up to timeout for the head frame to become deliverable (queued and past its latency
+    // delay); sleeps on a condition variable instead of polling. A negative timeout waits forever.
+    bool receiveFrame(communication::EtherCATFrame& out, std::chrono::nanoseconds timeout) noexcept;
 
     // Addressed register access helpers (for adapter integration/tests)
     bool writeToSlave(std::uint16_t station_address, std::uint16_t reg, const std::uint8_t* data,
                       std::size_t len) noexcept;
+    // Not const: reads have side effects on the slave (mailbox drained, EEPROM address advanced)
+    // and are counted as datagrams
     bool readFromSlave(std::uint16_t station_address, std::uint16_t reg, std::uint8_t* out,
-                       std::size_t len) const noexcept;
+                       std::size_t len) noexcept;
 
     // Auto-increment physical addressing by slave index (0-based)
     bool writeToSlaveByIndex(std::size_t index, std::uint16_t reg, const std::uint8_t* data,
                              std::size_t len) noexcept;
     bool readFromSlaveByIndex(std::size_t index, std::uint16_t reg, std::uint8_t* out,
-                              std::size_t len) const noexcept;
+                              std::size_t len) noexcept;
 
     // Logical memory (LRD/LWR/LRW minimal emulation)
     bool writeLogical(std::uint32_t logical_address, const std::uint8_t* data,
                       std::size_t len) noexcept;
     bool readLogical(std::uint32_t logical_address, std::uint8_t* out,
                      std::size_t len) const noexcept;
+    // LRW: writes data, then returns the image (inputs of mapped slaves included) in place
+    bool readWriteLogical(std::uint32_t logical_address, std::uint8_t* data,
+                          std::size_t len) noexcept;
 
     // Minimal PDO mapping helpers for input bitfields (e.g., EL1258):
     // Map a slave's digital input bitfield into logical memory at logical_address.
@@ -74,6 +107,13 @@ class NetworkSimulator
                           std::size_t width_bytes = 1) noexcept;
     void clearInputMappings() noexcept;
 
+    // FMMU-like mapping of a slave's SM2/SM3 process data (see
+    // VirtualSlave::configureProcessData): logical reads take the latest complete SM3 buffer,
+    // logical writes land in SM2, both at frame time instead of after runOnce(). The SM sizes
+    // are taken when the mapping is made; configure the process data first.
+    void mapProcessData(const std::shared_ptr<VirtualSlave>& slave, std::uint32_t logical_outputs,
+                        std::uint32_t logical_inputs) noexcept;
+
   private:
     struct FrameItem
     {
@@ -83,23 +123,70 @@ class NetworkSimulator
 
     bool linkUp_{true};
     std::uint32_t latencyMs_{0};
+    framework::profiling::PhaseProfiler* profiler_{nullptr};
     std::size_t virtualSlaveCount_{0};
     mutable std::mutex mutex_;
+    std::mutex rx_mutex_; // guards queue_ only, so waiting readers do not contend with slave access
+    std::condition_variable rx_cv_;
     std::deque<FrameItem> queue_;
     std::vector<std::shared_ptr<VirtualSlave>> slaves_;
-    std::vector<std::uint8_t> logical_ = std::vector<std::uint8_t>(16384, 0);
+    mutable std::shared_ptr<SlaveStateTable const> state_table_{
+        std::make_shared<SlaveStateTable>()};
+    mutable std::atomic<bool> table_stale_{false}; // slaves added since the last publish
+    // Logical process image (LRD/LWR/LRW): room for a 64 KiB PDO image
+    static constexpr std::size_t kLogicalSize = 64u * 1024u;
+    std::vector<std::uint8_t> logical_        = std::vector<std::uint8_t>(kLogicalSize, 0);
+
+    static constexpr std::size_t kNoSlot = static_cast<std::size_t>(-1);
 
     struct InputMap
     {
         std::weak_ptr<VirtualSlave> slave;
         std::uint32_t logical_address{0};
         std::size_t width_bytes{1};
+        std::size_t slot{kNoSlot}; // registry index, kNoSlot for unregistered slaves
     };
     std::vector<InputMap> input_maps_;
+    // Slaves whose routine() is due; slot = index in slaves_
+    DirtySlaveSet dirty_;
+    std::vector<std::size_t> due_;
+    // Slaves addressed since the last runOnce(), whose datagram counters it publishes
+    std::vector<std::shared_ptr<VirtualSlave>> counted_;
+    std::vector<std::vector<std::size_t>> maps_by_slot_; // indices into input_maps_
+    std::vector<std::size_t> unslotted_maps_;            // refreshed every runOnce()
+    std::unordered_map<VirtualSlave const*, std::size_t> slot_of_; // registry slot of each slave
+
+    struct ProcessDataMap
+    {
+        std::weak_ptr<VirtualSlave> slave;
+        std::uint32_t logical_outputs{0};
+        std::uint32_t logical_inputs{0};
+    };
+    std::vector<ProcessDataMap> process_maps_;
+    // Logical ranges of process_maps_ and input_maps_, rebuilt by the first logical access after
+    // a change
+    mutable LogicalRanges output_ranges_;
+    mutable LogicalRanges input_ranges_;
+    mutable LogicalRanges digital_ranges_;
+    mutable bool ranges_stale_{false};
+    std::vector<std::pair<std::size_t, std::size_t>> input_spans_; // writeLogicalNoLock scratch
+
+    bool writeLogicalNoLock(std::uint32_t logical_address, const std::uint8_t* data,
+                            std::size_t len) noexcept;
+    bool readLogicalNoLock(std::uint32_t logical_address, std::uint8_t* out,
+                           std::size_t len) const noexcept;
 
     // Internal helpers (no locking) to centralize slave lookup
     std::shared_ptr<VirtualSlave> getSlaveByStationAddressNoLock(std::uint16_t addr) const noexcept;
     std::shared_ptr<VirtualSlave> getSlaveByIndexNoLock(std::size_t index) const noexcept;
+    void publishStateTableNoLock() const noexcept;
+    void countDatagramNoLock(std::shared_ptr<VirtualSlave> const& slave, bool acknowledged);
+    void attachSlaveNoLock(std::size_t slot) noexcept;
+    void detachSlavesNoLock(std::size_t from) noexcept;
+    void reindexInputMapsNoLock();
+    void bucketInputMapNoLock(std::size_t id);
+    void indexLogicalRangesNoLock() const;
+    void refreshInputMapNoLock(InputMap const& m) noexcept;
 };
 
 } // namespace ethercat_sim::simulation
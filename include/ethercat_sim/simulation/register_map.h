@@ -0,0 +1,220 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ethercat_sim::simulation
+{
+
+// What answers an ESC address. Memory is plain register storage; the others are hooks: either
+// memory with a side effect on write (station address, AL control, SM config) or a window that is
+// served by the slave logic instead of storage (EEPROM interface, mailboxes, process data).
+enum class RegisterHandler : std::uint8_t
+{
+    Unmapped,
+    Memory,
+    StationAddress,
+    AlControl,
+    EepromControl,
+    EepromData,
+    SyncManager,
+    MailboxRecv,
+    MailboxSend,
+    ProcessOutputs, // SM2 buffered process data (master -> slave)
+    ProcessInputs,  // SM3 buffered process data (slave -> master)
+    Count
+};
+
+// Per-device address classification over the 64 KiB ESC space, as a two-level table: 256 pages
+// of 256 bytes. A page whose bytes all share one handler is stored as that handler alone; only
+// pages holding a boundary (a hook register, a mailbox window edge) get a per-byte table, which
+// also records where each byte's run of equal handlers ends. Each page caches the set of handlers
+// it contains, so classifying an access costs one lookup per page it touches plus one per handler
+// run inside the boundary pages, however long the access is.
+class RegisterMap
+{
+  public:
+    using HandlerMask = std::uint32_t;
+    static_assert(static_cast<std::size_t>(RegisterHandler::Count) <= 32, "mask too small");
+
+    static constexpr std::size_t kPageSize = 256;
+    static constexpr std::size_t kPages    = 65536 / kPageSize;
+
+    static constexpr HandlerMask bit(RegisterHandler h) noexcept
+    {
+        return HandlerMask{1} << static_cast<unsigned>(h);
+    }
+
+    RegisterMap() noexcept
+    {
+        clear();
+    }
+
+    void clear() noexcept
+    {
+        pages_.fill(Page{RegisterHandler::Unmapped, kUniform, bit(RegisterHandler::Unmapped)});
+        detail_.clear();
+    }
+
+    // Classifies [begin, begin + len), clipped to the address space
+    void assign(std::uint32_t begin, std::size_t len, RegisterHandler h)
+    {
+        std::uint32_t const end = clipEnd_(begin, len);
+        while (begin < end)
+        {
+            std::size_t const page = begin / kPageSize;
+            std::uint32_t const lo = begin % kPageSize;
+            std::uint32_t const hi = std::min<std::uint32_t>(kPageSize, lo + (end - begin));
+            Page& p                = pages_[page];
+            if (lo == 0 && hi == kPageSize)
+            {
+                p = Page{h, kUniform, bit(h)};
+            }
+            else
+            {
+                if (p.detail == kUniform)
+                {
+                    p.detail = static_cast<std::uint16_t>(detail_.size());
+                    detail_.emplace_back();
+                    detail_.back().handler.fill(p.handler);
+                }
+                auto& d = detail_[p.detail];
+                std::fill(d.handler.begin() + lo, d.handler.begin() + hi, h);
+                std::size_t run = kPageSize;
+                p.mask          = 0;
+                for (std::size_t i = kPageSize; i-- > 0;)
+                {
+                    if (i + 1 < kPageSize && d.handler[i] != d.handler[i + 1])
+                    {
+                        run = i + 1;
+                    }
+                    d.run_end[i] = static_cast<std::uint16_t>(run);
+                    p.mask |= bit(d.handler[i]);
+                }
+            }
+            begin += hi - lo;
+        }
+    }
+
+    RegisterHandler at(std::uint16_t addr) const noexcept
+    {
+        Page const& p = pages_[addr / kPageSize];
+        return p.detail == kUniform ? p.handler : detail_[p.detail].handler[addr % kPageSize];
+    }
+
+    // Calls f(handler, address, length) for each maximal run of one handler in [begin, begin +
+    // len), clipped to the address space, in address order
+    template <typename F>
+    void forEachRun(std::uint32_t begin, std::size_t len, F&& f) const
+    {
+        std::uint32_t const end = clipEnd_(begin, len);
+        RegisterHandler current = RegisterHandler::Count;
+        std::uint32_t run_begin = begin;
+        auto extend = [&](RegisterHandler h, std::uint32_t at)
+        {
+            if (h != current)
+            {
+                if (current != RegisterHandler::Count)
+                {
+                    f(current, run_begin, static_cast<std::size_t>(at - run_begin));
+                }
+                current   = h;
+                run_begin = at;
+            }
+        };
+        while (begin < end)
+        {
+            std::size_t const page = begin / kPageSize;
+            std::uint32_t const lo = begin % kPageSize;
+            std::uint32_t const hi = std::min<std::uint32_t>(kPageSize, lo + (end - begin));
+            Page const& p          = pages_[page];
+            if (p.detail == kUniform)
+            {
+                extend(p.handler, begin);
+            }
+            else
+            {
+                auto const& d = detail_[p.detail];
+                for (std::uint32_t i = lo; i < hi; i = d.run_end[i])
+                {
+                    extend(d.handler[i], begin + (i - lo));
+                }
+            }
+            begin += hi - lo;
+        }
+        if (current != RegisterHandler::Count)
+        {
+            f(current, run_begin, static_cast<std::size_t>(end - run_begin));
+        }
+    }
+
+    // Handlers present in [begin, begin + len); an access running past 0xFFFF includes Unmapped
+    HandlerMask handlersIn(std::uint32_t begin, std::size_t len) const noexcept
+    {
+        HandlerMask mask = 0;
+        if (static_cast<std::size_t>(begin) + len > 65536)
+        {
+            mask |= bit(RegisterHandler::Unmapped);
+        }
+        std::uint32_t const end = clipEnd_(begin, len);
+        while (begin < end)
+        {
+            std::size_t const page = begin / kPageSize;
+            std::uint32_t const lo = begin % kPageSize;
+            std::uint32_t const hi = std::min<std::uint32_t>(kPageSize, lo + (end - begin));
+            Page const& p          = pages_[page];
+            if (p.detail == kUniform || (lo == 0 && hi == kPageSize))
+            {
+                mask |= p.mask;
+            }
+            else
+            {
+                auto const& d = detail_[p.detail];
+                for (std::uint32_t i = lo; i < hi; i = d.run_end[i])
+                {
+                    mask |= bit(d.handler[i]);
+                }
+            }
+            begin += hi - lo;
+        }
+        return mask;
+    }
+
+    // True when every byte of [begin, begin + len) maps to one of the handlers in allowed
+    bool within(std::uint32_t begin, std::size_t len, HandlerMask allowed) const noexcept
+    {
+        return (handlersIn(begin, len) & ~allowed) == 0;
+    }
+
+  private:
+    static constexpr std::uint16_t kUniform = 0xFFFF;
+
+    struct Page
+    {
+        RegisterHandler handler; // valid when detail == kUniform
+        std::uint16_t detail;    // index into detail_, or kUniform
+        HandlerMask mask;        // handlers present in the page
+    };
+
+    // Per-byte handlers of a boundary page; run_end[i] is the first byte after i with another
+    // handler (kPageSize at the last run)
+    struct Detail
+    {
+        std::array<RegisterHandler, kPageSize> handler;
+        std::array<std::uint16_t, kPageSize> run_end;
+    };
+
+    static std::uint32_t clipEnd_(std::uint32_t begin, std::size_t len) noexcept
+    {
+        std::size_t end = static_cast<std::size_t>(begin) + len;
+        return static_cast<std::uint32_t>(end > 65536 ? 65536 : end);
+    }
+
+    std::array<Page, kPages> pages_{};
+    std::vector<Detail> detail_;
+};
+
+} // namespace ethercat_sim::simulation
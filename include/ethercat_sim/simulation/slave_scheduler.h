@@ -0,0 +1,76 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+#include "ethercat_sim/simulation/timer_wheel.h"
+
+namespace ethercat_sim::simulation
+{
+
+// Where a VirtualSlave asks for its routine() to run: now (inputs, state or mailbox changed), at a
+// point in time (debounce, timeouts) or at a fixed rate. slot identifies the slave to the
+// scheduler.
+class SlaveScheduler
+{
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    virtual ~SlaveScheduler()                                              = default;
+    virtual void markDirty(std::size_t slot) noexcept                      = 0;
+    virtual void wakeAt(std::size_t slot, Clock::time_point when) noexcept = 0;
+    // Runs fn on the simulation thread once when has passed, then marks the slot dirty
+    virtual void callAt(std::size_t slot, Clock::time_point when, std::function<void()> fn) = 0;
+    // routine() at least once per period (zero: on events only)
+    virtual void setUpdatePeriod(std::size_t slot, std::chrono::nanoseconds period) = 0;
+};
+
+// Dirty set plus timer wheel behind NetworkSimulator::runOnce(). Any thread may mark a slot or arm
+// a timer; the simulation loop drains the slots that are due, so per-frame work follows activity
+// instead of segment size. Each slot is reported at most once per drain.
+class DirtySlaveSet final : public SlaveScheduler
+{
+  public:
+    explicit DirtySlaveSet(std::chrono::nanoseconds tick = TimerWheel::kDefaultTick);
+
+    // Drops pending marks, timers and update periods of slots >= slots
+    void truncate(std::size_t slots);
+
+    void markDirty(std::size_t slot) noexcept override;
+    void wakeAt(std::size_t slot, Clock::time_point when) noexcept override;
+    void callAt(std::size_t slot, Clock::time_point when, std::function<void()> fn) override;
+    void setUpdatePeriod(std::size_t slot, std::chrono::nanoseconds period) override;
+
+    // Advances the timers to now, runs the expired callAt() functions, then appends the slots due
+    // to out. Simulation thread only; NetworkSimulator calls it with its lock held, so the callAt()
+    // functions run under that lock too.
+    void drain(Clock::time_point now, std::vector<std::size_t>& out);
+
+    bool idle() const noexcept;
+
+  private:
+    // Timers carry the slot and its generation; truncate() bumps the generation so timers of a
+    // dropped slot fire as no-ops
+    static std::uint64_t key_(std::size_t slot, std::uint32_t generation) noexcept
+    {
+        return (static_cast<std::uint64_t>(generation) << 32) | static_cast<std::uint32_t>(slot);
+    }
+    bool liveNoLock_(std::uint64_t key) const noexcept;
+    void growNoLock_(std::size_t slot);
+    void markNoLock_(std::size_t slot);
+    void fire_(std::uint64_t key, std::function<void()> const* fn);
+
+    mutable std::mutex mutex_;
+    std::vector<std::uint8_t> flags_;
+    std::vector<std::uint32_t> generations_;
+    std::vector<TimerWheel::TimerId> periodic_;
+    std::vector<std::size_t> dirty_;
+    TimerWheel wheel_;
+    std::vector<TimerWheel::Callback> expired_;
+};
+
+} // namespace ethercat_sim::simulation
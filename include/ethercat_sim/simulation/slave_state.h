@@ -0,0 +1,36 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "ethercat_sim/framework/concurrency/seqlock.h"
+
+namespace ethercat_sim::simulation
+{
+
+// Observable state of one virtual slave. The slave republishes it in place (datagram counters once
+// per frame, routine()) under its usual external serialization; observers copy it out of the
+// seqlock from any thread without touching NetworkSimulator's registry mutex.
+struct SlaveState
+{
+    std::uint64_t datagrams{0};      // register datagrams addressed to this slave
+    std::uint64_t wkc_zero{0};       // ... of which the slave did not acknowledge
+    std::uint64_t mailbox_writes{0}; // master -> slave mailbox writes
+    std::uint64_t mailbox_reads{0};  // slave -> master mailbox reads
+    std::uint32_t inputs{0};         // digital input bitfield, valid when has_inputs
+    std::uint16_t station_address{0};
+    std::uint16_t al_status_code{0};
+    std::uint16_t dl_status{0};
+    std::uint8_t al_state{0};
+    std::array<std::uint8_t, 4> sm_status{}; // SM0..SM3 status bytes
+    bool has_inputs{false};
+};
+
+using PublishedSlaveState = framework::concurrency::SeqLock<SlaveState>;
+
+// Registry order snapshot, republished whenever slaves are added or removed
+using SlaveStateTable = std::vector<std::shared_ptr<PublishedSlaveState const>>;
+
+} // namespace ethercat_sim::simulation
@@ -0,0 +1,262 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+#include "ethercat_sim/simulation/slaves/terminal_traits.h"
+#include "ethercat_sim/simulation/virtual_slave.h"
+#include "ethercat_sim/simulation/waveform_bank.h"
+
+namespace ethercat_sim::simulation::slaves
+{
+
+// Defaults for AnalogInputSlave traits; a terminal supplies product_code and name, plus the
+// range of its inputs
+struct AnalogInputTraits : TerminalTraits
+{
+    static constexpr float full_scale = 10.0f; // signal value that reads as 0x7FFF
+    static constexpr bool bipolar     = true;  // -full_scale..full_scale, else 0..
+    // TxPDO refresh period, normally the bus cycle
+    static constexpr std::chrono::microseconds cycle{1000};
+};
+
+// Generic EL30xx / EL31xx / EL37xx analog input terminal whose channels are lanes of a shared
+// WaveformBank: the bank computes all channels of all terminals in one vectorized batch per
+// sample, the terminal only scales its lanes to INT16 once per cycle (Traits::cycle).
+//
+// Process data (SM3, packed in channel order):
+// - Oversampling == 1 (EL30xx/EL31xx "Standard" PDOs): channel n has TxPDO 0x1A00+2n with
+//   0x6000+0x10*n:01 Status (16 bits: bit 0 underrange, bit 1 overrange, bit 6 error, bit 15
+//   toggles with every refresh) and 0x6000+0x10*n:11 Value (INT16).
+// - Oversampling > 1 (EL37xx): channel n has TxPDO 0x1A00+n with 0x6000+0x10*n:01..Oversampling,
+//   the INT16 samples of the last cycle, oldest first; the bank's sample period sets the
+//   oversampling rate, so cycle should be Oversampling sample periods.
+//
+// Raw values are full_scale -> 0x7FFF, clamped to 0x7FFF and to -0x7FFF (bipolar) or 0
+// (unipolar) with the range flags set. The bank must keep at least Oversampling samples.
+template <std::size_t Channels, std::size_t Oversampling, typename Traits>
+class AnalogInputSlave final : public VirtualSlave
+{
+    static_assert(Channels > 0 && Channels <= 16, "1..16 channels");
+    static_assert(Oversampling > 0 && Oversampling <= 100, "1..100 samples per cycle");
+
+  public:
+    static constexpr std::size_t kChannels        = Channels;
+    static constexpr std::size_t kOversampling    = Oversampling;
+    static constexpr bool kStandardPdo            = Oversampling == 1;
+    static constexpr std::size_t kChannelBytes    = kStandardPdo ? 4 : 2 * Oversampling;
+    static constexpr std::size_t kInputBytes      = Channels * kChannelBytes;
+    static constexpr std::int32_t kRawMax         = 0x7FFF;
+    static constexpr std::int32_t kRawMin         = Traits::bipolar ? -0x7FFF : 0;
+    static constexpr std::uint16_t kUnderrange    = 0x0001u;
+    static constexpr std::uint16_t kOverrange     = 0x0002u;
+    static constexpr std::uint16_t kError         = 0x0040u;
+    static constexpr std::uint16_t kToggle        = 0x8000u;
+    static constexpr std::uint16_t kTxPdoBase     = 0x1A00u;
+    static constexpr std::uint16_t kTxPdoStride   = kStandardPdo ? 2 : 1;
+    static constexpr std::uint16_t kTxAssign      = 0x1C13u;
+    static constexpr std::uint16_t kInputBase     = 0x6000u;
+    static constexpr std::uint16_t kObjectSpan    = 0x10u;
+    static constexpr std::uint8_t kValueSubindex  = 0x11u;
+    static constexpr std::uint8_t kStatusSubindex = 0x01u;
+
+    AnalogInputSlave(std::uint16_t address, std::shared_ptr<WaveformBank> bank)
+        : VirtualSlave(address, Traits::vendor_id, Traits::product_code, Traits::name),
+          bank_(std::move(bank)), first_lane_(bank_->addLanes(Channels))
+    {
+        configureProcessData(0, 0, Traits::inputs_address, kInputBytes, true);
+        setInputPDOMapped(true);
+        setUpdatePeriod(Traits::cycle);
+    }
+
+    // Signal of channel 0..Channels-1, in the units of Traits::full_scale. The bank is shared and
+    // not locked: set waveforms before the simulator runs, or from the simulation thread.
+    void setWaveform(std::size_t channel, WaveformBank::Waveform const& waveform)
+    {
+        if (channel < Channels)
+        {
+            bank_->setWaveform(lane(channel), waveform);
+        }
+    }
+    WaveformBank::Lane lane(std::size_t channel) const noexcept
+    {
+        return static_cast<WaveformBank::Lane>(first_lane_ + channel);
+    }
+    WaveformBank const& bank() const noexcept
+    {
+        return *bank_;
+    }
+
+    // Converted samples and status of a channel as published in the last refresh; sample 0 is
+    // the oldest of the cycle, value() the newest
+    std::int16_t sample(std::size_t channel, std::size_t k) const noexcept
+    {
+        return channel < Channels && k < Oversampling ? frame_[channel][k] : 0;
+    }
+    std::int16_t value(std::size_t channel) const noexcept
+    {
+        return sample(channel, Oversampling - 1);
+    }
+    std::uint16_t status(std::size_t channel) const noexcept
+    {
+        return channel < Channels ? status_[channel] : 0;
+    }
+
+    // Scales a signal value to the raw INT16 range; range violations are flagged in status
+    static std::int16_t toRaw(float v, std::uint16_t& status) noexcept
+    {
+        float const scaled = v * (static_cast<float>(kRawMax) / Traits::full_scale);
+        float const lo     = static_cast<float>(kRawMin);
+        float const hi     = static_cast<float>(kRawMax);
+        status |= scaled < lo ? kUnderrange | kError : 0;
+        status |= scaled > hi ? kOverrange | kError : 0;
+        float const clamped = scaled < lo ? lo : (scaled > hi ? hi : scaled);
+        return static_cast<std::int16_t>(std::lround(clamped));
+    }
+
+  protected:
+    void onRoutine() noexcept override
+    {
+        bank_->advanceTo(SlaveScheduler::Clock::now()); // a no-op for all but the first terminal
+        toggle_ ^= kToggle;
+        std::uint8_t* image = inputsBuffer();
+        std::array<float, Oversampling> samples{};
+        for (std::size_t ch = 0; ch < Channels; ++ch)
+        {
+            bank_->recent(lane(ch), Oversampling, samples.data());
+            std::uint8_t* pdo    = image + ch * kChannelBytes;
+            std::uint16_t status = 0;
+            for (std::size_t k = 0; k < Oversampling; ++k)
+            {
+                frame_[ch][k] = toRaw(samples[k], status);
+            }
+            status_[ch] = static_cast<std::uint16_t>(status | toggle_);
+            if constexpr (kStandardPdo)
+            {
+                put16_(pdo, status_[ch]);
+                pdo += 2;
+            }
+            for (std::size_t k = 0; k < Oversampling; ++k)
+            {
+                put16_(pdo + 2 * k, static_cast<std::uint16_t>(frame_[ch][k]));
+            }
+        }
+        commitInputs();
+    }
+
+    bool onSdoUpload(std::uint16_t index, std::uint8_t subindex,
+                     std::uint32_t& value) const noexcept override
+    {
+        if (subindex == 0 && index == 0x1000u)
+        {
+            value = Traits::device_type;
+            return true;
+        }
+        if (subindex == 0 && index == 0x1008u)
+        {
+            value = expeditedString(Traits::name);
+            return true;
+        }
+        if (index == kTxAssign && subindex <= Channels)
+        {
+            value = subindex == 0 ? static_cast<std::uint32_t>(Channels)
+                                  : kTxPdoBase + kTxPdoStride * (subindex - 1u);
+            return true;
+        }
+        if (index >= kTxPdoBase && index < kTxPdoBase + kTxPdoStride * Channels &&
+            (index - kTxPdoBase) % kTxPdoStride == 0)
+        {
+            auto const ch       = static_cast<std::uint32_t>((index - kTxPdoBase) / kTxPdoStride);
+            auto const object   = static_cast<std::uint32_t>(kInputBase + kObjectSpan * ch) << 16;
+            std::size_t const n = kStandardPdo ? 2 : Oversampling;
+            if (subindex > n)
+            {
+                return false;
+            }
+            if (subindex == 0)
+            {
+                value = static_cast<std::uint32_t>(n);
+            }
+            else if constexpr (kStandardPdo)
+            {
+                value = object | (subindex == 1 ? kStatusSubindex : kValueSubindex) << 8 | 16u;
+            }
+            else
+            {
+                value = object | static_cast<std::uint32_t>(subindex) << 8 | 16u;
+            }
+            return true;
+        }
+        if (index >= kInputBase && index < kInputBase + kObjectSpan * Channels &&
+            (index - kInputBase) % kObjectSpan == 0)
+        {
+            std::size_t const ch = (index - kInputBase) / kObjectSpan;
+            if constexpr (kStandardPdo)
+            {
+                if (subindex == kStatusSubindex || subindex == kValueSubindex)
+                {
+                    value = subindex == kStatusSubindex
+                                ? status_[ch]
+                                : static_cast<std::uint16_t>(frame_[ch][0]);
+                    return true;
+                }
+            }
+            else if (subindex >= 1 && subindex <= Oversampling)
+            {
+                value = static_cast<std::uint16_t>(frame_[ch][subindex - 1u]);
+                return true;
+            }
+        }
+        return false;
+    }
+
+  private:
+    static void put16_(std::uint8_t* p, std::uint16_t v) noexcept
+    {
+        p[0] = static_cast<std::uint8_t>(v & 0xFF);
+        p[1] = static_cast<std::uint8_t>(v >> 8);
+    }
+
+    std::shared_ptr<WaveformBank> bank_;
+    WaveformBank::Lane first_lane_;
+    std::uint16_t toggle_{0};
+    std::array<std::array<std::int16_t, Oversampling>, Channels> frame_{};
+    std::array<std::uint16_t, Channels> status_{};
+};
+
+// Common terminals
+struct EL3004Traits : AnalogInputTraits
+{
+    static constexpr std::uint32_t product_code = 0x0BBC3052u;
+    static constexpr char const* name           = "EL3004";
+};
+struct EL3064Traits : AnalogInputTraits
+{
+    static constexpr std::uint32_t product_code = 0x0BF83052u;
+    static constexpr char const* name           = "EL3064";
+    static constexpr bool bipolar               = false; // 0..10 V
+};
+struct EL3104Traits : AnalogInputTraits
+{
+    static constexpr std::uint32_t product_code = 0x0C203052u;
+    static constexpr char const* name           = "EL3104";
+};
+struct EL3702Traits : AnalogInputTraits
+{
+    static constexpr std::uint32_t product_code = 0x0E763052u;
+    static constexpr char const* name           = "EL3702";
+};
+
+using EL3004Slave = AnalogInputSlave<4, 1, EL3004Traits>;
+using EL3064Slave = AnalogInputSlave<4, 1, EL3064Traits>;
+using EL3104Slave = AnalogInputSlave<4, 1, EL3104Traits>;
+// 2 channels, Oversampling samples per cycle (10 = 10 kHz at the default bank and cycle)
+template <std::size_t Oversampling = 10>
+using EL3702Slave = AnalogInputSlave<2, Oversampling, EL3702Traits>;
+
+} // namespace ethercat_sim::simulation::slaves
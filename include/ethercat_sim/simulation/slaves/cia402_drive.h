@@ -0,0 +1,548 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+#include "ethercat_sim/simulation/axis_bank.h"
+#include "ethercat_sim/simulation/slaves/terminal_traits.h"
+#include "ethercat_sim/simulation/virtual_slave.h"
+
+namespace ethercat_sim::simulation::slaves
+{
+
+// CiA 402 servo drive (one axis, EL7211-like identity) whose mechanics and servo loops are an
+// axis of a shared AxisBank: the bank integrates all axes of all drives in one batch per step,
+// the drive only runs its state machine and exchanges the process data, so a 64-axis machine at
+// 4 kHz costs one vectorized pass per step.
+//
+// Device control follows the CiA 402 state machine (controlword 0x6040, statusword 0x6041):
+// Switch on disabled -> (Shutdown) Ready to switch on -> (Switch on) Switched on -> (Enable
+// operation) Operation enabled, with Disable voltage, Quick stop (decelerates, then Switch on
+// disabled) and Fault (left on a rising fault reset bit). Enable operation in Ready to switch on
+// passes Switched on in the same cycle. Only Operation enabled drives the axis, in the mode
+// displayed by 0x6061:
+// - CSP (8): follows 0x607A, with a velocity feed-forward from the change of 0x607A per cycle
+//   (0x60C2, the interpolation period); exceeding the following error window 0x6065 (0xFFFFFFFF
+//   = off) for longer than 0x6066 ms faults the drive. 0x607A and 0x6064 wrap as 32-bit values,
+//   the error is their wrapped difference
+// - CSV (9): follows 0x60FF
+// - CST (10): applies 0x6071
+//
+// Process data: RxPDO 0x1600 (SM2) controlword, target position, target velocity, target torque,
+// modes of operation; TxPDO 0x1A00 (SM3) statusword, position actual 0x6064, velocity actual
+// 0x606C, torque actual 0x6077, modes of operation display; each padded to 14 bytes. Targets
+// that arrive during a step take effect from the next one, as a drive latching them at SYNC.
+class Cia402DriveSlave final : public VirtualSlave
+{
+  public:
+    enum class State : std::uint16_t // statusword bits 0-3, 5, 6
+    {
+        NotReadyToSwitchOn = 0x0000u,
+        SwitchOnDisabled   = 0x0040u,
+        ReadyToSwitchOn    = 0x0021u,
+        SwitchedOn         = 0x0023u,
+        OperationEnabled   = 0x0027u,
+        QuickStopActive    = 0x0007u,
+        Fault              = 0x0008u
+    };
+
+    static constexpr std::int8_t kModeCsp = 8;
+    static constexpr std::int8_t kModeCsv = 9;
+    static constexpr std::int8_t kModeCst = 10;
+
+    // Controlword
+    static constexpr std::uint16_t kSwitchOn        = 0x0001u;
+    static constexpr std::uint16_t kEnableVoltage   = 0x0002u;
+    static constexpr std::uint16_t kQuickStop       = 0x0004u; // active low
+    static constexpr std::uint16_t kEnableOperation = 0x0008u;
+    static constexpr std::uint16_t kFaultReset      = 0x0080u;
+    // Statusword, on top of the State bits
+    static constexpr std::uint16_t kVoltageEnabled = 0x0010u;
+    static constexpr std::uint16_t kRemote         = 0x0200u;
+    static constexpr std::uint16_t kTargetReached  = 0x0400u;
+    static constexpr std::uint16_t kFollowsTarget  = 0x1000u; // CSP/CSV/CST: target value used
+    static constexpr std::uint16_t kFollowingError = 0x2000u;
+
+    static constexpr std::uint16_t kErrorFollowing = 0x8611u; // 0x603F
+    static constexpr std::uint32_t kUnlimited      = 0xFFFFFFFFu;
+
+    static constexpr std::uint32_t kVendorId     = TerminalTraits::vendor_id;
+    static constexpr std::uint32_t kProductCode  = 0x1C2B3052u; // EL7211
+    static constexpr std::uint32_t kDeviceType   = 0x00020192u; // CiA 402 servo drive
+    static constexpr char const* kName           = "EL7211";
+    static constexpr std::uint32_t kSupportedOps = 0x00000380u; // 0x6502: CSP, CSV, CST
+
+    static constexpr std::uint16_t kOutputsAddress = TerminalTraits::outputs_address;
+    static constexpr std::uint16_t kInputsAddress  = TerminalTraits::inputs_address;
+    static constexpr std::size_t kOutputBytes      = 14;
+    static constexpr std::size_t kInputBytes       = 14;
+
+    Cia402DriveSlave(std::uint16_t address, std::shared_ptr<AxisBank> bank,
+                     AxisBank::Params const& axis = AxisBank::Params{},
+                     std::chrono::nanoseconds cycle = AxisBank::kDefaultStep)
+        : VirtualSlave(address, kVendorId, kProductCode, kName), bank_(std::move(bank)),
+          axis_(bank_->addAxis(axis)), cycle_(cycle.count() > 0 ? cycle : AxisBank::kDefaultStep)
+    {
+        configureProcessData(kOutputsAddress, kOutputBytes, kInputsAddress, kInputBytes, true);
+        setInputPDOMapped(true);
+        setUpdatePeriod(cycle_);
+    }
+
+    State state() const noexcept
+    {
+        return state_;
+    }
+    std::uint16_t statusword() const noexcept
+    {
+        return statusword_;
+    }
+    std::int8_t modeDisplay() const noexcept
+    {
+        return mode_display_;
+    }
+    std::uint16_t errorCode() const noexcept
+    {
+        return error_code_;
+    }
+    AxisBank::Axis axis() const noexcept
+    {
+        return axis_;
+    }
+    AxisBank const& bank() const noexcept
+    {
+        return *bank_;
+    }
+
+    // Raises a drive error (0x603F, e.g. from a test scenario); the drive enters Fault in its
+    // next routine. Any thread.
+    void fault(std::uint16_t error_code) noexcept
+    {
+        pending_error_.store(error_code != 0 ? error_code : 0xFF00u, std::memory_order_relaxed);
+        requestRoutine();
+    }
+
+  protected:
+    void onRoutine() noexcept override
+    {
+        auto const now = SlaveScheduler::Clock::now();
+        if (updateOutputs())
+        {
+            readOutputs_(outputs());
+        }
+        if (auto const error = pending_error_.exchange(0, std::memory_order_relaxed))
+        {
+            enterFault_(error);
+        }
+        applyControlword_();
+        bank_->advanceTo(now); // a no-op for all but the first drive of the step
+        supervise_(now);
+        commandAxis_(now); // for the steps up to the next routine
+        publish_();
+    }
+
+    bool onSdoUpload(std::uint16_t index, std::uint8_t subindex,
+                     std::uint32_t& value) const noexcept override
+    {
+        if (index == 0x1C12u || index == 0x1C13u)
+        {
+            value = subindex == 0 ? 1u : (index == 0x1C12u ? 0x1600u : 0x1A00u);
+            return subindex <= 1;
+        }
+        if (index == 0x1600u || index == 0x1A00u)
+        {
+            auto const& map = index == 0x1600u ? kRxMapping : kTxMapping;
+            if (subindex > kMappedEntries)
+            {
+                return false;
+            }
+            value = subindex == 0 ? kMappedEntries : map[subindex - 1u];
+            return true;
+        }
+        if (index == 0x60C2u && (subindex == 1 || subindex == 2))
+        {
+            // Interpolation period: 0x60C2:01 x 10^(0x60C2:02) s, here in microseconds
+            auto const us = std::chrono::duration_cast<std::chrono::microseconds>(cycle_);
+            value         = subindex == 1 ? static_cast<std::uint32_t>(us.count()) : 0xFAu; // -6
+            return true;
+        }
+        if (subindex != 0)
+        {
+            return false;
+        }
+        auto const& bank = *bank_;
+        switch (index)
+        {
+        case 0x1000u:
+            value = kDeviceType;
+            return true;
+        case 0x1008u:
+            value = expeditedString(kName);
+            return true;
+        case 0x603Fu:
+            value = error_code_;
+            return true;
+        case 0x6040u:
+            value = controlword_;
+            return true;
+        case 0x6041u:
+            value = statusword_;
+            return true;
+        case 0x6060u:
+            value = static_cast<std::uint8_t>(mode_);
+            return true;
+        case 0x6061u:
+            value = static_cast<std::uint8_t>(mode_display_);
+            return true;
+        case 0x6064u:
+            value = static_cast<std::uint32_t>(toCounts_(bank.position(axis_)));
+            return true;
+        case 0x6065u:
+            value = following_window_;
+            return true;
+        case 0x6066u:
+            value = following_timeout_ms_;
+            return true;
+        case 0x6067u:
+            value = position_window_;
+            return true;
+        case 0x606Cu:
+            value = static_cast<std::uint32_t>(toCounts_(bank.velocity(axis_)));
+            return true;
+        case 0x606Du:
+            value = velocity_window_;
+            return true;
+        case 0x6071u:
+            value = static_cast<std::uint16_t>(target_torque_);
+            return true;
+        case 0x6077u:
+            value = static_cast<std::uint16_t>(toTorque_(bank.torque(axis_)));
+            return true;
+        case 0x607Au:
+            value = static_cast<std::uint32_t>(target_position_);
+            return true;
+        case 0x60FFu:
+            value = static_cast<std::uint32_t>(target_velocity_);
+            return true;
+        case 0x6502u:
+            value = kSupportedOps;
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    bool onSdoDownload(std::uint16_t index, std::uint8_t subindex, std::uint32_t value,
+                       std::uint8_t /*nbytes*/) noexcept override
+    {
+        if (subindex != 0)
+        {
+            return false;
+        }
+        switch (index)
+        {
+        case 0x6040u:
+            controlword_ = static_cast<std::uint16_t>(value);
+            break;
+        case 0x6060u:
+            mode_ = static_cast<std::int8_t>(value);
+            break;
+        case 0x6065u:
+            following_window_ = value;
+            break;
+        case 0x6066u:
+            following_timeout_ms_ = static_cast<std::uint16_t>(value);
+            break;
+        case 0x6067u:
+            position_window_ = value;
+            break;
+        case 0x606Du:
+            velocity_window_ = value;
+            break;
+        case 0x6071u:
+            target_torque_ = static_cast<std::int16_t>(value);
+            break;
+        case 0x607Au:
+            setTargetPosition_(static_cast<std::int32_t>(value));
+            break;
+        case 0x60FFu:
+            target_velocity_ = static_cast<std::int32_t>(value);
+            break;
+        default:
+            return false;
+        }
+        requestRoutine();
+        return true;
+    }
+
+  private:
+    static constexpr std::uint8_t kMappedEntries = 6;
+    static constexpr std::uint32_t kRxMapping[kMappedEntries] = {
+        0x60400010u, 0x607A0020u, 0x60FF0020u, 0x60710010u, 0x60600008u, 0x00000008u};
+    static constexpr std::uint32_t kTxMapping[kMappedEntries] = {
+        0x60410010u, 0x60640020u, 0x606C0020u, 0x60770010u, 0x60610008u, 0x00000008u};
+
+    static std::uint16_t get16_(std::uint8_t const* p) noexcept
+    {
+        return static_cast<std::uint16_t>(p[0] | (p[1] << 8));
+    }
+    static std::uint32_t get32_(std::uint8_t const* p) noexcept
+    {
+        return static_cast<std::uint32_t>(get16_(p)) |
+               static_cast<std::uint32_t>(get16_(p + 2)) << 16;
+    }
+    static void put16_(std::uint8_t* p, std::uint16_t v) noexcept
+    {
+        p[0] = static_cast<std::uint8_t>(v & 0xFF);
+        p[1] = static_cast<std::uint8_t>(v >> 8);
+    }
+    static void put32_(std::uint8_t* p, std::uint32_t v) noexcept
+    {
+        put16_(p, static_cast<std::uint16_t>(v & 0xFFFF));
+        put16_(p + 2, static_cast<std::uint16_t>(v >> 16));
+    }
+    // Position and velocity wrap like the 32-bit objects they are reported in
+    static std::int32_t toCounts_(double v) noexcept
+    {
+        return static_cast<std::int32_t>(static_cast<std::uint32_t>(std::llround(v)));
+    }
+    static std::int16_t toTorque_(double v) noexcept
+    {
+        return static_cast<std::int16_t>(std::lround(v < -32767.0 ? -32767.0
+                                                      : (v > 32767.0 ? 32767.0 : v)));
+    }
+
+    void readOutputs_(std::uint8_t const* image) noexcept
+    {
+        controlword_ = get16_(image);
+        setTargetPosition_(static_cast<std::int32_t>(get32_(image + 2)));
+        target_velocity_ = static_cast<std::int32_t>(get32_(image + 6));
+        target_torque_   = static_cast<std::int16_t>(get16_(image + 10));
+        mode_            = static_cast<std::int8_t>(image[12]);
+    }
+
+    // New CSP set-point: the feed-forward is its change over one interpolation period, applied
+    // for that period
+    void setTargetPosition_(std::int32_t target) noexcept
+    {
+        auto const delta = static_cast<std::int32_t>(static_cast<std::uint32_t>(target) -
+                                                     static_cast<std::uint32_t>(target_position_));
+        feed_forward_ =
+            static_cast<double>(delta) / std::chrono::duration<double>(cycle_).count();
+        feed_forward_until_ = SlaveScheduler::Clock::now() + cycle_;
+        target_position_    = target;
+    }
+
+    // 0x607A - 0x6064 in the wrapping 32-bit arithmetic of the objects; the axis itself does not
+    // wrap, so a target past the int32 range is still the short way ahead
+    double positionError_() const noexcept
+    {
+        auto const actual = static_cast<std::uint32_t>(toCounts_(bank_->position(axis_)));
+        return static_cast<double>(
+            static_cast<std::int32_t>(static_cast<std::uint32_t>(target_position_) - actual));
+    }
+
+    void enterFault_(std::uint16_t error_code) noexcept
+    {
+        state_      = State::Fault;
+        error_code_ = error_code;
+    }
+
+    void applyControlword_() noexcept
+    {
+        std::uint16_t const cw = controlword_;
+        bool const reset_edge  = (cw & kFaultReset) != 0 && (last_controlword_ & kFaultReset) == 0;
+        last_controlword_      = cw;
+
+        if (state_ == State::NotReadyToSwitchOn) // self-test passed
+        {
+            state_ = State::SwitchOnDisabled;
+        }
+        if (state_ == State::Fault)
+        {
+            if (reset_edge)
+            {
+                state_      = State::SwitchOnDisabled;
+                error_code_ = 0;
+                following_  = false;
+            }
+            return;
+        }
+
+        bool const disable_voltage = (cw & (kFaultReset | kEnableVoltage)) == 0;
+        bool const quick_stop =
+            (cw & (kFaultReset | kQuickStop | kEnableVoltage)) == kEnableVoltage;
+        bool const shutdown = (cw & (kFaultReset | kQuickStop | kEnableVoltage | kSwitchOn)) ==
+                              (kQuickStop | kEnableVoltage);
+        std::uint16_t const enable_bits = cw & (kFaultReset | kEnableOperation | kQuickStop |
+                                                kEnableVoltage | kSwitchOn);
+        bool const switch_on = enable_bits == (kQuickStop | kEnableVoltage | kSwitchOn);
+        bool const enable    = enable_bits == (kEnableOperation | kQuickStop | kEnableVoltage |
+                                               kSwitchOn);
+
+        switch (state_)
+        {
+        case State::SwitchOnDisabled:
+            state_ = shutdown ? State::ReadyToSwitchOn : state_;
+            break;
+        case State::ReadyToSwitchOn: // Enable operation runs transitions 3 and 4 at once
+            state_ = disable_voltage || quick_stop ? State::SwitchOnDisabled
+                     : switch_on                   ? State::SwitchedOn
+                     : enable                      ? State::OperationEnabled
+                                                   : state_;
+            break;
+        case State::SwitchedOn:
+            state_ = disable_voltage || quick_stop ? State::SwitchOnDisabled
+                     : shutdown                    ? State::ReadyToSwitchOn
+                     : enable                      ? State::OperationEnabled
+                                                   : state_;
+            break;
+        case State::OperationEnabled:
+            state_ = disable_voltage ? State::SwitchOnDisabled
+                     : quick_stop    ? State::QuickStopActive
+                     : shutdown      ? State::ReadyToSwitchOn
+                     : switch_on     ? State::SwitchedOn
+                                     : state_;
+            break;
+        case State::QuickStopActive:
+            state_ = disable_voltage ? State::SwitchOnDisabled : state_;
+            break;
+        default:
+            break;
+        }
+
+        if (mode_ == kModeCsp || mode_ == kModeCsv || mode_ == kModeCst)
+        {
+            mode_display_ = mode_;
+        }
+    }
+
+    void commandAxis_(SlaveScheduler::Clock::time_point now) noexcept
+    {
+        using Mode = AxisBank::Mode;
+        if (state_ == State::QuickStopActive)
+        {
+            bank_->command(axis_, Mode::Velocity, 0.0, 0.0, 0.0);
+            return;
+        }
+        if (state_ != State::OperationEnabled)
+        {
+            bank_->command(axis_, Mode::Off, 0.0, 0.0, 0.0);
+            return;
+        }
+        switch (mode_display_)
+        {
+        case kModeCsp:
+            bank_->command(axis_, Mode::Position, bank_->position(axis_) + positionError_(),
+                           now < feed_forward_until_ ? feed_forward_ : 0.0, 0.0);
+            break;
+        case kModeCsv:
+            bank_->command(axis_, Mode::Velocity, 0.0, target_velocity_, 0.0);
+            break;
+        case kModeCst:
+            bank_->command(axis_, Mode::Torque, 0.0, 0.0, target_torque_);
+            break;
+        default:
+            bank_->command(axis_, Mode::Off, 0.0, 0.0, 0.0);
+            break;
+        }
+    }
+
+    // Following error, end of a quick stop, target reached
+    void supervise_(SlaveScheduler::Clock::time_point now) noexcept
+    {
+        double const position = bank_->position(axis_);
+        double const velocity = bank_->velocity(axis_);
+        bool const enabled    = state_ == State::OperationEnabled;
+        double const error    = std::fabs(positionError_());
+
+        bool const exceeded = enabled && mode_display_ == kModeCsp &&
+                              following_window_ != kUnlimited &&
+                              error > static_cast<double>(following_window_);
+        if (!exceeded)
+        {
+            following_ = false;
+        }
+        else if (!following_)
+        {
+            following_       = true;
+            following_since_ = now;
+        }
+        else if (now - following_since_ >= std::chrono::milliseconds(following_timeout_ms_))
+        {
+            enterFault_(kErrorFollowing);
+        }
+
+        bool const standstill = std::fabs(velocity) <= static_cast<double>(velocity_window_);
+        if (state_ == State::QuickStopActive && standstill)
+        {
+            state_ = State::SwitchOnDisabled;
+        }
+        target_reached_ =
+            state_ == State::QuickStopActive
+                ? standstill
+                : enabled && ((mode_display_ == kModeCsp &&
+                               error <= static_cast<double>(position_window_)) ||
+                              (mode_display_ == kModeCsv &&
+                               std::fabs(static_cast<double>(target_velocity_) - velocity) <=
+                                   static_cast<double>(velocity_window_)));
+    }
+
+    void publish_() noexcept
+    {
+        bool const powered = state_ == State::ReadyToSwitchOn || state_ == State::SwitchedOn ||
+                             state_ == State::OperationEnabled ||
+                             state_ == State::QuickStopActive;
+        bool const driving = state_ == State::OperationEnabled || state_ == State::QuickStopActive;
+        bool const follows = state_ == State::OperationEnabled &&
+                             (mode_display_ == kModeCsp || mode_display_ == kModeCsv ||
+                              mode_display_ == kModeCst);
+        statusword_ = static_cast<std::uint16_t>(
+            static_cast<std::uint16_t>(state_) | kRemote | (powered ? kVoltageEnabled : 0) |
+            (target_reached_ ? kTargetReached : 0) | (follows ? kFollowsTarget : 0) |
+            (following_ ? kFollowingError : 0));
+
+        std::uint8_t* image = inputsBuffer();
+        put16_(image, statusword_);
+        put32_(image + 2, static_cast<std::uint32_t>(toCounts_(bank_->position(axis_))));
+        put32_(image + 6, static_cast<std::uint32_t>(toCounts_(bank_->velocity(axis_))));
+        put16_(image + 10, driving ? static_cast<std::uint16_t>(toTorque_(bank_->torque(axis_)))
+                                   : 0u); // power stage off
+        image[12] = static_cast<std::uint8_t>(mode_display_);
+        image[13] = 0;
+        commitInputs();
+    }
+
+    std::shared_ptr<AxisBank> bank_;
+    AxisBank::Axis axis_;
+    std::chrono::nanoseconds cycle_;
+
+    State state_{State::NotReadyToSwitchOn};
+    std::uint16_t controlword_{0};
+    std::uint16_t last_controlword_{0};
+    std::uint16_t statusword_{0};
+    std::uint16_t error_code_{0};
+    std::atomic<std::uint16_t> pending_error_{0};
+    std::int8_t mode_{0};
+    std::int8_t mode_display_{0};
+
+    std::int32_t target_position_{0};
+    std::int32_t target_velocity_{0};
+    std::int16_t target_torque_{0};
+    double feed_forward_{0.0}; // counts/s
+    SlaveScheduler::Clock::time_point feed_forward_until_{};
+
+    std::uint32_t following_window_{kUnlimited};
+    std::uint16_t following_timeout_ms_{0};
+    std::uint32_t position_window_{10};
+    std::uint32_t velocity_window_{10};
+    bool following_{false};
+    bool target_reached_{false};
+    SlaveScheduler::Clock::time_point following_since_{};
+};
+
+} // namespace ethercat_sim::simulation::slaves
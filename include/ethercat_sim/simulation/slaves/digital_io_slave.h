@@ -0,0 +1,362 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include "ethercat_sim/simulation/slaves/terminal_traits.h"
+#include "ethercat_sim/simulation/virtual_slave.h"
+
+namespace ethercat_sim::simulation::slaves
+{
+
+// Defaults for DigitalIoSlave traits. A terminal derives from it and supplies product_code and
+// name; everything else is optional:
+//   struct EL1008Traits : DigitalIoTraits
+//   {
+//       static constexpr std::uint32_t product_code = 0x03F03052u;
+//       static constexpr char const* name           = "EL1008";
+//       static constexpr std::chrono::microseconds filter{3000};
+//   };
+struct DigitalIoTraits : TerminalTraits
+{
+    // Input filter: a level reaches the process image once it has been stable this long; zero
+    // passes raw levels straight through
+    static constexpr std::chrono::microseconds filter{0};
+};
+
+namespace detail
+{
+constexpr std::uint32_t channelMask(std::size_t n) noexcept
+{
+    return n >= 32 ? ~std::uint32_t{0} : (std::uint32_t{1} << n) - 1u;
+}
+
+// One PDO per channel, each mapping subindex 1 of the channel's object as a single bit
+// (index << 16 | subindex << 8 | bit length)
+template <std::size_t N>
+constexpr std::array<std::uint32_t, N> channelMapping(std::uint16_t base,
+                                                     std::size_t first) noexcept
+{
+    std::array<std::uint32_t, N> entries{};
+    for (std::size_t i = 0; i < N; ++i)
+    {
+        auto const index = static_cast<std::uint32_t>(base + 0x10u * (first + i));
+        entries[i]       = (index << 16) | (0x01u << 8) | 1u;
+    }
+    return entries;
+}
+} // namespace detail
+
+// Generic EL1xxx / EL2xxx / mixed digital I/O terminal: Inputs input channels followed by Outputs
+// output channels, numbered from 0 in that order as in the Beckhoff ESIs. Identity, OD and PDO
+// layout follow from the template arguments at compile time: channel n owns TxPDO 0x1A00+n
+// (0x6000+0x10*n:01, 1 bit) or RxPDO 0x1600+n (0x7000+0x10*n:01, 1 bit), assigned in channel
+// order to SM3 / SM2, which hold the channels packed LSB first. 0x8000:00 is the input invert
+// mask, as on the EL1258.
+//
+// Channel state lives in packed words, one bit per channel: inverting is a single XOR and the
+// input filter is a 2-bit vertical counter, so every channel is filtered at once without
+// branches. While any input is unsettled the slave samples itself filter / 3 apart on the
+// simulator timer wheel; a level that survives four samples in a row (about Traits::filter) is
+// taken over. Settled terminals cost nothing per cycle.
+//
+// Threads: setInput()/setInputs() from one stimulus thread, everything else from the simulation
+// thread; the getters may be called from any thread.
+template <std::size_t Inputs, std::size_t Outputs, typename Traits>
+class DigitalIoSlave final : public VirtualSlave
+{
+    static_assert(Inputs + Outputs > 0, "a terminal needs at least one channel");
+    static_assert(Inputs <= 32 && Outputs <= 32, "channels are packed into 32-bit words");
+
+  public:
+    using Bits = std::uint32_t;
+
+    static constexpr std::size_t kInputs      = Inputs;
+    static constexpr std::size_t kOutputs     = Outputs;
+    static constexpr std::size_t kInputBytes  = (Inputs + 7) / 8;
+    static constexpr std::size_t kOutputBytes = (Outputs + 7) / 8;
+    static constexpr Bits kInputMask          = detail::channelMask(Inputs);
+    static constexpr Bits kOutputMask         = detail::channelMask(Outputs);
+    static constexpr bool kFiltered           = Traits::filter.count() > 0;
+
+    static constexpr std::uint16_t kRxPdoBase   = 0x1600u;
+    static constexpr std::uint16_t kTxPdoBase   = 0x1A00u;
+    static constexpr std::uint16_t kRxAssign    = 0x1C12u;
+    static constexpr std::uint16_t kTxAssign    = 0x1C13u;
+    static constexpr std::uint16_t kInputBase   = 0x6000u;
+    static constexpr std::uint16_t kOutputBase  = 0x7000u;
+    static constexpr std::uint16_t kInvertMask  = 0x8000u;
+    static constexpr std::uint16_t kObjectSpan  = 0x10u;
+    static constexpr std::uint16_t kFirstOutput = static_cast<std::uint16_t>(Inputs);
+
+    static constexpr std::array<std::uint32_t, Inputs> kTxPdoEntries =
+        detail::channelMapping<Inputs>(kInputBase, 0);
+    static constexpr std::array<std::uint32_t, Outputs> kRxPdoEntries =
+        detail::channelMapping<Outputs>(kOutputBase, Inputs);
+
+    explicit DigitalIoSlave(std::uint16_t address)
+        : VirtualSlave(address, Traits::vendor_id, Traits::product_code, Traits::name)
+    {
+        configureProcessData(Traits::outputs_address, kOutputBytes, Traits::inputs_address,
+                             kInputBytes);
+        setInputPDOMapped(Inputs > 0);
+    }
+
+    // Raw level of input channel 0..Inputs-1; it reaches the process image through the filter
+    void setInput(std::size_t channel, bool value) noexcept
+    {
+        if (channel < Inputs)
+        {
+            Bits const bit = Bits{1} << channel;
+            setInputs(value ? bit : 0, bit);
+        }
+    }
+    // Sets the channels in mask to the matching bits of levels in one step
+    void setInputs(Bits levels, Bits mask) noexcept
+    {
+        mask &= kInputMask;
+        Bits const old = raw_.load(std::memory_order_relaxed);
+        Bits const raw = (old & ~mask) | (levels & mask);
+        if (raw != old)
+        {
+            raw_.store(raw, std::memory_order_relaxed);
+            requestRoutine();
+        }
+    }
+    Bits rawInputs() const noexcept
+    {
+        return raw_.load(std::memory_order_relaxed);
+    }
+
+    // Filtered, inverted inputs as the master sees them (bit n = channel n)
+    Bits inputBits() const noexcept
+    {
+        return (filteredInputs_() ^ invert_.load(std::memory_order_relaxed)) & kInputMask;
+    }
+    bool input(std::size_t channel) const noexcept
+    {
+        return channel < Inputs && ((inputBits() >> channel) & 1u) != 0;
+    }
+
+    // Last output image received through SM2 (bit n = output channel n, i.e. channel Inputs+n)
+    Bits outputBits() const noexcept
+    {
+        return outputs_.load(std::memory_order_relaxed);
+    }
+    bool output(std::size_t channel) const noexcept
+    {
+        return channel < Outputs && ((outputBits() >> channel) & 1u) != 0;
+    }
+
+    bool readDigitalInputsBitfield(std::uint32_t& bits_out) const noexcept override
+    {
+        bits_out = inputBits();
+        return Inputs > 0;
+    }
+
+  protected:
+    void onRoutine() noexcept override
+    {
+        if constexpr (Outputs > 0)
+        {
+            if (updateOutputs())
+            {
+                Bits bits = 0;
+                for (std::size_t i = 0; i < kOutputBytes; ++i)
+                {
+                    bits |= static_cast<Bits>(outputs()[i]) << (8 * i);
+                }
+                outputs_.store(bits & kOutputMask, std::memory_order_relaxed);
+            }
+        }
+        if constexpr (kFiltered)
+        {
+            sampleInputs_(SlaveScheduler::Clock::now());
+        }
+    }
+
+    bool onSdoUpload(std::uint16_t index, std::uint8_t subindex,
+                     std::uint32_t& value) const noexcept override
+    {
+        if (subindex == 0)
+        {
+            switch (index)
+            {
+            case 0x1000u:
+                value = Traits::device_type;
+                return true;
+            case 0x1008u:
+                value = expeditedString(Traits::name);
+                return true;
+            case 0x1018u:
+                value = 4; // identity entries, served by VirtualSlave
+                return true;
+            case kInvertMask:
+                value = invert_.load(std::memory_order_relaxed);
+                return true;
+            default:
+                break;
+            }
+        }
+        if (index == kTxAssign || index == kRxAssign)
+        {
+            bool const tx         = index == kTxAssign;
+            std::size_t const n   = tx ? Inputs : Outputs;
+            std::uint16_t const b = tx ? kTxPdoBase : kRxPdoBase + kFirstOutput;
+            if (subindex > n)
+            {
+                return false;
+            }
+            value = subindex == 0 ? static_cast<std::uint32_t>(n) : b + subindex - 1u;
+            return true;
+        }
+        std::size_t channel = 0;
+        if (channelOf_(index, kTxPdoBase, 1, channel) && channel < Inputs)
+        {
+            return entry_(subindex, kTxPdoEntries[channel], value);
+        }
+        if (channelOf_(index, kRxPdoBase, 1, channel) && channel >= Inputs &&
+            channel - Inputs < Outputs)
+        {
+            return entry_(subindex, kRxPdoEntries[channel - Inputs], value);
+        }
+        if (channelOf_(index, kInputBase, kObjectSpan, channel) && channel < Inputs)
+        {
+            return entry_(subindex, (inputBits() >> channel) & 1u, value);
+        }
+        if (channelOf_(index, kOutputBase, kObjectSpan, channel) && channel >= Inputs &&
+            channel - Inputs < Outputs)
+        {
+            return entry_(subindex, (outputBits() >> (channel - Inputs)) & 1u, value);
+        }
+        return false;
+    }
+
+    bool onSdoDownload(std::uint16_t index, std::uint8_t subindex, std::uint32_t value,
+                       std::uint8_t /*nbytes*/) noexcept override
+    {
+        if (index == kInvertMask && subindex == 0)
+        {
+            invert_.store(value & kInputMask, std::memory_order_relaxed);
+            requestRoutine(); // republish SM3
+            return true;
+        }
+        return false; // identity and the fixed PDO layout are read-only
+    }
+
+  private:
+    static bool channelOf_(std::uint16_t index, std::uint16_t base, std::uint16_t stride,
+                           std::size_t& channel) noexcept
+    {
+        if (index < base || (index - base) % stride != 0)
+        {
+            return false;
+        }
+        channel = static_cast<std::size_t>((index - base) / stride);
+        return channel < Inputs + Outputs;
+    }
+
+    // Record with one value at subindex 1
+    static bool entry_(std::uint8_t subindex, std::uint32_t entry, std::uint32_t& value) noexcept
+    {
+        if (subindex > 1)
+        {
+            return false;
+        }
+        value = subindex == 0 ? 1u : entry;
+        return true;
+    }
+
+    Bits filteredInputs_() const noexcept
+    {
+        if constexpr (kFiltered)
+        {
+            return filtered_.load(std::memory_order_relaxed);
+        }
+        else
+        {
+            return raw_.load(std::memory_order_relaxed);
+        }
+    }
+
+    // One filter step over all channels: a channel whose raw level differs from the filtered one
+    // counts down a 2-bit vertical counter (ct1_:ct0_, idle at 3) and toggles when it wraps; an
+    // agreeing sample resets it
+    void sampleInputs_(SlaveScheduler::Clock::time_point now) noexcept
+    {
+        Bits const raw = raw_.load(std::memory_order_relaxed);
+        Bits filtered  = filtered_.load(std::memory_order_relaxed);
+        if (now >= next_sample_)
+        {
+            Bits delta = filtered ^ raw;
+            ct0_       = ~(ct0_ & delta);
+            ct1_       = ct0_ ^ (ct1_ & delta);
+            delta &= ct0_ & ct1_;
+            filtered ^= delta;
+            filtered_.store(filtered, std::memory_order_relaxed);
+            next_sample_ = now + kSamplePeriod;
+        }
+        if (filtered != raw && wake_ != next_sample_)
+        {
+            wake_ = next_sample_;
+            requestRoutineAt(next_sample_);
+        }
+    }
+
+    // Four agreeing samples take over a level: the first when it changes, the fourth one filter
+    // time later
+    static constexpr std::chrono::nanoseconds kSamplePeriod =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(Traits::filter) / 3;
+
+    std::atomic<Bits> raw_{0};
+    std::atomic<Bits> filtered_{0};
+    std::atomic<Bits> invert_{0};
+    std::atomic<Bits> outputs_{0};
+
+    // Filter state, simulation thread only
+    Bits ct0_{~Bits{0}};
+    Bits ct1_{~Bits{0}};
+    SlaveScheduler::Clock::time_point next_sample_{};
+    SlaveScheduler::Clock::time_point wake_{};
+};
+
+// Common terminals; the filter times are the datasheet defaults
+struct EL1008Traits : DigitalIoTraits
+{
+    static constexpr std::uint32_t product_code = 0x03F03052u;
+    static constexpr char const* name           = "EL1008";
+    static constexpr std::chrono::microseconds filter{3000};
+};
+struct EL1809Traits : DigitalIoTraits
+{
+    static constexpr std::uint32_t product_code = 0x07113052u;
+    static constexpr char const* name           = "EL1809";
+    static constexpr std::chrono::microseconds filter{3000};
+};
+struct EL1859Traits : DigitalIoTraits
+{
+    static constexpr std::uint32_t product_code = 0x07433052u;
+    static constexpr char const* name           = "EL1859";
+    static constexpr std::chrono::microseconds filter{3000};
+};
+struct EL2008Traits : DigitalIoTraits
+{
+    static constexpr std::uint32_t product_code = 0x07D83052u;
+    static constexpr char const* name           = "EL2008";
+};
+struct EL2809Traits : DigitalIoTraits
+{
+    static constexpr std::uint32_t product_code = 0x0AF93052u;
+    static constexpr char const* name           = "EL2809";
+};
+
+using EL1008Slave = DigitalIoSlave<8, 0, EL1008Traits>;
+using EL1809Slave = DigitalIoSlave<16, 0, EL1809Traits>;
+using EL1859Slave = DigitalIoSlave<8, 8, EL1859Traits>;
+using EL2008Slave = DigitalIoSlave<0, 8, EL2008Traits>;
+using EL2809Slave = DigitalIoSlave<0, 16, EL2809Traits>;
+
+} // namespace ethercat_sim::simulation::slaves
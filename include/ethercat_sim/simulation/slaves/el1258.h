@@ -84,17 +84,17 @@ class EL1258Slave final : public VirtualSlave
         }
         if (index == el1258::OBJ_DEVICE_NAME && subindex == 0x00)
         {
-            value = pack4_(device_name_);
+            value = expeditedString(device_name_);
             return true;
         }
         if (index == el1258::OBJ_HARDWARE_VERSION && subindex == 0x00)
         {
-            value = pack4_(hardware_version_);
+            value = expeditedString(hardware_version_);
             return true;
         }
         if (index == el1258::OBJ_SOFTWARE_VERSION && subindex == 0x00)
         {
-            value = pack4_(software_version_);
+            value = expeditedString(software_version_);
             return true;
         }
         // 0x6000: Digital Inputs, subindex 1..8 -> boolean
@@ -262,6 +262,12 @@ class EL1258Slave final : public VirtualSlave
         {
             raw_di_[ch]      = v;
             last_change_[ch] = std::chrono::steady_clock::now();
+            requestRoutine();
+            if (debounce_ms_ != 0)
+            {
+                // Re-evaluate once the new level has been stable long enough
+                requestRoutineAt(last_change_[ch] + std::chrono::milliseconds(debounce_ms_));
+            }
         }
     }
 
@@ -294,17 +300,6 @@ class EL1258Slave final : public VirtualSlave
         return bits;
     }
 
-    // Pack first 4 characters into a 32-bit value (expedited SDO simplification)
-    uint32_t pack4_(const char* s) const noexcept
-    {
-        char buf[4] = {0, 0, 0, 0};
-        for (int i = 0; i < 4 && s && s[i]; ++i)
-            buf[i] = s[i];
-        uint32_t v = 0;
-        std::memcpy(&v, buf, sizeof(v));
-        return v;
-    }
-
     // Minimal identification strings (truncated to 4 bytes in expedited SDO)
     static constexpr uint32_t device_type_code_    = 0x00000000u;
     static constexpr const char* device_name_      = "EL1258";
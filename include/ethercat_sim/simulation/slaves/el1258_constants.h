@@ -37,6 +37,21 @@ inline constexpr uint16_t PDO_MAPPING_STRIDE  = 0x0004u;
 inline constexpr uint8_t PDO_ENTRY_BIT_LENGTH = 1u;
 inline constexpr uint16_t PDO_ASSIGN_TX       = 0x1C13u;
 
+// Multi-timestamping (MTI) process data, default "8 Ch. 10x" mapping of the ESI: per channel one
+// RxPDO 0x1600+n (0x7000+0x10*n) and one TxPDO 0x1A00+4*n (0x6001+0x10*n). The ESI puts SM2 at
+// 0x1200, which is the simulator's mailbox send window (0x1200, 512 bytes), so it moves past it.
+inline constexpr uint16_t SM2_ADDRESS               = 0x1400u;
+inline constexpr uint16_t SM3_ADDRESS               = 0x1900u;
+inline constexpr std::size_t MTI_EVENTS_PER_PDO     = 10;
+inline constexpr std::size_t MTI_OUTPUT_BYTES       = 4;  // Ctrl: buffer reset, order counter
+inline constexpr std::size_t MTI_INPUT_BYTES        = 48; // Status, event states, 10 x UDINT time
+inline constexpr std::size_t MTI_INPUT_TIMES_OFFSET = 8;
+inline constexpr std::size_t MTI_FIFO_DEPTH         = 64; // edges buffered per channel
+inline constexpr uint8_t MTI_STATUS_INPUT_STATE     = 0x01u;
+inline constexpr uint8_t MTI_STATUS_BUFFER_OVERFLOW = 0x02u;
+inline constexpr unsigned MTI_STATUS_CYCLE_SHIFT    = 6; // 2-bit input cycle counter
+inline constexpr uint8_t MTI_CTRL_BUFFER_RESET      = 0x01u;
+
 inline constexpr uint32_t CHANNEL_MASK     = 0xFFu;
 inline constexpr uint8_t STATUS_INPUT_HIGH = 0x01u;
 inline constexpr int DEBOUNCE_FILTER_MS    = 3;
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstdint>
+
+namespace ethercat_sim::simulation::slaves
+{
+
+// Defaults shared by the traits of the terminal models (DigitalIoTraits, AnalogInputTraits) and
+// the identity of the other Beckhoff models
+struct TerminalTraits
+{
+    static constexpr std::uint32_t vendor_id   = 0x00000002u; // Beckhoff
+    static constexpr std::uint32_t device_type = 0x00000000u;
+    // SM2 / SM3 windows; the ESI addresses (0x0F00 / 0x1000) collide with the simulated mailbox
+    static constexpr std::uint16_t outputs_address = 0x1400u;
+    static constexpr std::uint16_t inputs_address  = 0x1900u;
+};
+
+} // namespace ethercat_sim::simulation::slaves
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace ethercat_sim::simulation
+{
+
+// Hierarchical timer wheel on the simulation clock: 4 levels of 64 slots, level L slot spanning
+// 64^L ticks. Scheduling and cancelling are O(1); advancing fires only the slots that fall due and
+// cascades a coarser slot down once per 64 ticks of the level below. Deadlines are rounded up to
+// whole ticks, so a timer never fires early. Timers further out than 64^4 ticks (~28 min at the
+// default 100 us tick) park in the last level and are re-filed as time passes.
+//
+// Not thread safe: the owner serializes every call. Callbacks run from advanceTo() and may
+// schedule or cancel timers.
+class TimerWheel
+{
+  public:
+    using Clock    = std::chrono::steady_clock;
+    using Callback = std::function<void()>;
+    using TimerId  = std::uint64_t;
+
+    static constexpr TimerId kNoTimer = 0;
+    static constexpr std::chrono::nanoseconds kDefaultTick{std::chrono::microseconds(100)};
+
+    explicit TimerWheel(std::chrono::nanoseconds tick = kDefaultTick,
+                        Clock::time_point start     = Clock::now());
+
+    // One-shot at when; a deadline already passed fires on the next tick
+    TimerId scheduleAt(Clock::time_point when, Callback cb);
+    TimerId scheduleAfter(std::chrono::nanoseconds delay, Callback cb);
+    // Periodic, first at now() + period; period is rounded up to at least one tick
+    TimerId scheduleEvery(std::chrono::nanoseconds period, Callback cb);
+
+    // False when id already fired (one-shot), was cancelled or never existed
+    bool cancel(TimerId id) noexcept;
+
+    // Moves time forward to now and appends the callbacks of the timers that expired, in tick
+    // order, to due (periodic timers are re-armed with a copy). Returns how many were appended.
+    std::size_t expire(Clock::time_point now, std::vector<Callback>& due);
+    // expire() plus running the callbacks
+    std::size_t advanceTo(Clock::time_point now);
+
+    Clock::time_point now() const noexcept
+    {
+        return start_ + tick_ * now_tick_;
+    }
+    std::chrono::nanoseconds tick() const noexcept
+    {
+        return tick_;
+    }
+    std::size_t pending() const noexcept
+    {
+        return pending_;
+    }
+
+  private:
+    static constexpr unsigned kSlotBits  = 6;
+    static constexpr std::size_t kSlots  = std::size_t{1} << kSlotBits;
+    static constexpr std::size_t kLevels = 4;
+    static constexpr std::uint32_t kNil  = 0xFFFFFFFFu;
+
+    struct Node
+    {
+        Callback cb;
+        std::uint64_t expiry{0}; // absolute tick
+        std::uint64_t period{0}; // ticks, 0 = one-shot
+        std::uint32_t prev{kNil};
+        std::uint32_t next{kNil};
+        std::uint32_t generation{1};
+        std::uint16_t bucket{0}; // level * kSlots + slot
+        bool armed{false};
+    };
+
+    std::uint64_t ticksUntil_(Clock::time_point when) const noexcept;
+    std::uint64_t ticksOf_(std::chrono::nanoseconds d) const noexcept;
+    TimerId add_(std::uint64_t expiry, std::uint64_t period, Callback cb);
+    void file_(std::uint32_t idx) noexcept;
+    void unlink_(std::uint32_t idx) noexcept;
+    void release_(std::uint32_t idx) noexcept;
+    void cascade_(std::size_t level) noexcept;
+    void fireSlot_(std::vector<Callback>& due, std::size_t& fired);
+
+    Clock::time_point start_;
+    std::chrono::nanoseconds tick_;
+    std::uint64_t now_tick_{0};
+    std::size_t pending_{0};
+    std::array<std::uint32_t, kLevels * kSlots> heads_;
+    std::array<std::uint64_t, kLevels> occupied_{}; // bit per non-empty slot
+    std::vector<Node> nodes_;
+    std::vector<std::uint32_t> free_;
+};
+
+} // namespace ethercat_sim::simulation
@@ -1,14 +1,22 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cstdint>
 #include <cstring>
+#include <functional>
 #include <iostream>
+#include <memory>
 #include <string>
 #include <vector>
 
 #include "kickcat/protocol.h"
 
+#include "ethercat_sim/framework/concurrency/triple_buffer.h"
+#include "ethercat_sim/simulation/register_map.h"
+#include "ethercat_sim/simulation/slave_scheduler.h"
+#include "ethercat_sim/simulation/slave_state.h"
 #include "framework/logger/logger.h"
 
 namespace ethercat_sim::simulation
@@ -42,12 +50,14 @@ class VirtualSlave
         mb_send_size_   = 512;
         mb_out_.assign(mb_send_size_, 0);
         mb_in_.assign(mb_recv_size_, 0);
+        buildRegisterMap_();
 
         syncCoreRegisters_();
         syncSMRegisters_();
 
         // Initialize EEPROM with proper data
         initializeEeprom_();
+        publishState_();
 
         LOG_DEBUG("VirtualSlave[" + std::to_string(address_) + "] initialization complete");
     }
@@ -77,6 +87,7 @@ class VirtualSlave
     {
         online_ = on;
         syncCoreRegisters_();
+        requestRoutine();
     }
 
     ::kickcat::State alState() const noexcept
@@ -91,6 +102,7 @@ class VirtualSlave
                   "] AL state transition: " + std::to_string(static_cast<int>(old_state)) + " -> " +
                   std::to_string(static_cast<int>(s)));
         syncCoreRegisters_();
+        requestRoutine();
     }
 
     bool isInputPDOMapped() const noexcept
@@ -98,140 +110,232 @@ class VirtualSlave
         return input_pdo_mapped_;
     }
 
-    // Minimal register map (byte-addressable)
-    bool read(std::uint16_t reg, std::uint8_t* dst, std::size_t len) const noexcept
+    // Consistent copy of the last published state; safe from any thread, never blocks the slave
+    SlaveState observe() const noexcept
     {
-        // Handle EEPROM data read (4 bytes per request)
-        if (reg == ::kickcat::reg::EEPROM_DATA && len >= 4)
+        return published_->load();
+    }
+    std::shared_ptr<PublishedSlaveState const> publishedState() const noexcept
+    {
+        return published_;
+    }
+    // Frame path accounting for one register datagram addressed to this slave. Only counts: the
+    // counters reach observers with the next publishCounts() or routine(). Returns true for the
+    // first datagram since the last publish.
+    bool countDatagram(bool acknowledged) noexcept
+    {
+        ++state_.datagrams;
+        if (!acknowledged)
         {
-            uint32_t val = 0;
-            uint16_t lo = 0, hi = 0;
-            if (eeprom_addr_ < eeprom_.size())
-            {
-                lo = eeprom_[eeprom_addr_];
-            }
-            if (eeprom_addr_ + 1 < eeprom_.size())
-            {
-                hi = eeprom_[eeprom_addr_ + 1];
-            }
-            val = static_cast<uint32_t>(lo) | (static_cast<uint32_t>(hi) << 16);
-            std::memcpy(dst, &val, sizeof(uint32_t));
-            std::cout << "[slave " << address_ << "] EEPROM read addr=" << eeprom_addr_
-                      << " data=0x" << std::hex << val << std::dec << "\n";
-            // Auto-increment for next read
-            eeprom_addr_ += 2;
-            return true;
+            ++state_.wkc_zero;
         }
-
-        // ESC register space
-        if ((static_cast<std::size_t>(reg) + len) <= regs_.size())
+        bool const first = !counts_pending_;
+        counts_pending_  = true;
+        return first;
+    }
+    // Publishes the counters since the last publish, keeping the rest of the record as routine()
+    // last built it; once per frame instead of once per datagram
+    void publishCounts() noexcept
+    {
+        if (counts_pending_)
         {
-            std::copy(regs_.begin() + reg, regs_.begin() + reg + len, dst);
-            return true;
+            counts_pending_ = false;
+            published_->store(state_);
         }
+    }
 
-        // Mailbox send area (slave -> master)
-        if ((reg >= mb_send_offset_) &&
-            ((static_cast<std::size_t>(reg) + len) <= (mb_send_offset_ + mb_send_size_)))
+    // Register access (byte-addressable), dispatched through the per-device RegisterMap: plain
+    // memory is a single copy, hooks are found by handler instead of a chain of address tests.
+    // An access may span several register space handlers and is then served run by run, each
+    // run by its own handler (EEPROM interface, AL control, ...). Mailbox and process data windows
+    // have to contain an access whole. A rejected access has no side effects.
+    // Not const: EEPROM and mailbox reads have side effects (address auto-increment, mailbox
+    // drained).
+    bool read(std::uint16_t reg, std::uint8_t* dst, std::size_t len) noexcept
+    {
+        if (!accessible_(regmap_.handlersIn(reg, len), kNotReadable))
         {
-            std::size_t off = static_cast<std::size_t>(reg - mb_send_offset_);
-            std::size_t n   = std::min(len, mb_out_.size() - off);
-            std::copy(mb_out_.begin() + off, mb_out_.begin() + off + n, dst);
-            // Reading the whole message: clear can_read flag
-            mb_have_reply_ = false;
-            syncSMStatus_();
-            return true;
+            return false;
         }
-
-        return false;
+        bool ok = true;
+        regmap_.forEachRun(reg, len, [&](RegisterHandler h, std::uint32_t at, std::size_t n) {
+            std::uint8_t* out = dst + (at - reg);
+            switch (h)
+            {
+            case RegisterHandler::EepromData:
+                // EEPROM data read (4 bytes per request)
+                if (at == ::kickcat::reg::EEPROM_DATA && n >= 4)
+                {
+                    readEepromData_(out);
+                    return;
+                }
+                break;
+            case RegisterHandler::MailboxSend:
+                readMailbox_(static_cast<std::uint16_t>(at), out, n);
+                return;
+            case RegisterHandler::ProcessInputs:
+                ok = readProcessInputs(at - sm3_address_, out, n) && ok;
+                return;
+            default:
+                break;
+            }
+            std::memcpy(out, regs_.data() + at, n); // ESC register space
+        });
+        return ok;
     }
 
     bool write(std::uint16_t reg, std::uint8_t const* src, std::size_t len) noexcept
     {
-        // Handle EEPROM control write (request)
-        if (reg == ::kickcat::reg::EEPROM_CONTROL && len >= 6)
-        {
-            // struct { uint16_t command; uint16_t addressLow; uint16_t addressHigh; }
-            uint16_t cmd = static_cast<uint16_t>(src[0] | (static_cast<uint16_t>(src[1]) << 8));
-            uint16_t addressLow =
-                static_cast<uint16_t>(src[2] | (static_cast<uint16_t>(src[3]) << 8));
-            uint16_t addressHigh =
-                static_cast<uint16_t>(src[4] | (static_cast<uint16_t>(src[5]) << 8));
-            eeprom_addr_ =
-                static_cast<uint32_t>(addressLow) | (static_cast<uint32_t>(addressHigh) << 16);
-            std::cout << "[slave " << address_ << "] EEPROM control write cmd=0x" << std::hex << cmd
-                      << " addr=0x" << eeprom_addr_ << std::dec << "\n";
-            return true;
-        }
-
-        // ESC register space
-        if ((static_cast<std::size_t>(reg) + len) <= regs_.size())
+        if (len == 0)
         {
-            std::copy(src, src + len, regs_.begin() + reg);
+            return true; // nothing to store and nothing to trigger
         }
-        else if ((reg >= mb_recv_offset_) &&
-                 ((static_cast<std::size_t>(reg) + len) <= (mb_recv_offset_ + mb_recv_size_)))
+        if (!accessible_(regmap_.handlersIn(reg, len), kNotWritable))
         {
-            // Mailbox recv area (master -> slave)
-            std::size_t off = static_cast<std::size_t>(reg - mb_recv_offset_);
-            std::size_t n   = std::min(len, mb_in_.size() - off);
-            std::copy(src, src + n, mb_in_.begin() + off);
-            handleMailboxWrite_(off, n);
-            return true;
+            return false;
         }
-        else if ((reg >= ::kickcat::reg::SYNC_MANAGER) &&
-                 (reg < (::kickcat::reg::SYNC_MANAGER + 16)))
-        {
-            // Update mailbox SM config if written via FPWR
-            // We accept up to 2 SM entries (8 bytes each)
-            std::size_t remaining = len;
-            std::size_t pos       = 0;
-            while (remaining >= 8)
+        bool ok                          = true;
+        bool routine                     = false;
+        RegisterMap::HandlerMask touched = 0; // memory-backed handlers written
+        regmap_.forEachRun(reg, len, [&](RegisterHandler h, std::uint32_t at, std::size_t n) {
+            std::uint8_t const* in = src + (at - reg);
+            switch (h)
             {
-                auto start =
-                    static_cast<uint16_t>(src[pos] | (static_cast<uint16_t>(src[pos + 1]) << 8));
-                auto length  = static_cast<uint16_t>(src[pos + 2] |
-                                                     (static_cast<uint16_t>(src[pos + 3]) << 8));
-                int sm_index = static_cast<int>((reg + pos - ::kickcat::reg::SYNC_MANAGER) / 8);
-                if (sm_index == 0)
+            case RegisterHandler::EepromControl:
+                // EEPROM control write (request)
+                if (at == ::kickcat::reg::EEPROM_CONTROL && n >= 6)
                 {
-                    mb_recv_offset_ = start;
-                    mb_recv_size_   = length;
-                    if (mb_in_.size() != mb_recv_size_)
-                        mb_in_.assign(mb_recv_size_, 0);
+                    writeEepromControl_(in);
+                    return;
                 }
-                if (sm_index == 1)
-                {
-                    mb_send_offset_ = start;
-                    mb_send_size_   = length;
-                    if (mb_out_.size() != mb_send_size_)
-                        mb_out_.assign(mb_send_size_, 0);
-                }
-                pos += 8;
-                remaining -= 8;
+                break;
+            case RegisterHandler::MailboxRecv:
+                writeMailbox_(static_cast<std::uint16_t>(at), in, n);
+                routine = true;
+                return;
+            case RegisterHandler::ProcessOutputs:
+                ok = writeProcessOutputs(at - sm2_address_, in, n) && ok;
+                return;
+            default:
+                break;
             }
-            syncSMRegisters_();
-            return true;
-        }
-        else
-        {
-            return false;
-        }
+            std::memcpy(regs_.data() + at, in, n); // ESC register space
+            touched |= RegisterMap::bit(h);
+            routine = true;
+        });
 
-        // If STATION_ADDR is written, keep internal address in sync
-        if (reg == 0x0010 && len >= 2)
+        // Side effects of every hook register the write touched
+        if (touched & RegisterMap::bit(RegisterHandler::StationAddress))
         {
             address_ = static_cast<std::uint16_t>(regs_[0x0010] |
                                                   (static_cast<uint16_t>(regs_[0x0011]) << 8));
         }
+        // Mailbox SM config written via FPWR: follow the new mailbox windows
+        if (touched & RegisterMap::bit(RegisterHandler::SyncManager))
+        {
+            applyMailboxSMConfig_();
+        }
         // If AL_CONTROL written, update AL_STATUS accordingly (minimal behavior)
-        if (reg == ::kickcat::reg::AL_CONTROL && len >= 1)
+        if (touched & RegisterMap::bit(RegisterHandler::AlControl))
         {
             uint16_t ctrl_value =
                 static_cast<uint16_t>(regs_[::kickcat::reg::AL_CONTROL]) |
                 (static_cast<uint16_t>(regs_[::kickcat::reg::AL_CONTROL + 1]) << 8);
             handleAlControlWrite_(ctrl_value);
         }
+        if (routine)
+        {
+            requestRoutine();
+        }
+        return ok;
+    }
+
+    // SM2 (outputs) / SM3 (inputs) process data in buffered (3-buffer) mode, as an ESC runs it:
+    // the device model and the frame path each own one side of a triple buffer, so the model can
+    // run on its own thread at its own rate and the frame path always sees the latest complete
+    // image, never a torn one. Configure before the slave is shared; a size of 0 disables a side.
+    // With inputs_from_model the model commits SM3 itself; otherwise routine() mirrors
+    // readDigitalInputsBitfield() into it.
+    void configureProcessData(std::uint16_t outputs_address, std::size_t outputs_bytes,
+                              std::uint16_t inputs_address, std::size_t inputs_bytes,
+                              bool inputs_from_model = false)
+    {
+        inputs_from_model_ = inputs_from_model;
+        sm2_address_       = outputs_address;
+        sm3_address_       = inputs_address;
+        sm2_.resize(outputs_bytes);
+        sm3_.resize(inputs_bytes);
+        writeSMWindow_(::kickcat::reg::SYNC_MANAGER_2, outputs_address, outputs_bytes);
+        writeSMWindow_(::kickcat::reg::SYNC_MANAGER_3, inputs_address, inputs_bytes);
+        buildRegisterMap_();
+    }
+    std::size_t outputsSize() const noexcept
+    {
+        return sm2_.size();
+    }
+    std::size_t inputsSize() const noexcept
+    {
+        return sm3_.size();
+    }
+
+    // Device model side (one thread). Fill inputsBuffer() and commitInputs(); bytes not written
+    // keep their last committed value.
+    std::uint8_t* inputsBuffer() noexcept
+    {
+        return sm3_.writeBuffer();
+    }
+    void commitInputs() noexcept
+    {
+        sm3_.publishKeep();
+    }
+    // True when the master has read the last committed input buffer; event-style models (edge
+    // FIFOs) wait for it so that no committed batch is overwritten unseen
+    bool inputsConsumed() const noexcept
+    {
+        return sm3_.consumed();
+    }
+    // Takes the most recent complete output image; returns true when it is new since last call
+    bool updateOutputs() noexcept
+    {
+        return sm2_.update();
+    }
+    std::uint8_t const* outputs() const noexcept
+    {
+        return sm2_.readBuffer();
+    }
+
+    // Frame path side (serialized with all other register access). Like an ESC, reading the
+    // first byte switches to the latest input buffer and writing the last byte hands the output
+    // buffer to the model.
+    bool readProcessInputs(std::size_t offset, std::uint8_t* dst, std::size_t len) noexcept
+    {
+        if (offset + len > sm3_.size())
+        {
+            return false;
+        }
+        if (offset == 0)
+        {
+            sm3_.update();
+        }
+        std::memcpy(dst, sm3_.readBuffer() + offset, len);
+        if (inputs_from_model_ && offset + len == sm3_.size())
+        {
+            requestRoutine(); // the model may now commit its next buffer
+        }
+        return true;
+    }
+    bool writeProcessOutputs(std::size_t offset, std::uint8_t const* src, std::size_t len) noexcept
+    {
+        if (offset + len > sm2_.size())
+        {
+            return false;
+        }
+        std::memcpy(sm2_.writeBuffer() + offset, src, len);
+        if (offset + len == sm2_.size())
+        {
+            sm2_.publishKeep();
+            requestRoutine();
+        }
         return true;
     }
 
@@ -256,6 +360,36 @@ class VirtualSlave
     {
         LOG_DEBUG("VirtualSlave[" + std::to_string(address_) + "] starting");
         started_ = true;
+        requestRoutine();
+    }
+
+    // Set by the owning simulator: routine() then only runs when requested (see
+    // requestRoutine()); nullptr detaches
+    void attachScheduler(SlaveScheduler* scheduler, std::size_t slot) noexcept
+    {
+        slot_.store(slot, std::memory_order_relaxed);
+        scheduler_.store(scheduler, std::memory_order_release);
+        auto const period = updatePeriod();
+        if (scheduler && period.count() > 0)
+        {
+            scheduler->setUpdatePeriod(slot, period);
+        }
+        requestRoutine();
+    }
+
+    // Runs routine() at least once per period on top of the event-driven calls, e.g. 100 us for a
+    // fast drive model, 10 ms for a slow one; zero (default) runs it on events only
+    void setUpdatePeriod(std::chrono::nanoseconds period) noexcept
+    {
+        update_period_ns_.store(period.count(), std::memory_order_relaxed);
+        if (auto* s = scheduler_.load(std::memory_order_acquire))
+        {
+            s->setUpdatePeriod(slot_.load(std::memory_order_relaxed), period);
+        }
+    }
+    std::chrono::nanoseconds updatePeriod() const noexcept
+    {
+        return std::chrono::nanoseconds(update_period_ns_.load(std::memory_order_relaxed));
     }
 
     void routine() noexcept
@@ -269,9 +403,46 @@ class VirtualSlave
         // This is where the slave would normally process state changes
         // For our simulation, we just ensure the state is properly reflected
         syncCoreRegisters_();
+        onRoutine();
+        mirrorBitfieldInputs_();
+        publishState_();
     }
 
   protected:
+    // Schedules routine() for the next simulation cycle, or for when; models call this whenever
+    // their inputs change or a time-based effect (debounce) falls due. Any thread.
+    void requestRoutine() noexcept
+    {
+        if (auto* s = scheduler_.load(std::memory_order_acquire))
+        {
+            s->markDirty(slot_.load(std::memory_order_relaxed));
+        }
+    }
+    void requestRoutineAt(SlaveScheduler::Clock::time_point when) noexcept
+    {
+        if (auto* s = scheduler_.load(std::memory_order_acquire))
+        {
+            s->wakeAt(slot_.load(std::memory_order_relaxed), when);
+        }
+    }
+    // Runs fn on the simulation thread once when has passed, followed by routine(). False when no
+    // scheduler is attached (fn is dropped); the model then has to evaluate time lazily. fn runs
+    // with the simulator locked, as routine() does: it may touch the model and arm timers, but must
+    // not call into NetworkSimulator.
+    bool callAt(SlaveScheduler::Clock::time_point when, std::function<void()> fn)
+    {
+        if (auto* s = scheduler_.load(std::memory_order_acquire))
+        {
+            s->callAt(slot_.load(std::memory_order_relaxed), when, std::move(fn));
+            return true;
+        }
+        return false;
+    }
+
+    // Device model step, run from routine() on the simulation thread whenever the slave is due
+    // (see requestRoutine()); the place to consume outputs and commit inputs
+    virtual void onRoutine() noexcept {}
+
     // Allow derived classes (specific slaves) to answer SDO Upload values
     virtual bool onSdoUpload(uint16_t /*index*/, uint8_t /*subindex*/,
                              uint32_t& /*value*/) const noexcept
@@ -286,9 +457,167 @@ class VirtualSlave
         return false;
     }
 
+    // A string object (0x1008 device name, 0x1009/0x100A versions) as an expedited upload carries
+    // it: the first 4 characters, zero padded
+    static uint32_t expeditedString(char const* s) noexcept
+    {
+        char buf[4] = {0, 0, 0, 0};
+        for (int i = 0; i < 4 && s && s[i]; ++i)
+        {
+            buf[i] = s[i];
+        }
+        uint32_t v = 0;
+        std::memcpy(&v, buf, sizeof(v));
+        return v;
+    }
+
     // (legacy placeholder removed)
 
   private:
+    // Handlers an access must not touch at all: reads of master -> slave windows, writes of
+    // slave -> master windows, and addresses nothing answers
+    static constexpr RegisterMap::HandlerMask kNotReadable =
+        RegisterMap::bit(RegisterHandler::Unmapped) |
+        RegisterMap::bit(RegisterHandler::MailboxRecv) |
+        RegisterMap::bit(RegisterHandler::ProcessOutputs);
+    static constexpr RegisterMap::HandlerMask kNotWritable =
+        RegisterMap::bit(RegisterHandler::Unmapped) |
+        RegisterMap::bit(RegisterHandler::MailboxSend) |
+        RegisterMap::bit(RegisterHandler::ProcessInputs);
+    static constexpr RegisterMap::HandlerMask kWindows =
+        RegisterMap::bit(RegisterHandler::MailboxRecv) |
+        RegisterMap::bit(RegisterHandler::MailboxSend) |
+        RegisterMap::bit(RegisterHandler::ProcessOutputs) |
+        RegisterMap::bit(RegisterHandler::ProcessInputs);
+
+    static bool accessible_(RegisterMap::HandlerMask touched,
+                            RegisterMap::HandlerMask forbidden) noexcept
+    {
+        bool const one_handler = (touched & (touched - 1)) == 0;
+        return (touched & forbidden) == 0 && (one_handler || (touched & kWindows) == 0);
+    }
+
+    // Classifies the ESC address space; rebuilt whenever the mailbox windows move
+    void buildRegisterMap_()
+    {
+        regmap_.clear();
+        regmap_.assign(0, regs_.size(), RegisterHandler::Memory);
+        regmap_.assign(::kickcat::reg::STATION_ADDR, 2, RegisterHandler::StationAddress);
+        regmap_.assign(::kickcat::reg::AL_CONTROL, 2, RegisterHandler::AlControl);
+        regmap_.assign(::kickcat::reg::EEPROM_CONTROL, 6, RegisterHandler::EepromControl);
+        regmap_.assign(::kickcat::reg::EEPROM_DATA, 8, RegisterHandler::EepromData);
+        // SM0/SM1 (mailbox) configuration, 8 bytes each
+        regmap_.assign(::kickcat::reg::SYNC_MANAGER, 16, RegisterHandler::SyncManager);
+        regmap_.assign(mb_recv_offset_, mb_recv_size_, RegisterHandler::MailboxRecv);
+        regmap_.assign(mb_send_offset_, mb_send_size_, RegisterHandler::MailboxSend);
+        regmap_.assign(sm2_address_, sm2_.size(), RegisterHandler::ProcessOutputs);
+        regmap_.assign(sm3_address_, sm3_.size(), RegisterHandler::ProcessInputs);
+    }
+
+    void writeSMWindow_(std::uint16_t sm, std::uint16_t start, std::size_t length) noexcept
+    {
+        regs_[sm + 0] = static_cast<uint8_t>(start & 0xFF);
+        regs_[sm + 1] = static_cast<uint8_t>((start >> 8) & 0xFF);
+        regs_[sm + 2] = static_cast<uint8_t>(length & 0xFF);
+        regs_[sm + 3] = static_cast<uint8_t>((length >> 8) & 0xFF);
+    }
+
+    // Legacy models only expose a digital input bitfield: publish it into SM3 each cycle
+    void mirrorBitfieldInputs_() noexcept
+    {
+        uint32_t bits = 0;
+        if (sm3_.size() == 0 || inputs_from_model_ || !readDigitalInputsBitfield(bits))
+        {
+            return;
+        }
+        std::uint8_t* buf = sm3_.writeBuffer();
+        for (std::size_t i = 0; i < sm3_.size() && i < sizeof(bits); ++i)
+        {
+            buf[i] = static_cast<uint8_t>((bits >> (8 * i)) & 0xFF);
+        }
+        sm3_.publishKeep();
+    }
+
+    void readEepromData_(std::uint8_t* dst) noexcept
+    {
+        uint32_t val = 0;
+        uint16_t lo  = 0, hi = 0;
+        if (eeprom_addr_ < eeprom_.size())
+        {
+            lo = eeprom_[eeprom_addr_];
+        }
+        if (eeprom_addr_ + 1 < eeprom_.size())
+        {
+            hi = eeprom_[eeprom_addr_ + 1];
+        }
+        val = static_cast<uint32_t>(lo) | (static_cast<uint32_t>(hi) << 16);
+        std::memcpy(dst, &val, sizeof(uint32_t));
+        std::cout << "[slave " << address_ << "] EEPROM read addr=" << eeprom_addr_ << " data=0x"
+                  << std::hex << val << std::dec << "\n";
+        // Auto-increment for next read
+        eeprom_addr_ += 2;
+    }
+
+    void writeEepromControl_(std::uint8_t const* src) noexcept
+    {
+        // struct { uint16_t command; uint16_t addressLow; uint16_t addressHigh; }
+        uint16_t cmd         = static_cast<uint16_t>(src[0] | (static_cast<uint16_t>(src[1]) << 8));
+        uint16_t addressLow  = static_cast<uint16_t>(src[2] | (static_cast<uint16_t>(src[3]) << 8));
+        uint16_t addressHigh = static_cast<uint16_t>(src[4] | (static_cast<uint16_t>(src[5]) << 8));
+        eeprom_addr_ =
+            static_cast<uint32_t>(addressLow) | (static_cast<uint32_t>(addressHigh) << 16);
+        std::cout << "[slave " << address_ << "] EEPROM control write cmd=0x" << std::hex << cmd
+                  << " addr=0x" << eeprom_addr_ << std::dec << "\n";
+    }
+
+    // Mailbox send area (slave -> master); the caller checked the access lies in the window
+    void readMailbox_(std::uint16_t reg, std::uint8_t* dst, std::size_t len) noexcept
+    {
+        std::size_t off = static_cast<std::size_t>(reg - mb_send_offset_);
+        std::memcpy(dst, mb_out_.data() + off, len);
+        ++state_.mailbox_reads;
+        // Reading the whole message: clear can_read flag
+        mb_have_reply_ = false;
+        syncSMStatus_();
+    }
+
+    // Mailbox recv area (master -> slave); the caller checked the access lies in the window
+    void writeMailbox_(std::uint16_t reg, std::uint8_t const* src, std::size_t len) noexcept
+    {
+        std::size_t off = static_cast<std::size_t>(reg - mb_recv_offset_);
+        std::memcpy(mb_in_.data() + off, src, len);
+        ++state_.mailbox_writes;
+        handleMailboxWrite_(off, len);
+    }
+
+    // Adopts SM0 (mailbox out) / SM1 (mailbox in) start and length from the SM registers. A zero
+    // length (SM being reset) keeps the current window.
+    void applyMailboxSMConfig_()
+    {
+        auto word = [&](std::size_t at)
+        { return static_cast<uint16_t>(regs_[at] | (static_cast<uint16_t>(regs_[at + 1]) << 8)); };
+        uint16_t const recv_start = word(::kickcat::reg::SYNC_MANAGER_0 + 0);
+        uint16_t const recv_size  = word(::kickcat::reg::SYNC_MANAGER_0 + 2);
+        uint16_t const send_start = word(::kickcat::reg::SYNC_MANAGER_1 + 0);
+        uint16_t const send_size  = word(::kickcat::reg::SYNC_MANAGER_1 + 2);
+        if (recv_size != 0)
+        {
+            mb_recv_offset_ = recv_start;
+            mb_recv_size_   = recv_size;
+            if (mb_in_.size() != mb_recv_size_)
+                mb_in_.assign(mb_recv_size_, 0);
+        }
+        if (send_size != 0)
+        {
+            mb_send_offset_ = send_start;
+            mb_send_size_   = send_size;
+            if (mb_out_.size() != mb_send_size_)
+                mb_out_.assign(mb_send_size_, 0);
+        }
+        buildRegisterMap_();
+        syncSMRegisters_();
+    }
+
     void initializeEeprom_() noexcept
     {
         // Basic EEPROM structure for EtherCAT slave
@@ -383,6 +712,24 @@ class VirtualSlave
             static_cast<uint8_t>((al_status_code_ >> 8) & 0xFF);
     }
 
+    void publishState_() noexcept
+    {
+        state_.station_address = address_;
+        state_.al_state        = static_cast<uint8_t>(al_state_);
+        state_.al_status_code  = al_status_code_;
+        state_.dl_status       = static_cast<uint16_t>(
+            regs_[::kickcat::reg::ESC_DL_STATUS] |
+            (static_cast<uint16_t>(regs_[::kickcat::reg::ESC_DL_STATUS + 1]) << 8));
+        for (std::size_t i = 0; i < state_.sm_status.size(); ++i)
+        {
+            state_.sm_status[i] =
+                regs_[::kickcat::reg::SYNC_MANAGER + i * 8 + ::kickcat::reg::SM_STATS];
+        }
+        state_.has_inputs = readDigitalInputsBitfield(state_.inputs);
+        counts_pending_   = false;
+        published_->store(state_);
+    }
+
     void syncSMRegisters_() noexcept
     {
         // SM0: mailbox out (master -> slave)
@@ -403,15 +750,14 @@ class VirtualSlave
         syncSMStatus_();
     }
 
-    void syncSMStatus_() const noexcept
+    void syncSMStatus_() noexcept
     {
         // Update only status byte for SM0 and SM1
         // SM0 status: we keep writable -> not full
-        auto& reg0 = const_cast<std::vector<std::uint8_t>&>(regs_);
-        reg0[::kickcat::reg::SYNC_MANAGER_0 + ::kickcat::reg::SM_STATS] = 0x00;
+        regs_[::kickcat::reg::SYNC_MANAGER_0 + ::kickcat::reg::SM_STATS] = 0x00;
         // SM1 status: set MAILBOX_STATUS when we have a reply ready
-        uint8_t st1 = mb_have_reply_ ? ::kickcat::MAILBOX_STATUS : 0x00;
-        reg0[::kickcat::reg::SYNC_MANAGER_1 + ::kickcat::reg::SM_STATS] = st1;
+        auto& sm1_status = regs_[::kickcat::reg::SYNC_MANAGER_1 + ::kickcat::reg::SM_STATS];
+        sm1_status       = mb_have_reply_ ? ::kickcat::MAILBOX_STATUS : 0x00;
     }
 
     static int stateRank_(::kickcat::State s) noexcept
@@ -772,18 +1118,36 @@ class VirtualSlave
     bool ack_requested_{false};
     bool started_{false};
 
+    RegisterMap regmap_;
+
+    std::atomic<SlaveScheduler*> scheduler_{nullptr};
+    std::atomic<std::size_t> slot_{0};
+    std::atomic<std::int64_t> update_period_ns_{0};
+
+    // SM2/SM3 buffered process data
+    framework::concurrency::TripleBuffer sm2_;
+    framework::concurrency::TripleBuffer sm3_;
+    std::uint16_t sm2_address_{0};
+    std::uint16_t sm3_address_{0};
+    bool inputs_from_model_{false};
+
     // Mailbox (standard) minimal simulation
     uint16_t mb_recv_offset_{0};
     uint16_t mb_recv_size_{0};
     uint16_t mb_send_offset_{0};
     uint16_t mb_send_size_{0};
-    mutable bool mb_have_reply_{false};
-    mutable std::vector<std::uint8_t> mb_out_;
+    bool mb_have_reply_{false};
+    std::vector<std::uint8_t> mb_out_;
     std::vector<std::uint8_t> mb_in_;
 
     // EEPROM / SII minimal stub
-    mutable uint32_t eeprom_addr_{0}; // word address for next read
+    uint32_t eeprom_addr_{0}; // word address for next read
     std::vector<uint16_t> eeprom_ = std::vector<uint16_t>(128, 0);
+
+    // Observation: writer-side copy and its published record (shared so tables can outlive us)
+    SlaveState state_;
+    bool counts_pending_{false}; // datagrams counted since the last publish
+    std::shared_ptr<PublishedSlaveState> published_{std::make_shared<PublishedSlaveState>()};
 };
 
 } // namespace ethercat_sim::simulation
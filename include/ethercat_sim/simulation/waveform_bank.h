@@ -0,0 +1,129 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace ethercat_sim::simulation
+{
+
+// Signal source for simulated analog channels. Every channel is one lane of a shared bank, and
+// the bank computes one sample for all lanes at a time on a fixed sample clock (10 kHz by
+// default). The lane parameters are stored as structure-of-arrays and the generators are
+// branch-free: each step is a single pass over contiguous float arrays that the compiler
+// vectorizes (polynomial sine, sawtooth, xorshift noise), so thousands of channels of many
+// slaves cost one batch per sample instead of one virtual call per channel. Replayed recordings
+// are the exception and are patched in per lane.
+//
+// The last history() samples of every lane are kept, sample-major, for oversampling terminals
+// that report several samples per cycle.
+//
+// Not thread safe: configure and advance from the simulation thread (slave routines).
+class WaveformBank
+{
+  public:
+    using Clock = std::chrono::steady_clock;
+    using Lane  = std::uint32_t;
+
+    enum class Shape : std::uint8_t
+    {
+        Constant, // offset
+        Sine,     // offset + amplitude * sin(2 pi (f t + phase))
+        Ramp,     // offset + amplitude * (2 frac(f t + phase) - 1), a sawtooth
+        Noise,    // offset + amplitude * uniform(-1, 1)
+        Replay    // offset + amplitude * recording[k % size], one value per sample, looped
+    };
+
+    struct Waveform
+    {
+        Shape shape{Shape::Constant};
+        float offset{0.0f};
+        float amplitude{0.0f};
+        float frequency{0.0f}; // Hz
+        float phase{0.0f};     // turns
+        std::uint32_t seed{0}; // noise; 0 derives a seed from the lane index
+        std::shared_ptr<std::vector<float> const> recording{};
+    };
+
+    static constexpr std::chrono::nanoseconds kDefaultSamplePeriod{std::chrono::microseconds(100)};
+    static constexpr std::size_t kDefaultHistory = 64;
+
+    explicit WaveformBank(std::chrono::nanoseconds sample_period = kDefaultSamplePeriod,
+                          std::size_t history                    = kDefaultHistory,
+                          Clock::time_point start                = Clock::now());
+
+    // Appends count lanes (Constant 0) and returns the first; lanes are numbered contiguously
+    Lane addLanes(std::size_t count);
+    void setWaveform(Lane lane, Waveform const& waveform);
+
+    // Generates the samples due up to now. A gap longer than the history is skipped by moving
+    // the generators ahead analytically. Returns the number of samples the clock advanced.
+    std::size_t advanceTo(Clock::time_point now);
+    // Generates count samples regardless of the clock
+    void generate(std::size_t count);
+
+    float latest(Lane lane) const noexcept;
+    // The n most recent samples of lane, oldest first; n is capped at history()
+    void recent(Lane lane, std::size_t n, float* out) const noexcept;
+
+    std::size_t lanes() const noexcept
+    {
+        return lanes_;
+    }
+    std::size_t history() const noexcept
+    {
+        return rows_;
+    }
+    std::chrono::nanoseconds samplePeriod() const noexcept
+    {
+        return period_;
+    }
+    // Samples generated (or skipped) since start
+    std::uint64_t samples() const noexcept
+    {
+        return samples_;
+    }
+
+  private:
+    struct Replay
+    {
+        Lane lane;
+        std::shared_ptr<std::vector<float> const> recording;
+        std::size_t position;
+    };
+
+    // Default noise seed of a lane; distinct lanes get distinct, non-zero xorshift states
+    static std::uint32_t laneSeed_(Lane lane) noexcept
+    {
+        return 0x9E3779B9u * (lane + 1u);
+    }
+    void step_() noexcept;
+    void skip_(std::uint64_t count) noexcept;
+    void reserveLanes_(std::size_t lanes);
+    float const* row_(std::size_t age) const noexcept; // 0 = latest
+
+    Clock::time_point start_;
+    std::chrono::nanoseconds period_;
+    std::size_t rows_;
+    std::size_t lanes_{0};
+    std::size_t stride_{0}; // lane capacity, the row length of history_
+    std::size_t head_{0};   // row holding the latest sample
+    std::uint64_t samples_{0};
+
+    // Lane parameters, one entry per lane
+    std::vector<float> offset_;
+    std::vector<float> amplitude_;
+    std::vector<float> phase_;     // turns, [0, 1)
+    std::vector<float> increment_; // turns per sample
+    std::vector<float> sine_;      // generator weights: 1 for the lane's shape, else 0
+    std::vector<float> ramp_;
+    std::vector<float> noise_;
+    std::vector<std::uint32_t> rng_;
+    std::vector<Replay> replays_;
+
+    std::vector<float> history_; // rows_ x stride_
+};
+
+} // namespace ethercat_sim::simulation
@@ -0,0 +1,99 @@
+#include <array>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <vector>
+
+#include "ethercat_sim/communication/socket_io.h"
+#include "ethercat_sim/communication/wire_protocol.h"
+
+namespace wire = ethercat_sim::communication::wire;
+
+TEST(WireProtocol, HeaderRoundTrip)
+{
+    std::array<wire::FrameDescriptor, 2> tx{};
+    tx[0] = {60, 7, 0x0102030405060708ull, 0};
+    tx[1] = {1518, 8, 42, 43};
+    wire::Prelude p;
+    p.count = 2;
+    p.seq   = 0xDEADBEEF;
+
+    std::array<std::uint8_t, wire::headerSize(2)> buf{};
+    wire::encodeHeader(buf.data(), p, tx.data());
+    ASSERT_TRUE(wire::isV2(buf.data()));
+
+    wire::Prelude q;
+    ASSERT_TRUE(wire::decodePrelude(buf.data(), q));
+    EXPECT_EQ(2, q.count);
+    EXPECT_EQ(0xDEADBEEFu, q.seq);
+
+    std::array<wire::FrameDescriptor, 2> rx{};
+    ASSERT_TRUE(wire::decodeDescriptors(buf.data() + wire::kPreludeSize, q.count, rx.data()));
+    EXPECT_EQ(60, rx[0].len);
+    EXPECT_EQ(7, rx[0].index);
+    EXPECT_EQ(0x0102030405060708ull, rx[0].tx_ns);
+    EXPECT_EQ(1518, rx[1].len);
+    EXPECT_EQ(43u, rx[1].rx_ns);
+}
+
+TEST(WireProtocol, V1LengthsAreNeverMistakenForV2)
+{
+    for (unsigned len = 0; len <= wire::kMaxV1FrameSize; ++len)
+    {
+        std::uint8_t be[2] = {static_cast<std::uint8_t>(len >> 8), static_cast<std::uint8_t>(len)};
+        ASSERT_FALSE(wire::isV2(be)) << len;
+    }
+}
+
+TEST(WireProtocol, RejectsMalformedHeaders)
+{
+    std::array<wire::FrameDescriptor, 1> d{};
+    d[0].len = 64;
+    wire::Prelude p;
+    p.count = 1;
+    std::array<std::uint8_t, wire::headerSize(1)> buf{};
+    wire::encodeHeader(buf.data(), p, d.data());
+
+    wire::Prelude q;
+    auto bad = buf;
+    bad[2]   = 3; // unknown version
+    EXPECT_FALSE(wire::decodePrelude(bad.data(), q));
+    bad    = buf;
+    bad[3] = 0; // empty batch
+    EXPECT_FALSE(wire::decodePrelude(bad.data(), q));
+    bad[3] = static_cast<std::uint8_t>(wire::kMaxFrames + 1);
+    EXPECT_FALSE(wire::decodePrelude(bad.data(), q));
+
+    d[0].len = static_cast<std::uint16_t>(wire::kMaxFrameSize + 1);
+    wire::encodeHeader(buf.data(), p, d.data());
+    wire::FrameDescriptor out;
+    EXPECT_FALSE(wire::decodeDescriptors(buf.data() + wire::kPreludeSize, 1, &out));
+}
+
+TEST(WireProtocol, VectoredWriteArrivesAsOneMessage)
+{
+    int sv[2];
+    ASSERT_EQ(0, ::socketpair(AF_UNIX, SOCK_STREAM, 0, sv));
+    ethercat_sim::communication::IoPolicy io;
+    ASSERT_TRUE(ethercat_sim::communication::configureSocket(sv[0], io));
+    ASSERT_TRUE(ethercat_sim::communication::configureSocket(sv[1], io));
+
+    std::vector<std::uint8_t> a(100, 0xAA), b(3000, 0xBB);
+    iovec iov[2] = {{a.data(), a.size()}, {b.data(), b.size()}};
+    ASSERT_TRUE(ethercat_sim::communication::writeVectored(sv[0], iov, 2, io));
+
+    std::vector<std::uint8_t> in(a.size() + b.size());
+    ASSERT_TRUE(ethercat_sim::communication::readExact(sv[1], in.data(), in.size(), io,
+                                                       std::chrono::seconds(1)));
+    EXPECT_EQ(0xAA, in[99]);
+    EXPECT_EQ(0xBB, in[100]);
+    EXPECT_EQ(0xBB, in.back());
+
+    // Nothing more to read: times out instead of blocking forever
+    std::uint8_t extra = 0;
+    EXPECT_FALSE(ethercat_sim::communication::readExact(sv[1], &extra, 1, io,
+                                                        std::chrono::milliseconds(5)));
+    ::close(sv[0]);
+    ::close(sv[1]);
+}
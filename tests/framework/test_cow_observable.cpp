@@ -0,0 +1,119 @@
+#include <atomic>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <thread>
+
+#include "ethercat_sim/framework/mvc/base_model.h"
+#include "ethercat_sim/framework/mvc/cow_observable.h"
+
+using namespace std::chrono_literals;
+
+namespace
+{
+
+class Counter : public ethercat_sim::framework::CowObservable<int>
+{
+  public:
+    void publish(int v)
+    {
+        notifyObservers(v);
+    }
+};
+
+} // namespace
+
+TEST(CowObservable, Sync_DeliversAndRemoves)
+{
+    Counter c;
+    int seen = 0;
+    auto id  = c.addObserver([&](int v) { seen = v; });
+    c.publish(7);
+    EXPECT_EQ(7, seen);
+
+    EXPECT_TRUE(c.removeObserver(id));
+    EXPECT_FALSE(c.removeObserver(id));
+    c.publish(8);
+    EXPECT_EQ(7, seen);
+    EXPECT_EQ(0u, c.observerCount());
+}
+
+TEST(CowObservable, Sync_ReentrantSubscribeDoesNotDeadlock)
+{
+    Counter c;
+    int late = 0;
+    c.addObserver(
+        [&](int v)
+        {
+            if (v == 1)
+            {
+                c.addObserver([&](int x) { late = x; });
+            }
+        });
+    c.publish(1); // subscribes from inside the callback
+    c.publish(2);
+    EXPECT_EQ(2, late);
+    EXPECT_EQ(2u, c.observerCount());
+}
+
+TEST(CowObservable, Async_SlowConsumerDoesNotBlockPublisher)
+{
+    Counter c;
+    std::atomic_bool release{false};
+    std::atomic_int calls{0};
+    std::atomic_int last{-1};
+    c.addAsyncObserver(
+        [&](int v)
+        {
+            calls.fetch_add(1);
+            // Parked until the publisher is done; bounded so a blocking publisher fails the
+            // counts below instead of hanging the test
+            for (int i = 0; i < 500 && !release.load(); ++i)
+            {
+                std::this_thread::sleep_for(10ms);
+            }
+            last.store(v);
+        },
+        /*queue_depth*/ 1, /*coalesce*/ true);
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        c.publish(i);
+    }
+    // All publishes returned while the consumer sat in its first callback: one value in the
+    // callback at most, one in the queue, the rest coalesced away
+    EXPECT_LE(calls.load(), 1);
+    EXPECT_GE(c.droppedCount(), 998u);
+    release.store(true);
+
+    // Coalescing keeps the newest value, so the consumer eventually catches up to it
+    for (int i = 0; i < 100 && last.load() != 999; ++i)
+    {
+        std::this_thread::sleep_for(10ms);
+    }
+    EXPECT_EQ(999, last.load());
+    EXPECT_EQ(1000u, c.droppedCount() + static_cast<std::size_t>(calls.load()));
+}
+
+TEST(BaseModel, UpdateNotifiesAndAllowsReentrantSubscribe)
+{
+    ethercat_sim::framework::BaseModel<int> model;
+    int seen = 0;
+    int late = 0;
+    model.addObserver(
+        [&](int v)
+        {
+            seen = v;
+            if (v == 1)
+            {
+                model.addObserver([&](int x) { late = x; });
+            }
+        });
+    model.updateData(1);
+    model.updateData(2);
+    EXPECT_EQ(2, seen);
+    EXPECT_EQ(2, late);
+    EXPECT_EQ(2, model.snapshot());
+
+    model.setData(3);
+    EXPECT_EQ(2, seen);
+}
@@ -0,0 +1,83 @@
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <memory>
+
+#include "ethercat_sim/framework/profiling/phase_profiler.h"
+#include "ethercat_sim/simulation/network_simulator.h"
+#include "ethercat_sim/simulation/virtual_slave.h"
+#include "framework/logger/logger.h"
+
+using ethercat_sim::framework::profiling::Log2Histogram;
+using ethercat_sim::framework::profiling::Phase;
+using ethercat_sim::framework::profiling::PhaseProfiler;
+using ethercat_sim::framework::profiling::ScopedPhase;
+
+TEST(PhaseProfiler, HistogramBucketsAndPercentiles)
+{
+    EXPECT_EQ(0u, Log2Histogram::bucketOf(0));
+    EXPECT_EQ(1u, Log2Histogram::bucketOf(1));
+    EXPECT_EQ(10u, Log2Histogram::bucketOf(1000)); // [512, 1024)
+    EXPECT_EQ(Log2Histogram::kBuckets - 1, Log2Histogram::bucketOf(~0ull));
+
+    Log2Histogram h;
+    for (int i = 0; i < 99; ++i)
+    {
+        h.record(1000);
+    }
+    h.record(1000000);
+    auto s = h.snapshot();
+    EXPECT_EQ(100u, s.count);
+    EXPECT_EQ(1000000u, s.max_ns);
+    EXPECT_EQ((99u * 1000u + 1000000u) / 100u, s.meanNs());
+    EXPECT_EQ(1023u, s.percentileNs(0.50)); // bucket upper bound
+    EXPECT_EQ(1000000u, s.percentileNs(1.0)); // clamped to the max
+
+    h.reset();
+    EXPECT_EQ(0u, h.snapshot().count);
+}
+
+TEST(PhaseProfiler, ScopedPhaseAndDatagramCounters)
+{
+    PhaseProfiler p;
+    {
+        ScopedPhase t(&p, Phase::ProcessFrame);
+    }
+    {
+        ScopedPhase t(nullptr, Phase::ProcessFrame); // disabled: no sample anywhere
+    }
+    EXPECT_EQ(1u, p.phase(Phase::ProcessFrame).count);
+    EXPECT_EQ(0u, p.phase(Phase::SocketRead).count);
+
+    p.countDatagram(4);   // FPRD
+    p.countDatagram(4);
+    p.countDatagram(200); // unknown commands share the last counter
+    EXPECT_EQ(2u, p.datagrams(4));
+    EXPECT_EQ(1u, p.datagrams(PhaseProfiler::kCommands - 1));
+    auto report = p.report();
+    EXPECT_NE(std::string::npos, report.find("process frame"));
+    EXPECT_NE(std::string::npos, report.find("FPRD=2"));
+}
+
+TEST(PhaseProfiler, SimulatorAndLoggerPhases)
+{
+    using ethercat_sim::framework::logger::Logger;
+    using ethercat_sim::framework::logger::LogLevel;
+
+    PhaseProfiler p;
+    ethercat_sim::simulation::NetworkSimulator sim;
+    sim.setProfiler(&p);
+    sim.addVirtualSlave(std::make_shared<ethercat_sim::simulation::VirtualSlave>(1, 0, 0, "s"));
+    sim.startAllSlaves();
+    sim.runOnce();
+    sim.runOnce();
+    EXPECT_EQ(2u, p.phase(Phase::SlaveRoutines).count);
+    EXPECT_EQ(2u, p.phase(Phase::InputMapping).count);
+
+    Logger::setLevel(LogLevel::INFO);
+    PhaseProfiler::attachLogger(&p);
+    Logger::info("profiled line");
+    Logger::debug("filtered out, not timed");
+    PhaseProfiler::attachLogger(nullptr);
+    Logger::info("not profiled");
+    EXPECT_EQ(1u, p.phase(Phase::Logging).count);
+}
@@ -0,0 +1,71 @@
+#include <atomic>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <thread>
+
+#include "ethercat_sim/framework/concurrency/seqlock.h"
+
+using ethercat_sim::framework::concurrency::SeqLock;
+
+namespace
+{
+struct Record
+{
+    std::uint64_t a;
+    std::uint32_t b;
+    std::uint16_t c;
+    std::uint8_t d[5];
+};
+} // namespace
+
+TEST(SeqLock, LoadReturnsLastStore)
+{
+    SeqLock<Record> lock;
+    EXPECT_EQ(0u, lock.load().a);
+    EXPECT_EQ(1u, lock.version()); // the constructor publishes the initial value
+
+    lock.store(Record{7, 8, 9, {1, 2, 3, 4, 5}});
+    auto r = lock.load();
+    EXPECT_EQ(7u, r.a);
+    EXPECT_EQ(8u, r.b);
+    EXPECT_EQ(9u, r.c);
+    EXPECT_EQ(5u, r.d[4]);
+    EXPECT_EQ(2u, lock.version());
+}
+
+TEST(SeqLock, ConcurrentReadersNeverSeeTornRecord)
+{
+    SeqLock<Record> lock;
+    std::atomic_bool done{false};
+
+    std::thread writer(
+        [&]
+        {
+            for (std::uint32_t i = 1; i <= 50000; ++i)
+            {
+                auto v = static_cast<std::uint8_t>(i);
+                lock.store(Record{i, i, static_cast<std::uint16_t>(i), {v, v, v, v, v}});
+            }
+            done.store(true);
+        });
+
+    auto reader = [&]
+    {
+        std::uint64_t last = 0;
+        while (!done.load())
+        {
+            auto r = lock.load();
+            ASSERT_EQ(r.a, r.b);
+            ASSERT_EQ(static_cast<std::uint16_t>(r.a), r.c);
+            ASSERT_EQ(static_cast<std::uint8_t>(r.a), r.d[0]);
+            ASSERT_EQ(r.d[0], r.d[4]);
+            ASSERT_GE(r.a, last); // single writer: values never go backwards
+            last = r.a;
+        }
+    };
+    std::thread r1(reader), r2(reader);
+    writer.join();
+    r1.join();
+    r2.join();
+    EXPECT_EQ(50000u, lock.load().a);
+}
@@ -0,0 +1,75 @@
+#include <chrono>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <thread>
+
+#include "ethercat_sim/framework/concurrency/spsc_ring.h"
+
+using ethercat_sim::framework::concurrency::Doorbell;
+using ethercat_sim::framework::concurrency::SpscRing;
+
+TEST(SpscRing, FifoAndCapacity)
+{
+    SpscRing<int, 4> ring;
+    EXPECT_TRUE(ring.empty());
+    for (int i = 0; i < 4; ++i)
+    {
+        ASSERT_TRUE(ring.tryPush(i));
+    }
+    EXPECT_FALSE(ring.tryPush(99));
+
+    int v = -1;
+    for (int i = 0; i < 4; ++i)
+    {
+        ASSERT_TRUE(ring.tryPop(v));
+        EXPECT_EQ(i, v);
+    }
+    EXPECT_FALSE(ring.tryPop(v));
+    EXPECT_TRUE(ring.empty());
+}
+
+TEST(SpscRing, ThreadedTransferKeepsOrder)
+{
+    constexpr std::uint32_t kCount = 100000;
+    SpscRing<std::uint32_t, 8> ring;
+    Doorbell bell;
+
+    std::thread producer(
+        [&]
+        {
+            for (std::uint32_t i = 0; i < kCount;)
+            {
+                if (ring.tryPush(i))
+                {
+                    bell.ring();
+                    ++i;
+                }
+                else
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+
+    std::uint32_t expected = 0;
+    while (expected < kCount)
+    {
+        std::uint32_t v = 0;
+        if (!ring.tryPop(v))
+        {
+            bell.wait([&] { return !ring.empty(); }, std::chrono::milliseconds(50));
+            continue;
+        }
+        ASSERT_EQ(expected, v);
+        ++expected;
+    }
+    producer.join();
+}
+
+TEST(Doorbell, WaitTimesOutWithoutRing)
+{
+    Doorbell bell;
+    auto t0 = std::chrono::steady_clock::now();
+    EXPECT_FALSE(bell.wait([] { return false; }, std::chrono::milliseconds(10)));
+    EXPECT_GE(std::chrono::steady_clock::now() - t0, std::chrono::milliseconds(10));
+}
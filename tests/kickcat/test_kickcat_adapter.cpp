@@ -36,3 +36,47 @@ TEST(KickcatAdapter, ReadWrite_StationAddress)
     ::kickcat::sendGetRegister(*link, /*slave*/ 2, ::kickcat::reg::STATION_ADDR, station);
     EXPECT_EQ(station, 2u);
 }
+
+TEST(KickcatAdapter, DirectMode_MatchesQueuedPath)
+{
+    auto sim = std::make_shared<NetworkSimulator>();
+    sim->initialize();
+    sim->clearSlaves();
+    sim->addVirtualSlave(std::make_shared<VirtualSlave>(1, 0x9A, 0x1111, "S1"));
+    sim->addVirtualSlave(std::make_shared<VirtualSlave>(2, 0x9A, 0x2222, "S2"));
+
+    auto nominal = std::make_shared<ethercat_sim::kickcat::SimSocket>(sim);
+    nominal->setDirect(true);
+    auto redun = std::make_shared<::kickcat::SocketNull>();
+    auto link  = std::make_shared<::kickcat::Link>(nominal, redun, [] {});
+
+    uint16_t station = 0;
+    ::kickcat::sendGetRegister(*link, /*slave*/ 2, ::kickcat::reg::STATION_ADDR, station);
+    EXPECT_EQ(station, 2u);
+
+    // Several frames in flight before the link reads them back, answered in order
+    uint16_t stations[2] = {0, 0};
+    auto on_error        = [](::kickcat::DatagramState const&) { FAIL() << "datagram error"; };
+    for (int i = 0; i < 2; ++i)
+    {
+        link->addDatagram(
+            ::kickcat::Command::FPRD,
+            ::kickcat::createAddress(static_cast<uint16_t>(i + 1), ::kickcat::reg::STATION_ADDR),
+            nullptr, 2,
+            [&stations, i](::kickcat::DatagramHeader const*, uint8_t const* data, uint16_t wkc)
+            {
+                if (wkc != 1)
+                    return ::kickcat::DatagramState::INVALID_WKC;
+                stations[i] = static_cast<uint16_t>(data[0] | (data[1] << 8));
+                return ::kickcat::DatagramState::OK;
+            },
+            on_error);
+    }
+    link->processDatagrams();
+    EXPECT_EQ(stations[0], 1u);
+    EXPECT_EQ(stations[1], 2u);
+
+    // Nothing in flight: read returns immediately
+    uint8_t buf[64];
+    EXPECT_EQ(0, nominal->read(buf, sizeof(buf)));
+}
@@ -0,0 +1,86 @@
+#include <algorithm>
+#include <atomic>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+#include "logic/master_model.h"
+
+using ethercat_sim::app::master::MasterModel;
+using ethercat_sim::app::master::SlavesRow;
+
+TEST(MasterModel, Version_BumpsOnlyOnChange)
+{
+    MasterModel model;
+    EXPECT_EQ(0u, model.version());
+
+    model.setStatus("scan ok");
+    EXPECT_EQ(1u, model.version());
+    model.setStatus("scan ok");
+    EXPECT_EQ(1u, model.version());
+
+    std::vector<SlavesRow> rows{{1, 0x0000, 0x02}, {2, 0x0011, 0x01}};
+    model.setSlaves(rows);
+    EXPECT_EQ(2u, model.version());
+    model.setSlaves(rows);
+    EXPECT_EQ(2u, model.version());
+
+    rows[1].state = 0x02;
+    model.setSlaves(rows);
+    EXPECT_EQ(3u, model.version());
+    EXPECT_EQ(3u, model.current()->version);
+    EXPECT_EQ(0x02, model.current()->slaves[1].state);
+}
+
+TEST(MasterModel, Current_IsImmutableWhileHeld)
+{
+    MasterModel model;
+    model.setDetectedSlaves(1);
+    auto held = model.current();
+
+    // Several publishes recycle buffers; the one we hold must stay untouched
+    for (int i = 2; i < 10; ++i)
+    {
+        model.setDetectedSlaves(i);
+    }
+    EXPECT_EQ(1, held->detected_slaves);
+    EXPECT_EQ(9, model.current()->detected_slaves);
+}
+
+TEST(MasterModel, ConcurrentReaders_SeeConsistentRows)
+{
+    MasterModel model;
+    std::atomic_bool stop{false};
+
+    std::thread writer(
+        [&]
+        {
+            std::vector<SlavesRow> rows(64);
+            for (std::uint16_t gen = 0; !stop.load(); ++gen)
+            {
+                for (auto& r : rows)
+                {
+                    r.address = gen;
+                }
+                model.setSlaves(rows);
+            }
+        });
+
+    // Count torn snapshots and assert after the join, so a failure cannot leave the writer
+    // joinable
+    int torn = 0;
+    for (int i = 0; i < 20000; ++i)
+    {
+        auto snap = model.current();
+        if (snap->slaves.empty())
+        {
+            continue;
+        }
+        auto gen = snap->slaves.front().address;
+        torn += std::any_of(snap->slaves.begin(), snap->slaves.end(),
+                            [gen](SlavesRow const& r) { return r.address != gen; });
+    }
+    stop.store(true);
+    writer.join();
+    EXPECT_EQ(0, torn);
+}
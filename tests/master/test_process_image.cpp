@@ -0,0 +1,35 @@
+#include <cstdint>
+#include <gtest/gtest.h>
+
+#include "logic/process_image.h"
+
+using ethercat_sim::app::master::ProcessImage;
+
+TEST(ProcessImage, IomapIsPageAlignedAndZeroed)
+{
+    ProcessImage image(100);
+    auto addr = reinterpret_cast<std::uintptr_t>(image.iomap());
+    EXPECT_EQ(0u, addr % 4096);
+    EXPECT_GE(image.capacity(), 4096u);
+    EXPECT_EQ(0, image.iomap()[99]);
+    EXPECT_FALSE(image.mapped());
+}
+
+TEST(ProcessImage, OutputsAndInputsRoundTripThroughIomap)
+{
+    ProcessImage image;
+    ASSERT_TRUE(image.setLayout(0, 2, 2, 2));
+    ASSERT_FALSE(image.setLayout(0, 2, image.capacity() - 1, 2));
+
+    image.outputs()[1] = 0x5A;
+    image.commitOutputs();
+    image.applyOutputs();
+    EXPECT_EQ(0x5A, image.iomap()[3]);
+
+    // The cycle received new inputs
+    image.iomap()[0] = 0x11;
+    image.latchInputs();
+    ASSERT_TRUE(image.pollInputs());
+    EXPECT_EQ(0x11, image.inputs()[0]);
+    EXPECT_EQ(2u, image.inputSize());
+}
@@ -0,0 +1,171 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+
+#include "ethercat_sim/simulation/network_simulator.h"
+#include "ethercat_sim/simulation/slaves/analog_input_slave.h"
+#include "ethercat_sim/simulation/waveform_bank.h"
+#include "test_helpers.h"
+
+using ethercat_sim::simulation::WaveformBank;
+using ethercat_sim::test_helpers::warmBank;
+using namespace ethercat_sim::simulation::slaves;
+
+namespace
+{
+
+using Shape = WaveformBank::Shape;
+
+constexpr double kPi = 3.14159265358979323846;
+
+std::int16_t le16(std::uint8_t const* p)
+{
+    return static_cast<std::int16_t>(p[0] | (p[1] << 8));
+}
+
+using AnalogInputSlaveTest = ethercat_sim::test_helpers::SimulatorTest;
+
+} // namespace
+
+TEST(WaveformBank, SineFollowsTheSampleClock)
+{
+    WaveformBank bank;
+    auto const lane = bank.addLanes(3) + 1;
+    bank.setWaveform(lane, {Shape::Sine, 0.0f, 2.0f, 50.0f, 0.25f});
+    bank.generate(1000);
+
+    std::array<float, 64> got{};
+    bank.recent(lane, got.size(), got.data());
+    for (std::size_t k = 0; k < got.size(); ++k)
+    {
+        // Sample n (from 0) is taken at phase + n * f * Ts
+        double const n = 1000.0 - got.size() + k;
+        EXPECT_NEAR(got[k], 2.0 * std::sin(2 * kPi * (0.25 + n * 50.0 * 1e-4)), 1e-3) << k;
+    }
+    EXPECT_EQ(bank.latest(lane - 1), 0.0f); // neighbours untouched
+}
+
+TEST(WaveformBank, ShapesAreSelectedPerLane)
+{
+    WaveformBank bank;
+    auto const first = bank.addLanes(4);
+    auto recording   = std::make_shared<std::vector<float> const>(std::vector<float>{1, 2, 3});
+    bank.setWaveform(first + 0, {Shape::Ramp, 0.0f, 1.0f, 1000.0f}); // 10 samples per period
+    bank.setWaveform(first + 1, {Shape::Noise, 5.0f, 1.0f, 0.0f, 0.0f, 42u});
+    bank.setWaveform(first + 2, {Shape::Replay, 0.5f, 1.0f, 0.0f, 0.0f, 0u, recording});
+    bank.setWaveform(first + 3, {Shape::Constant, 2.0f});
+    bank.generate(4);
+
+    std::array<float, 4> v{};
+    bank.recent(first + 0, v.size(), v.data());
+    EXPECT_NEAR(v[0], -1.0f, 1e-5);
+    EXPECT_NEAR(v[3], -0.4f, 1e-5);
+    bank.recent(first + 2, v.size(), v.data());
+    EXPECT_EQ(v, (std::array<float, 4>{1.5f, 2.5f, 3.5f, 1.5f}));
+    EXPECT_EQ(bank.latest(first + 3), 2.0f);
+
+    // Noise stays in offset +- amplitude and is reproducible from the seed
+    float lo = 10.0f, hi = 0.0f;
+    WaveformBank a, b;
+    a.addLanes(1);
+    b.addLanes(1);
+    a.setWaveform(0, {Shape::Noise, 5.0f, 1.0f, 0.0f, 0.0f, 42u});
+    b.setWaveform(0, {Shape::Noise, 5.0f, 1.0f, 0.0f, 0.0f, 42u});
+    for (int i = 0; i < 1000; ++i)
+    {
+        a.generate(1);
+        b.generate(1);
+        ASSERT_EQ(a.latest(0), b.latest(0));
+        lo = std::min(lo, a.latest(0));
+        hi = std::max(hi, a.latest(0));
+    }
+    EXPECT_GE(lo, 4.0f);
+    EXPECT_LE(hi, 6.0f);
+    EXPECT_GT(hi - lo, 1.5f);
+
+    // Without a seed every lane draws its own sequence
+    WaveformBank c;
+    c.addLanes(2);
+    c.setWaveform(0, {Shape::Noise, 0.0f, 1.0f});
+    c.setWaveform(1, {Shape::Noise, 0.0f, 1.0f});
+    c.generate(1);
+    EXPECT_NE(c.latest(0), c.latest(1));
+}
+
+TEST(WaveformBank, LongGapsAreSkippedWithoutLosingPhase)
+{
+    auto const start = WaveformBank::Clock::now();
+    WaveformBank stepped(WaveformBank::kDefaultSamplePeriod, 16, start);
+    WaveformBank skipped(WaveformBank::kDefaultSamplePeriod, 16, start);
+    for (auto* bank : {&stepped, &skipped})
+    {
+        bank->addLanes(1);
+        bank->setWaveform(0, {Shape::Sine, 0.0f, 1.0f, 123.0f});
+    }
+    stepped.generate(5000);
+    EXPECT_EQ(skipped.advanceTo(start + 5000 * WaveformBank::kDefaultSamplePeriod), 5000u);
+    EXPECT_EQ(skipped.samples(), stepped.samples());
+    EXPECT_NEAR(skipped.latest(0), stepped.latest(0), 1e-3);
+    EXPECT_EQ(skipped.advanceTo(start + 5000 * WaveformBank::kDefaultSamplePeriod), 0u);
+}
+
+TEST_F(AnalogInputSlaveTest, StandardPdoCarriesScaledValuesAndRangeFlags)
+{
+    auto bank = warmBank();
+    auto bi   = std::make_shared<EL3104Slave>(1, bank);
+    auto uni  = std::make_shared<EL3064Slave>(2, bank);
+    bi->setWaveform(0, {Shape::Constant, 5.0f});
+    bi->setWaveform(1, {Shape::Constant, 12.0f});
+    bi->setWaveform(2, {Shape::Constant, -10.0f});
+    uni->setWaveform(3, {Shape::Constant, -1.0f});
+    start(bi, uni);
+    sim.runOnce();
+
+    std::array<std::uint8_t, EL3104Slave::kInputBytes> image{};
+    ASSERT_TRUE(sim.readFromSlave(1, AnalogInputTraits::inputs_address, image.data(),
+                                  image.size()));
+    EXPECT_EQ(le16(image.data() + 2), 16384); // 5 V of 10 V
+    EXPECT_EQ(le16(image.data() + 6), 0x7FFF);
+    EXPECT_EQ(image[4] & 0x43u, 0x42u); // overrange + error
+    EXPECT_EQ(le16(image.data() + 10), -0x7FFF);
+    EXPECT_EQ(image[8] & 0x43u, 0x00u);
+    EXPECT_EQ(bi->value(0), 16384);
+
+    // 0..10 V terminal: negative input clamps to 0 and reports underrange
+    EXPECT_EQ(uni->value(3), 0);
+    EXPECT_EQ(uni->status(3) & 0x43u, 0x41u);
+}
+
+TEST_F(AnalogInputSlaveTest, OversamplingReportsEverySampleOfTheCycle)
+{
+    auto bank = warmBank();
+    auto el   = std::make_shared<EL3702Slave<10>>(1, bank);
+    el->setWaveform(1, {Shape::Ramp, 0.0f, 10.0f, 500.0f}); // 20 samples per period
+    start(el);
+    sim.runOnce();
+
+    std::array<std::uint8_t, EL3702Slave<10>::kInputBytes> image{};
+    static_assert(image.size() == 2 * 10 * 2);
+    ASSERT_TRUE(sim.readFromSlave(1, AnalogInputTraits::inputs_address, image.data(),
+                                  image.size()));
+    std::array<float, 10> expected{};
+    bank->recent(el->lane(1), expected.size(), expected.data());
+    for (std::size_t k = 0; k < expected.size(); ++k)
+    {
+        std::uint16_t status = 0;
+        EXPECT_EQ(le16(image.data() + 20 + 2 * k), EL3702Slave<10>::toRaw(expected[k], status));
+    }
+    // A ramp rises by 1 V (3276.7 LSB) per sample except where it wraps
+    int rising = 0;
+    for (std::size_t k = 1; k < expected.size(); ++k)
+    {
+        rising += std::abs(el->sample(1, k) - el->sample(1, k - 1) - 3277) <= 1 ? 1 : 0;
+    }
+    EXPECT_GE(rising, 8);
+}
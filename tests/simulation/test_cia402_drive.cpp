@@ -0,0 +1,331 @@
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+
+#include "ethercat_sim/simulation/axis_bank.h"
+#include "ethercat_sim/simulation/network_simulator.h"
+#include "ethercat_sim/simulation/slaves/cia402_drive.h"
+#include "test_helpers.h"
+
+using ethercat_sim::simulation::AxisBank;
+using ethercat_sim::simulation::NetworkSimulator;
+using ethercat_sim::simulation::slaves::Cia402DriveSlave;
+using ethercat_sim::test_helpers::sdo_download_u32;
+using ethercat_sim::test_helpers::sdo_upload;
+using ethercat_sim::test_helpers::steppedBank;
+
+namespace
+{
+
+using State = Cia402DriveSlave::State;
+
+struct Command
+{
+    std::uint16_t controlword{0};
+    std::int32_t target_position{0};
+    std::int32_t target_velocity{0};
+    std::int16_t target_torque{0};
+    std::int8_t mode{0};
+};
+
+struct Feedback
+{
+    std::uint16_t statusword;
+    std::int32_t position;
+    std::int32_t velocity;
+    std::int16_t torque;
+    std::int8_t mode;
+};
+
+void send(NetworkSimulator& sim, std::uint16_t addr, Command const& c)
+{
+    std::array<std::uint8_t, Cia402DriveSlave::kOutputBytes> image{};
+    std::memcpy(image.data(), &c.controlword, 2);
+    std::memcpy(image.data() + 2, &c.target_position, 4);
+    std::memcpy(image.data() + 6, &c.target_velocity, 4);
+    std::memcpy(image.data() + 10, &c.target_torque, 2);
+    std::memcpy(image.data() + 12, &c.mode, 1);
+    ASSERT_TRUE(sim.writeToSlave(addr, Cia402DriveSlave::kOutputsAddress, image.data(),
+                                 image.size()));
+}
+
+Feedback receive(NetworkSimulator& sim, std::uint16_t addr)
+{
+    std::array<std::uint8_t, Cia402DriveSlave::kInputBytes> image{};
+    Feedback f{};
+    EXPECT_TRUE(sim.readFromSlave(addr, Cia402DriveSlave::kInputsAddress, image.data(),
+                                  image.size()));
+    std::memcpy(&f.statusword, image.data(), 2);
+    std::memcpy(&f.position, image.data() + 2, 4);
+    std::memcpy(&f.velocity, image.data() + 6, 4);
+    std::memcpy(&f.torque, image.data() + 10, 2);
+    std::memcpy(&f.mode, image.data() + 12, 1);
+    return f;
+}
+
+// One bus cycle: outputs to the drive, drive routine, inputs back, one axis step
+Feedback cycle(NetworkSimulator& sim, AxisBank& bank, std::uint16_t addr, Command const& c)
+{
+    send(sim, addr, c);
+    sim.runOnce();
+    auto const f = receive(sim, addr);
+    bank.step(1);
+    return f;
+}
+
+// Shutdown, switch on, enable operation
+void enable(NetworkSimulator& sim, AxisBank& bank, std::uint16_t addr, Command c)
+{
+    for (std::uint16_t cw : {0x0006u, 0x0007u, 0x000Fu})
+    {
+        c.controlword = cw;
+        cycle(sim, bank, addr, c);
+    }
+}
+
+using Cia402DriveSlaveTest = ethercat_sim::test_helpers::SimulatorTest;
+
+} // namespace
+
+TEST(AxisBank, BatchMatchesAxesIntegratedAlone)
+{
+    AxisBank batch;
+    std::vector<AxisBank> alone(64);
+    for (int i = 0; i < 64; ++i)
+    {
+        AxisBank::Params p;
+        p.inertia       = 1e-3 * (1 + i % 4);
+        p.damping       = 1e-3 * (i % 3);
+        p.stiffness     = i % 4 == 0 ? 1e-2 : 0.0;
+        auto const mode = static_cast<AxisBank::Mode>(i % 4);
+        double const fv = mode == AxisBank::Mode::Velocity ? 2000.0 : 0.0;
+        for (auto* bank : {&batch, &alone[static_cast<std::size_t>(i)]})
+        {
+            auto const axis = bank->addAxis(p);
+            bank->setState(axis, 100.0 * i, 0.0);
+            bank->command(axis, mode, 100.0 * i + 500.0, fv, 50.0);
+        }
+    }
+    batch.step(4000);
+    for (int i = 0; i < 64; ++i)
+    {
+        auto& one = alone[static_cast<std::size_t>(i)];
+        one.step(4000);
+        auto const axis = static_cast<AxisBank::Axis>(i);
+        EXPECT_DOUBLE_EQ(batch.position(axis), one.position(0)) << i;
+        EXPECT_DOUBLE_EQ(batch.velocity(axis), one.velocity(0)) << i;
+    }
+    // The loops settle on their targets; an axis that is off only feels its spring
+    EXPECT_NEAR(batch.position(1), 600.0, 1e-3);
+    EXPECT_NEAR(batch.velocity(2), 2000.0, 5.0); // droop of a P loop against damping
+    EXPECT_NEAR(batch.torque(3), 50.0, 1e-9);
+    EXPECT_EQ(batch.torque(4), 0.0);
+    EXPECT_LT(std::fabs(batch.position(4)), 400.0);
+
+    auto const start = AxisBank::Clock::now();
+    AxisBank clocked(AxisBank::kDefaultStep, AxisBank::kDefaultSubsteps, start);
+    EXPECT_EQ(clocked.advanceTo(start + 10 * AxisBank::kDefaultStep), 10u);
+    EXPECT_EQ(clocked.advanceTo(start + 10 * AxisBank::kDefaultStep), 0u);
+    EXPECT_EQ(clocked.advanceTo(start + 3 * AxisBank::kMaxCatchUp * AxisBank::kDefaultStep),
+              3 * AxisBank::kMaxCatchUp - 10);
+    EXPECT_EQ(clocked.steps(), 3 * AxisBank::kMaxCatchUp);
+}
+
+TEST_F(Cia402DriveSlaveTest, StateMachineFollowsTheControlword)
+{
+    auto bank  = steppedBank();
+    auto drive = std::make_shared<Cia402DriveSlave>(1, bank);
+    start(drive);
+
+    Command c{0x0000, 0, 0, 0, Cia402DriveSlave::kModeCsv};
+    EXPECT_EQ(cycle(sim, *bank, 1, c).statusword & 0x4Fu, 0x40u); // switch on disabled
+    c.controlword = 0x000F; // enable operation is not allowed from here
+    EXPECT_EQ(cycle(sim, *bank, 1, c).statusword & 0x4Fu, 0x40u);
+
+    struct Step
+    {
+        std::uint16_t controlword;
+        std::uint16_t statusword; // under mask 0x6F
+    };
+    for (auto const& step : {Step{0x0006, 0x21}, Step{0x0007, 0x23}, Step{0x000F, 0x27},
+                             Step{0x0007, 0x23}, Step{0x000F, 0x27}, Step{0x0006, 0x21},
+                             Step{0x0007, 0x23}, Step{0x0000, 0x40}, Step{0x0006, 0x21},
+                             Step{0x000F, 0x27}, Step{0x0000, 0x40}})
+    {
+        c.controlword = step.controlword;
+        auto const f  = cycle(sim, *bank, 1, c);
+        EXPECT_EQ(f.statusword & 0x6Fu, step.statusword) << std::hex << step.controlword;
+    }
+    EXPECT_EQ(drive->state(), State::SwitchOnDisabled);
+
+    enable(sim, *bank, 1, c);
+    c.controlword = 0x000F;
+    auto f        = cycle(sim, *bank, 1, c);
+    EXPECT_EQ(f.statusword & 0x6Fu, 0x27u);
+    EXPECT_NE(f.statusword & Cia402DriveSlave::kVoltageEnabled, 0u);
+    EXPECT_NE(f.statusword & Cia402DriveSlave::kRemote, 0u);
+    EXPECT_NE(f.statusword & Cia402DriveSlave::kFollowsTarget, 0u);
+    EXPECT_EQ(f.mode, Cia402DriveSlave::kModeCsv);
+
+    // An unsupported mode request keeps the displayed mode
+    c.mode = 1;
+    EXPECT_EQ(cycle(sim, *bank, 1, c).mode, Cia402DriveSlave::kModeCsv);
+}
+
+TEST_F(Cia402DriveSlaveTest, CspTracksATrajectory)
+{
+    auto bank  = steppedBank();
+    auto drive = std::make_shared<Cia402DriveSlave>(1, bank);
+    start(drive);
+
+    Command c{0x0000, 0, 0, 0, Cia402DriveSlave::kModeCsp};
+    enable(sim, *bank, 1, c);
+    c.controlword = 0x000F;
+
+    // 40000 counts/s for 0.25 s, then hold
+    Feedback f{};
+    double worst = 0.0;
+    for (int k = 1; k <= 2000; ++k)
+    {
+        c.target_position = 10 * std::min(k, 1000);
+        f                 = cycle(sim, *bank, 1, c);
+        if (k > 200 && k < 1000) // past the torque-limited start
+        {
+            worst = std::max(worst,
+                             std::fabs(bank->position(drive->axis()) - c.target_position));
+        }
+    }
+    EXPECT_LT(worst, 20.0); // the feed-forward leaves only a small following error
+    EXPECT_NEAR(f.position, 10000, 2);
+    EXPECT_NEAR(f.velocity, 0, 10);
+    EXPECT_NE(f.statusword & Cia402DriveSlave::kTargetReached, 0u);
+
+    std::uint32_t v = 0;
+    ASSERT_TRUE(sdo_upload(sim, 1, 0x6064, 0, v));
+    EXPECT_NEAR(static_cast<std::int32_t>(v), 10000, 2);
+    ASSERT_TRUE(sdo_upload(sim, 1, 0x6502, 0, v));
+    EXPECT_EQ(v, Cia402DriveSlave::kSupportedOps);
+    ASSERT_TRUE(sdo_upload(sim, 1, 0x1A00, 2, v));
+    EXPECT_EQ(v, 0x60640020u);
+    ASSERT_TRUE(sdo_upload(sim, 1, 0x60C2, 1, v));
+    EXPECT_EQ(v, 250u);
+}
+
+TEST_F(Cia402DriveSlaveTest, CspFollowsATargetAcrossTheInt32Wrap)
+{
+    auto bank  = steppedBank();
+    auto drive = std::make_shared<Cia402DriveSlave>(1, bank);
+    start(drive);
+    ASSERT_TRUE(sdo_download_u32(sim, 1, 0x6065, 0, 100));
+
+    // 0x7FFFFC18 + 2000 wraps to a negative 0x607A, which is still 2000 counts ahead
+    double const start = 2147482648.0;
+    bank->setState(drive->axis(), start, 0.0);
+    Command c{0x0000, 0x7FFFFC18, 0, 0, Cia402DriveSlave::kModeCsp};
+    enable(sim, *bank, 1, c);
+    c.controlword = 0x000F;
+    Feedback f{};
+    for (int k = 1; k <= 1000; ++k)
+    {
+        c.target_position = static_cast<std::int32_t>(0x7FFFFC18u + 2u * static_cast<unsigned>(k));
+        f = cycle(sim, *bank, 1, c);
+    }
+    for (int k = 0; k < 400; ++k)
+    {
+        f = cycle(sim, *bank, 1, c);
+    }
+    EXPECT_EQ(drive->state(), State::OperationEnabled);
+    EXPECT_LT(c.target_position, 0);
+    EXPECT_NEAR(bank->position(drive->axis()) - start, 2000.0, 2.0);
+    EXPECT_NEAR(f.position, c.target_position, 2);
+}
+
+TEST_F(Cia402DriveSlaveTest, CsvAndCstDriveTheAxis)
+{
+    auto bank = steppedBank();
+    auto csv  = std::make_shared<Cia402DriveSlave>(1, bank);
+    auto cst  = std::make_shared<Cia402DriveSlave>(2, bank);
+    start(csv, cst);
+
+    Command velocity{0x0000, 0, 5000, 0, Cia402DriveSlave::kModeCsv};
+    Command torque{0x0000, 0, 0, 100, Cia402DriveSlave::kModeCst};
+    enable(sim, *bank, 1, velocity);
+    enable(sim, *bank, 2, torque);
+    velocity.controlword = torque.controlword = 0x000F;
+
+    // 100 per mille on the default 1e-3 inertia accelerates at 1e5 counts/s^2
+    double const v0 = bank->velocity(cst->axis());
+    for (int k = 0; k < 400; ++k)
+    {
+        send(sim, 1, velocity);
+        send(sim, 2, torque);
+        sim.runOnce();
+        bank->step(1);
+    }
+    sim.runOnce();
+    auto const fv = receive(sim, 1);
+    auto const ft = receive(sim, 2);
+    EXPECT_NEAR(fv.velocity, 5000, 1);
+    EXPECT_NE(fv.statusword & Cia402DriveSlave::kTargetReached, 0u);
+    EXPECT_NEAR(bank->velocity(cst->axis()) - v0, 1e5 * 0.1, 1.0);
+    EXPECT_EQ(ft.torque, 100);
+    EXPECT_EQ(ft.mode, Cia402DriveSlave::kModeCst);
+}
+
+TEST_F(Cia402DriveSlaveTest, QuickStopAndFaultHandling)
+{
+    auto bank  = steppedBank();
+    auto drive = std::make_shared<Cia402DriveSlave>(1, bank);
+    start(drive);
+
+    // Quick stop brakes the axis, then the drive disables itself
+    Command c{0x0000, 0, 20000, 0, Cia402DriveSlave::kModeCsv};
+    enable(sim, *bank, 1, c);
+    c.controlword = 0x000F;
+    for (int k = 0; k < 100; ++k)
+    {
+        cycle(sim, *bank, 1, c);
+    }
+    c.controlword = 0x000B;
+    auto f        = cycle(sim, *bank, 1, c);
+    EXPECT_EQ(f.statusword & 0x6Fu, 0x07u);
+    for (int k = 0; k < 100 && drive->state() == State::QuickStopActive; ++k)
+    {
+        f = cycle(sim, *bank, 1, c);
+    }
+    EXPECT_EQ(f.statusword & 0x4Fu, 0x40u);
+    EXPECT_LE(std::fabs(bank->velocity(drive->axis())), 10.0);
+
+    // A set-point jump beyond the following error window faults the drive in CSP
+    ASSERT_TRUE(sdo_download_u32(sim, 1, 0x6065, 0, 100));
+    c = Command{0x0000, static_cast<std::int32_t>(bank->position(drive->axis())), 0, 0,
+                Cia402DriveSlave::kModeCsp};
+    enable(sim, *bank, 1, c);
+    c.controlword = 0x000F;
+    c.target_position += 100000;
+    cycle(sim, *bank, 1, c);
+    f = cycle(sim, *bank, 1, c);
+    EXPECT_EQ(f.statusword & 0x4Fu, 0x08u);
+    EXPECT_EQ(f.torque, 0);
+    std::uint32_t v = 0;
+    ASSERT_TRUE(sdo_upload(sim, 1, 0x603F, 0, v));
+    EXPECT_EQ(v, Cia402DriveSlave::kErrorFollowing);
+
+    // Only a rising fault reset edge leaves Fault
+    c.controlword = 0x0006;
+    EXPECT_EQ(cycle(sim, *bank, 1, c).statusword & 0x4Fu, 0x08u);
+    c.controlword = 0x0080;
+    EXPECT_EQ(cycle(sim, *bank, 1, c).statusword & 0x4Fu, 0x40u);
+    EXPECT_EQ(drive->errorCode(), 0u);
+
+    // Injected drive errors take the same path
+    drive->fault(0x7500);
+    c.controlword = 0x0000;
+    EXPECT_EQ(cycle(sim, *bank, 1, c).statusword & 0x4Fu, 0x08u);
+    EXPECT_EQ(drive->errorCode(), 0x7500u);
+}
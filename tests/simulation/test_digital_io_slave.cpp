@@ -0,0 +1,152 @@
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "ethercat_sim/simulation/network_simulator.h"
+#include "ethercat_sim/simulation/slaves/digital_io_slave.h"
+#include "test_helpers.h"
+
+using ethercat_sim::test_helpers::sdo_download_u32;
+using ethercat_sim::test_helpers::sdo_upload;
+using namespace ethercat_sim::simulation::slaves;
+
+namespace
+{
+
+struct SlowFilterTraits : DigitalIoTraits
+{
+    static constexpr std::uint32_t product_code = 0x12345678u;
+    static constexpr char const* name           = "SLOW";
+    static constexpr std::chrono::microseconds filter{30000};
+};
+using SlowFilterSlave = DigitalIoSlave<4, 0, SlowFilterTraits>;
+
+struct PlainTraits : DigitalIoTraits
+{
+    static constexpr std::uint32_t product_code = 0x00010001u;
+    static constexpr char const* name           = "DIO";
+};
+using PlainDio = DigitalIoSlave<12, 4, PlainTraits>;
+
+using DigitalIoSlaveTest = ethercat_sim::test_helpers::SimulatorTest;
+
+} // namespace
+
+TEST(DigitalIoSlave, LayoutIsGeneratedFromTemplateArguments)
+{
+    static_assert(EL1809Slave::kInputBytes == 2 && EL1809Slave::kOutputBytes == 0);
+    static_assert(EL2008Slave::kInputBytes == 0 && EL2008Slave::kOutputBytes == 1);
+    static_assert(EL1008Slave::kTxPdoEntries[7] == 0x60700101u);
+    // Mixed terminals number their outputs after the inputs, as the EL1859 ESI does
+    static_assert(EL1859Slave::kRxPdoEntries[0] == 0x70800101u);
+
+    EL1859Slave el(1);
+    EXPECT_EQ(el.vendorId(), 0x00000002u);
+    EXPECT_EQ(el.productCode(), 0x07433052u);
+    EXPECT_EQ(el.outputsSize(), 1u);
+    EXPECT_EQ(el.inputsSize(), 1u);
+    EXPECT_TRUE(el.inputPDOMapped());
+}
+
+TEST_F(DigitalIoSlaveTest, InputsAndOutputsTravelThroughProcessData)
+{
+    auto dio = std::make_shared<PlainDio>(1);
+    start(dio);
+
+    dio->setInputs(0x0A05u, 0xFFFFu);
+    sim.runOnce();
+    std::array<std::uint8_t, 2> in{};
+    ASSERT_TRUE(sim.readFromSlave(1, DigitalIoTraits::inputs_address, in.data(), in.size()));
+    EXPECT_EQ(in[0], 0x05u);
+    EXPECT_EQ(in[1], 0x0Au); // 12 channels: upper nibble stays clear
+
+    std::uint8_t out = 0xF6u;
+    ASSERT_TRUE(sim.writeToSlave(1, DigitalIoTraits::outputs_address, &out, 1));
+    sim.runOnce();
+    EXPECT_EQ(dio->outputBits(), 0x6u); // only the 4 output channels
+    EXPECT_TRUE(dio->output(1));
+    EXPECT_FALSE(dio->output(0));
+}
+
+TEST_F(DigitalIoSlaveTest, FilterRejectsGlitchesAndTakesStableLevels)
+{
+    auto dio = std::make_shared<SlowFilterSlave>(1);
+    start(dio);
+    sim.runOnce();
+
+    // A pulse well inside the 30 ms window never reaches the process image
+    dio->setInput(2, true);
+    sim.runOnce();
+    dio->setInput(2, false);
+    sim.runOnce();
+    EXPECT_EQ(dio->inputBits(), 0u);
+
+    auto const start = std::chrono::steady_clock::now();
+    dio->setInputs(0x3u, 0x3u);
+    sim.runOnce();
+    EXPECT_EQ(dio->inputBits(), 0u);
+    while (dio->inputBits() != 0x3u &&
+           std::chrono::steady_clock::now() - start < std::chrono::seconds(2))
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        sim.runOnce();
+    }
+    EXPECT_EQ(dio->inputBits(), 0x3u);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, SlowFilterTraits::filter);
+}
+
+TEST_F(DigitalIoSlaveTest, ObjectDictionaryAndInvertMask)
+{
+    auto dio = std::make_shared<PlainDio>(1);
+    sim.addVirtualSlave(dio);
+    dio->setInputs(0x001u, 0xFFFu);
+
+    uint32_t v = 0;
+    ASSERT_TRUE(sdo_upload(sim, 1, 0x1C13, 0, v));
+    EXPECT_EQ(v, 12u);
+    ASSERT_TRUE(sdo_upload(sim, 1, 0x1C12, 4, v));
+    EXPECT_EQ(v, 0x160Fu);
+    ASSERT_TRUE(sdo_upload(sim, 1, 0x160C, 1, v));
+    EXPECT_EQ(v, 0x70C00101u);
+    ASSERT_TRUE(sdo_upload(sim, 1, 0x6000, 1, v));
+    EXPECT_EQ(v, 1u);
+
+    // One XOR inverts every channel
+    ASSERT_TRUE(sdo_download_u32(sim, 1, 0x8000, 0x00, 0xFFFFFFFFu));
+    EXPECT_EQ(dio->inputBits(), 0xFFEu);
+    ASSERT_TRUE(sdo_upload(sim, 1, 0x6000, 1, v));
+    EXPECT_EQ(v, 0u);
+    ASSERT_TRUE(sdo_upload(sim, 1, 0x60B0, 1, v));
+    EXPECT_EQ(v, 1u);
+}
+
+TEST_F(DigitalIoSlaveTest, HundredsOfMixedTerminalsShareOneSegment)
+{
+    std::vector<std::shared_ptr<EL1809Slave>> inputs;
+    std::vector<std::shared_ptr<EL2809Slave>> outputs;
+    for (std::uint16_t i = 0; i < 200; ++i)
+    {
+        inputs.push_back(std::make_shared<EL1809Slave>(static_cast<std::uint16_t>(2 * i + 1)));
+        outputs.push_back(std::make_shared<EL2809Slave>(static_cast<std::uint16_t>(2 * i + 2)));
+        sim.addVirtualSlave(inputs.back());
+        sim.addVirtualSlave(outputs.back());
+    }
+    sim.startAllSlaves();
+    sim.runOnce();
+
+    std::array<std::uint8_t, 2> word{0x34u, 0x12u};
+    for (std::uint16_t i = 0; i < 200; ++i)
+    {
+        ASSERT_TRUE(sim.writeToSlave(static_cast<std::uint16_t>(2 * i + 2),
+                                     DigitalIoTraits::outputs_address, word.data(), word.size()));
+    }
+    sim.runOnce();
+    for (auto const& el : outputs)
+    {
+        EXPECT_EQ(el->outputBits(), 0x1234u);
+    }
+}
@@ -0,0 +1,153 @@
+#include <array>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+
+#include "ethercat_sim/simulation/network_simulator.h"
+#include "sim/el1258_subs.h"
+
+using ethercat_sim::simulation::NetworkSimulator;
+using ethercat_sim::subs::El1258Slave;
+namespace el1258 = ethercat_sim::simulation::slaves::el1258;
+
+namespace
+{
+
+using Image = std::array<std::uint8_t, el1258::MTI_INPUT_BYTES * el1258::CHANNEL_COUNT>;
+
+Image readInputs(NetworkSimulator& sim, std::uint16_t station)
+{
+    Image image{};
+    EXPECT_TRUE(sim.readFromSlave(station, el1258::SM3_ADDRESS, image.data(), image.size()));
+    return image;
+}
+
+std::uint8_t const* channelPdo(Image const& image, int channel)
+{
+    return image.data() + (channel - 1) * el1258::MTI_INPUT_BYTES;
+}
+
+std::uint32_t eventTime(std::uint8_t const* pdo, std::size_t i)
+{
+    std::uint8_t const* t = pdo + el1258::MTI_INPUT_TIMES_OFFSET + 4 * i;
+    return static_cast<std::uint32_t>(t[0]) | (static_cast<std::uint32_t>(t[1]) << 8) |
+           (static_cast<std::uint32_t>(t[2]) << 16) | (static_cast<std::uint32_t>(t[3]) << 24);
+}
+
+} // namespace
+
+TEST(El1258Mti, EdgesReachTxPdoWithTimestamps)
+{
+    NetworkSimulator sim;
+    sim.initialize();
+    sim.clearSlaves();
+    auto el = std::make_shared<El1258Slave>(1);
+    sim.addVirtualSlave(el);
+    sim.startAllSlaves();
+
+    std::vector<El1258Slave::EdgeEvent> edges;
+    for (std::uint32_t i = 0; i < 3; ++i)
+    {
+        edges.push_back({0x100000000ull + 1000 * i, 1, (i & 1u) == 0});
+    }
+    for (std::uint32_t i = 0; i < 12; ++i)
+    {
+        edges.push_back({5000 + 10 * i, 2, (i & 1u) == 0});
+    }
+    EXPECT_EQ(el->injectEdges(edges.data(), edges.size()), edges.size());
+
+    sim.runOnce();
+    auto image = readInputs(sim, 1);
+    auto const* ch1 = channelPdo(image, 1);
+    EXPECT_EQ(ch1[0], 3u);                  // events in this PDO
+    EXPECT_EQ(ch1[2], 0u);                  // left in the buffer
+    EXPECT_EQ(ch1[4], 0x05u);               // rising, falling, rising
+    EXPECT_EQ(eventTime(ch1, 0), 0u);       // low 32 bits of the ns time
+    EXPECT_EQ(eventTime(ch1, 2), 2000u);
+    EXPECT_EQ(ch1[1] & el1258::MTI_STATUS_INPUT_STATE, el1258::MTI_STATUS_INPUT_STATE);
+
+    auto const* ch2 = channelPdo(image, 2);
+    EXPECT_EQ(ch2[0], el1258::MTI_EVENTS_PER_PDO);
+    EXPECT_EQ(ch2[2], 2u);
+    EXPECT_EQ(eventTime(ch2, 9), 5090u);
+    auto const cycle = ch2[1] >> el1258::MTI_STATUS_CYCLE_SHIFT;
+
+    // The read handed the buffer to the master: the next cycle delivers the rest
+    sim.runOnce();
+    image = readInputs(sim, 1);
+    ch2   = channelPdo(image, 2);
+    EXPECT_EQ(ch2[0], 2u);
+    EXPECT_EQ(ch2[2], 0u);
+    EXPECT_EQ(eventTime(ch2, 0), 5100u);
+    EXPECT_EQ(eventTime(ch2, 1), 5110u);
+    EXPECT_EQ(ch2[1] >> el1258::MTI_STATUS_CYCLE_SHIFT, (cycle + 1) & 3u);
+    EXPECT_EQ(channelPdo(image, 1)[0], 0u);
+}
+
+TEST(El1258Mti, FullFifoRaisesOverflowUntilReset)
+{
+    NetworkSimulator sim;
+    sim.initialize();
+    sim.clearSlaves();
+    auto el = std::make_shared<El1258Slave>(1);
+    sim.addVirtualSlave(el);
+    sim.startAllSlaves();
+
+    std::vector<El1258Slave::EdgeEvent> edges;
+    for (std::uint32_t i = 0; i < el1258::MTI_FIFO_DEPTH + 5; ++i)
+    {
+        edges.push_back({i, 3, (i & 1u) == 0});
+    }
+    EXPECT_EQ(el->injectEdges(edges.data(), edges.size()), el1258::MTI_FIFO_DEPTH);
+
+    sim.runOnce();
+    auto image = readInputs(sim, 1);
+    EXPECT_NE(channelPdo(image, 3)[1] & el1258::MTI_STATUS_BUFFER_OVERFLOW, 0);
+
+    // Ctrl: input buffer reset plus an order counter, echoed back as feedback
+    std::array<std::uint8_t, el1258::MTI_OUTPUT_BYTES * el1258::CHANNEL_COUNT> ctrl{};
+    ctrl[2 * el1258::MTI_OUTPUT_BYTES]     = el1258::MTI_CTRL_BUFFER_RESET;
+    ctrl[2 * el1258::MTI_OUTPUT_BYTES + 2] = 7;
+    ASSERT_TRUE(sim.writeToSlave(1, el1258::SM2_ADDRESS, ctrl.data(), ctrl.size()));
+    sim.runOnce();
+    EXPECT_EQ(el->pendingEdges(3), 0u);
+    image = readInputs(sim, 1);
+    EXPECT_EQ(channelPdo(image, 3)[0], 0u);
+    EXPECT_EQ(channelPdo(image, 3)[1] & el1258::MTI_STATUS_BUFFER_OVERFLOW, 0);
+    EXPECT_EQ(channelPdo(image, 3)[3], 7u);
+}
+
+TEST(El1258Mti, EdgeTrainAcrossSlavesIsDeliveredWithoutLoss)
+{
+    constexpr std::size_t kSlaves = 32;
+    NetworkSimulator sim;
+    sim.initialize();
+    sim.clearSlaves();
+    std::vector<std::shared_ptr<El1258Slave>> slaves;
+    for (std::size_t i = 0; i < kSlaves; ++i)
+    {
+        slaves.push_back(std::make_shared<El1258Slave>(static_cast<std::uint16_t>(1 + i)));
+        sim.addVirtualSlave(slaves.back());
+    }
+    sim.startAllSlaves();
+
+    // 32 slaves x 8 channels x 40 edges, 1 us apart: ~10k edges within 40 us of stimulus time
+    auto const queued = ethercat_sim::subs::injectEdgeTrain(slaves, 0xFF, 0, 1000, 40);
+    ASSERT_EQ(queued, kSlaves * el1258::CHANNEL_COUNT * 40);
+
+    std::size_t delivered = 0;
+    for (int cycle = 0; cycle < 8; ++cycle)
+    {
+        sim.runOnce();
+        for (std::size_t i = 0; i < kSlaves; ++i)
+        {
+            auto const image = readInputs(sim, static_cast<std::uint16_t>(1 + i));
+            for (int ch = 1; ch <= el1258::CHANNEL_MAX; ++ch)
+            {
+                delivered += channelPdo(image, ch)[0];
+            }
+        }
+    }
+    EXPECT_EQ(delivered, queued);
+}
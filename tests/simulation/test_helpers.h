@@ -0,0 +1,118 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <memory>
+
+#include "kickcat/protocol.h"
+
+#include "ethercat_sim/simulation/axis_bank.h"
+#include "ethercat_sim/simulation/network_simulator.h"
+#include "ethercat_sim/simulation/waveform_bank.h"
+
+// Helpers shared by the slave model tests
+namespace ethercat_sim::test_helpers
+{
+
+using simulation::NetworkSimulator;
+
+// Expedited SDO upload through the slave's mailbox windows (0x1000 out, 0x1200 in)
+inline bool sdo_upload(NetworkSimulator& sim, uint16_t addr, uint16_t index, uint8_t subidx,
+                       uint32_t& out)
+{
+    uint8_t msg[64] = {0};
+    auto* mbx       = reinterpret_cast<::kickcat::mailbox::Header*>(msg);
+    auto* coe       = ::kickcat::pointData<::kickcat::CoE::Header>(mbx);
+    auto* sdo       = ::kickcat::pointData<::kickcat::CoE::ServiceData>(coe);
+    mbx->len        = 10;
+    mbx->type       = ::kickcat::mailbox::CoE;
+    mbx->count      = 1;
+    coe->service    = ::kickcat::CoE::SDO_REQUEST;
+    sdo->command    = ::kickcat::CoE::SDO::request::UPLOAD;
+    sdo->index      = index;
+    sdo->subindex   = subidx;
+
+    if (!sim.writeToSlave(addr, 0x1000, msg, sizeof(msg)))
+        return false;
+
+    uint8_t rx[64] = {0};
+    if (!sim.readFromSlave(addr, 0x1200, rx, sizeof(rx)))
+        return false;
+
+    auto* rmbx = reinterpret_cast<::kickcat::mailbox::Header*>(rx);
+    auto* rcoe = ::kickcat::pointData<::kickcat::CoE::Header>(rmbx);
+    auto* rsdo = ::kickcat::pointData<::kickcat::CoE::ServiceData>(rcoe);
+    std::memcpy(&out, ::kickcat::pointData<uint8_t>(rsdo), sizeof(uint32_t));
+    return true;
+}
+
+// Expedited 4-byte SDO download; the reply is read back but not checked
+inline bool sdo_download_u32(NetworkSimulator& sim, uint16_t addr, uint16_t index, uint8_t subidx,
+                             uint32_t value)
+{
+    uint8_t msg[64] = {0};
+    auto* mbx       = reinterpret_cast<::kickcat::mailbox::Header*>(msg);
+    auto* coe       = ::kickcat::pointData<::kickcat::CoE::Header>(mbx);
+    auto* sdo       = ::kickcat::pointData<::kickcat::CoE::ServiceData>(coe);
+    mbx->len        = 10;
+    mbx->type       = ::kickcat::mailbox::CoE;
+    mbx->count      = 1;
+    coe->service    = ::kickcat::CoE::SDO_REQUEST;
+    sdo->command    = ::kickcat::CoE::SDO::request::DOWNLOAD;
+    sdo->index      = index;
+    sdo->subindex   = subidx;
+    // expedited write of 4 bytes
+    uint8_t* payload = ::kickcat::pointData<uint8_t>(sdo);
+    std::memcpy(payload, &value, sizeof(uint32_t));
+
+    if (!sim.writeToSlave(addr, 0x1000, msg, sizeof(msg)))
+        return false;
+
+    // Read back ack (ignore content)
+    uint8_t rx[64] = {0};
+    if (!sim.readFromSlave(addr, 0x1200, rx, sizeof(rx)))
+        return false;
+    return true;
+}
+
+// Fixture of the slave model tests: a fresh simulator without slaves
+class SimulatorTest : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        sim.initialize();
+        sim.clearSlaves();
+    }
+
+    // Registers the slaves in order, then starts them all
+    template <typename... Slaves>
+    void start(Slaves const&... slaves)
+    {
+        (sim.addVirtualSlave(slaves), ...);
+        sim.startAllSlaves();
+    }
+
+    NetworkSimulator sim;
+};
+
+// A waveform bank whose clock started a while ago, so the first routine already finds samples due
+inline std::shared_ptr<simulation::WaveformBank> warmBank()
+{
+    using simulation::WaveformBank;
+    auto const start = WaveformBank::Clock::now() - std::chrono::milliseconds(50);
+    return std::make_shared<WaveformBank>(WaveformBank::kDefaultSamplePeriod,
+                                          WaveformBank::kDefaultHistory, start);
+}
+
+// An axis bank whose clock never falls due: the tests step it explicitly, one step per bus cycle
+inline std::shared_ptr<simulation::AxisBank> steppedBank()
+{
+    using simulation::AxisBank;
+    return std::make_shared<AxisBank>(AxisBank::kDefaultStep, AxisBank::kDefaultSubsteps,
+                                      AxisBank::Clock::now() + std::chrono::hours(1));
+}
+
+} // namespace ethercat_sim::test_helpers
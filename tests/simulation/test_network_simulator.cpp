@@ -1,5 +1,7 @@
+#include <chrono>
 #include <cstring>
 #include <gtest/gtest.h>
+#include <thread>
 
 #include "ethercat_sim/communication/ethercat_frame.h"
 #include "ethercat_sim/simulation/network_simulator.h"
@@ -37,6 +39,48 @@ TEST(NetworkSimulator, SendReceive_WhenLinkDown_Fails)
     EXPECT_FALSE(sim.receiveFrame(rx));
 }
 
+TEST(NetworkSimulator, TimedReceive_WakesOnSend)
+{
+    NetworkSimulator sim;
+    sim.initialize();
+    sim.setLinkUp(true);
+
+    std::thread sender(
+        [&]
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            EtherCATFrame tx;
+            tx.payload = {0x42};
+            sim.sendFrame(tx);
+        });
+
+    auto t0 = std::chrono::steady_clock::now();
+    EtherCATFrame rx;
+    ASSERT_TRUE(sim.receiveFrame(rx, std::chrono::seconds(2)));
+    EXPECT_LT(std::chrono::steady_clock::now() - t0, std::chrono::seconds(1));
+    EXPECT_EQ(rx.payload.at(0), 0x42);
+    sender.join();
+}
+
+TEST(NetworkSimulator, TimedReceive_HonoursLatencyAndTimeout)
+{
+    NetworkSimulator sim;
+    sim.initialize();
+    sim.setLinkUp(true);
+    sim.setLatencyMs(30);
+
+    EtherCATFrame tx;
+    tx.payload = {0x01};
+    auto t0 = std::chrono::steady_clock::now();
+    ASSERT_TRUE(sim.sendFrame(tx));
+
+    EtherCATFrame rx;
+    EXPECT_FALSE(sim.receiveFrame(rx)); // not deliverable yet
+    EXPECT_FALSE(sim.receiveFrame(rx, std::chrono::milliseconds(5)));
+    ASSERT_TRUE(sim.receiveFrame(rx, std::chrono::seconds(2)));
+    EXPECT_GE(std::chrono::steady_clock::now() - t0, std::chrono::milliseconds(30));
+}
+
 TEST(NetworkSimulator, VirtualSlaveRegistry_AddAndCount)
 {
     using ethercat_sim::simulation::VirtualSlave;
@@ -77,3 +121,115 @@ TEST(NetworkSimulator, RegisterReadWrite_ByStationAddress)
     EXPECT_TRUE(sim.readFromSlave(1, kReg, rbuf, sizeof(rbuf)));
     EXPECT_EQ(0, std::memcmp(wbuf, rbuf, sizeof(wbuf)));
 }
+
+TEST(NetworkSimulator, DirtySlaveSet_ReportsEachSlotOncePerDrain)
+{
+    using ethercat_sim::simulation::DirtySlaveSet;
+    using ethercat_sim::simulation::TimerWheel;
+    using Clock = DirtySlaveSet::Clock;
+
+    DirtySlaveSet set;
+    set.markDirty(2);
+    set.markDirty(2);
+    set.markDirty(0);
+    auto const now = Clock::now();
+    set.wakeAt(3, now + std::chrono::milliseconds(5));
+
+    std::vector<std::size_t> due;
+    set.drain(now, due);
+    EXPECT_EQ(due, (std::vector<std::size_t>{2, 0}));
+    EXPECT_FALSE(set.idle()); // timer still armed
+
+    due.clear();
+    set.drain(now + std::chrono::milliseconds(5) + TimerWheel::kDefaultTick, due); // rounds up
+    EXPECT_EQ(due, (std::vector<std::size_t>{3}));
+    EXPECT_TRUE(set.idle());
+}
+
+TEST(NetworkSimulator, RunOnce_SkipsIdleSlaves)
+{
+    using ethercat_sim::simulation::VirtualSlave;
+
+    // Counts how often runOnce() samples the mapped inputs
+    struct CountingSlave : VirtualSlave
+    {
+        using VirtualSlave::VirtualSlave;
+        bool readDigitalInputsBitfield(uint32_t& bits_out) const noexcept override
+        {
+            ++reads;
+            bits_out = 0xA5;
+            return true;
+        }
+        mutable int reads{0};
+    };
+
+    NetworkSimulator sim;
+    sim.initialize();
+    sim.clearSlaves();
+    auto s = std::make_shared<CountingSlave>(1, 0x9A, 0x1111, "S1");
+    sim.addVirtualSlave(s);
+    sim.mapDigitalInputs(s, 0x10, 1);
+
+    sim.runOnce();
+    int const first = s->reads;
+    EXPECT_GE(first, 1);
+    std::uint8_t image = 0;
+    ASSERT_TRUE(sim.readLogical(0x10, &image, 1));
+    EXPECT_EQ(image, 0xA5);
+
+    // Nothing changed: the slave is not visited again
+    sim.runOnce();
+    sim.runOnce();
+    EXPECT_EQ(s->reads, first);
+
+    // A register write marks it dirty for the next cycle only
+    std::uint8_t value = 0x01;
+    EXPECT_TRUE(sim.writeToSlave(1, 0x0100, &value, 1));
+    sim.runOnce();
+    EXPECT_GT(s->reads, first);
+    int const second = s->reads;
+    sim.runOnce();
+    EXPECT_EQ(s->reads, second);
+}
+
+TEST(NetworkSimulator, LogicalWrite_DoesNotClobberMappedInputs)
+{
+    using ethercat_sim::simulation::VirtualSlave;
+
+    struct InputSlave : VirtualSlave
+    {
+        using VirtualSlave::VirtualSlave;
+        bool readDigitalInputsBitfield(uint32_t& bits_out) const noexcept override
+        {
+            ++polls;
+            bits_out = 0xA5;
+            return true;
+        }
+        mutable int polls{0};
+    };
+
+    NetworkSimulator sim;
+    sim.initialize();
+    sim.clearSlaves();
+    auto s = std::make_shared<InputSlave>(1, 0x9A, 0x1111, "S1");
+    sim.addVirtualSlave(s);
+    sim.mapDigitalInputs(s, 0x10, 1);
+    sim.runOnce();
+
+    // An LWR over the input byte; the idle slave is not due on the next cycle
+    int const polls         = s->polls;
+    std::uint8_t const zero = 0x00;
+    ASSERT_TRUE(sim.writeLogical(0x10, &zero, 1));
+    sim.runOnce();
+    std::uint8_t image = 0;
+    ASSERT_TRUE(sim.readLogical(0x10, &image, 1));
+    EXPECT_EQ(image, 0xA5);
+
+    // An LRW reads back the inputs, not what it wrote
+    std::uint8_t rw[2] = {0x00, 0x5A};
+    ASSERT_TRUE(sim.readWriteLogical(0x10, rw, sizeof(rw)));
+    EXPECT_EQ(rw[0], 0xA5);
+    EXPECT_EQ(rw[1], 0x5A);
+    // The input byte was skipped, not restored by polling the slave again
+    EXPECT_EQ(s->polls, polls);
+}
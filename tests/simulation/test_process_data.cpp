@@ -0,0 +1,153 @@
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "kickcat/protocol.h"
+
+#include "ethercat_sim/simulation/logical_ranges.h"
+#include "ethercat_sim/simulation/network_simulator.h"
+#include "ethercat_sim/simulation/slaves/el1258.h"
+#include "ethercat_sim/simulation/virtual_slave.h"
+
+using ethercat_sim::simulation::LogicalRanges;
+using ethercat_sim::simulation::NetworkSimulator;
+using ethercat_sim::simulation::VirtualSlave;
+using ethercat_sim::simulation::slaves::EL1258Slave;
+
+TEST(ProcessData, OutputsReachModelOnLastByte)
+{
+    VirtualSlave s(1);
+    s.configureProcessData(0x1400, 4, 0x1500, 4, true);
+
+    std::uint8_t sm2[4] = {0};
+    ASSERT_TRUE(s.read(::kickcat::reg::SYNC_MANAGER_2, sm2, sizeof(sm2)));
+    EXPECT_EQ(0x00, sm2[0]);
+    EXPECT_EQ(0x14, sm2[1]);
+    EXPECT_EQ(4, sm2[2]);
+
+    std::uint8_t lo[2] = {0x11, 0x22}, hi[2] = {0x33, 0x44};
+    ASSERT_TRUE(s.write(0x1400, lo, sizeof(lo)));
+    EXPECT_FALSE(s.updateOutputs()); // buffer not complete yet
+    ASSERT_TRUE(s.write(0x1402, hi, sizeof(hi)));
+    ASSERT_TRUE(s.updateOutputs());
+    EXPECT_EQ(0x11, s.outputs()[0]);
+    EXPECT_EQ(0x44, s.outputs()[3]);
+
+    // Windows are one-directional
+    std::uint8_t buf[4] = {0};
+    EXPECT_FALSE(s.read(0x1400, buf, sizeof(buf)));
+    EXPECT_FALSE(s.write(0x1500, buf, sizeof(buf)));
+}
+
+TEST(ProcessData, LogicalReadsNeverSeeTornInputs)
+{
+    NetworkSimulator sim;
+    sim.initialize();
+    sim.clearSlaves();
+
+    constexpr std::size_t kBytes = 32;
+    auto slave                   = std::make_shared<VirtualSlave>(1);
+    slave->configureProcessData(0x1400, 0, 0x1500, kBytes, true);
+    sim.addVirtualSlave(slave);
+    sim.mapProcessData(slave, 0, 0x100);
+
+    std::atomic_bool done{false};
+    std::thread model(
+        [&]
+        {
+            for (int i = 1; i <= 20000; ++i)
+            {
+                std::memset(slave->inputsBuffer(), static_cast<std::uint8_t>(i), kBytes);
+                slave->commitInputs();
+            }
+            done.store(true);
+        });
+
+    std::uint8_t image[kBytes];
+    while (!done.load())
+    {
+        ASSERT_TRUE(sim.readLogical(0x100, image, kBytes));
+        for (std::size_t i = 1; i < kBytes; ++i)
+        {
+            ASSERT_EQ(image[0], image[i]);
+        }
+    }
+    model.join();
+    ASSERT_TRUE(sim.readLogical(0x100, image, kBytes));
+    EXPECT_EQ(static_cast<std::uint8_t>(20000), image[0]);
+}
+
+TEST(ProcessData, LrwExchangesOutputsAndInputs)
+{
+    NetworkSimulator sim;
+    sim.initialize();
+    sim.clearSlaves();
+
+    auto slave = std::make_shared<VirtualSlave>(1);
+    slave->configureProcessData(0x1400, 2, 0x1500, 2, true);
+    sim.addVirtualSlave(slave);
+    sim.mapProcessData(slave, 0x0000, 0x0002);
+    EXPECT_TRUE(slave->isInputPDOMapped());
+
+    slave->inputsBuffer()[0] = 0xA5;
+    slave->inputsBuffer()[1] = 0x5A;
+    slave->commitInputs();
+
+    std::uint8_t frame[4] = {0x01, 0x02, 0xFF, 0xFF};
+    ASSERT_TRUE(sim.readWriteLogical(0x0000, frame, sizeof(frame)));
+    EXPECT_EQ(0x01, frame[0]);
+    EXPECT_EQ(0xA5, frame[2]);
+    EXPECT_EQ(0x5A, frame[3]);
+    ASSERT_TRUE(slave->updateOutputs());
+    EXPECT_EQ(0x02, slave->outputs()[1]);
+}
+
+TEST(ProcessData, BitfieldModelsAreMirroredIntoSM3)
+{
+    NetworkSimulator sim;
+    sim.initialize();
+    sim.clearSlaves();
+
+    auto el = std::make_shared<EL1258Slave>(1);
+    el->configureProcessData(0x1400, 0, 0x1500, 1);
+    sim.addVirtualSlave(el);
+    sim.startAllSlaves();
+
+    el->setPower(true); // DI1
+    sim.runOnce();
+    std::uint8_t byte = 0;
+    ASSERT_TRUE(sim.readFromSlave(1, 0x1500, &byte, 1));
+    EXPECT_EQ(0x02, byte & 0x02);
+}
+
+TEST(ProcessData, LogicalRangesFindOnlyOverlappingMaps)
+{
+    LogicalRanges ranges;
+    ranges.add(0x40, 8, 2);
+    ranges.add(0x00, 0x100, 0); // spans everything after it
+    ranges.add(0x10, 4, 1);
+    ranges.add(0x80, 0, 3); // empty, dropped
+    ranges.build();
+    EXPECT_EQ(ranges.size(), 3u);
+
+    using Hits = std::vector<std::pair<std::size_t, std::size_t>>; // map, lo
+    Hits hits;
+    auto collect = [&](LogicalRanges::Range const& r, std::size_t lo, std::size_t hi) {
+        EXPECT_LT(lo, hi);
+        hits.emplace_back(r.map, lo);
+    };
+    ranges.forEachOverlap(0x12, 0x30, collect); // 0x12..0x41
+    EXPECT_EQ(hits, (Hits{{2, 0x40}, {1, 0x12}, {0, 0x12}}));
+
+    hits.clear();
+    ranges.forEachOverlap(0x14, 0x2C, collect); // ends right before map 2, starts after map 1
+    EXPECT_EQ(hits, (Hits{{0, 0x14}}));
+
+    hits.clear();
+    ranges.forEachOverlap(0x100, 0x10, collect);
+    EXPECT_TRUE(hits.empty());
+}
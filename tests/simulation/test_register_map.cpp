@@ -0,0 +1,105 @@
+#include <cstddef>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <tuple>
+#include <vector>
+
+#include "ethercat_sim/simulation/register_map.h"
+
+using ethercat_sim::simulation::RegisterHandler;
+using ethercat_sim::simulation::RegisterMap;
+
+namespace
+{
+
+using Span = std::tuple<RegisterHandler, std::uint32_t, std::size_t>;
+
+std::vector<Span> runs(RegisterMap const& map, std::uint32_t begin, std::size_t len)
+{
+    std::vector<Span> out;
+    map.forEachRun(begin, len, [&](RegisterHandler h, std::uint32_t at, std::size_t n) {
+        out.emplace_back(h, at, n);
+    });
+    return out;
+}
+
+// Register space up to 0x1000 with a 2-byte hook at 0x120, then two adjacent 512-byte windows
+RegisterMap escLayout()
+{
+    RegisterMap map;
+    map.assign(0x0000, 0x1000, RegisterHandler::Memory);
+    map.assign(0x0120, 2, RegisterHandler::AlControl);
+    map.assign(0x1000, 512, RegisterHandler::MailboxRecv);
+    map.assign(0x1200, 512, RegisterHandler::MailboxSend);
+    return map;
+}
+
+} // namespace
+
+TEST(RegisterMap, PagesResolveUniformAndBoundaryBytes)
+{
+    auto const map = escLayout();
+    // Uniform pages
+    EXPECT_EQ(map.at(0x0000), RegisterHandler::Memory);
+    EXPECT_EQ(map.at(0x0FFF), RegisterHandler::Memory);
+    EXPECT_EQ(map.at(0x1100), RegisterHandler::MailboxRecv);
+    EXPECT_EQ(map.at(0x1400), RegisterHandler::Unmapped);
+    EXPECT_EQ(map.at(0xFFFF), RegisterHandler::Unmapped);
+    // Page 0x01 holds the hook
+    EXPECT_EQ(map.at(0x011F), RegisterHandler::Memory);
+    EXPECT_EQ(map.at(0x0120), RegisterHandler::AlControl);
+    EXPECT_EQ(map.at(0x0121), RegisterHandler::AlControl);
+    EXPECT_EQ(map.at(0x0122), RegisterHandler::Memory);
+
+    // Reassigning part of a boundary page keeps the rest
+    auto moved = map;
+    moved.assign(0x0130, 0x10, RegisterHandler::SyncManager);
+    EXPECT_EQ(moved.at(0x0120), RegisterHandler::AlControl);
+    EXPECT_EQ(moved.at(0x0135), RegisterHandler::SyncManager);
+    EXPECT_EQ(moved.at(0x0140), RegisterHandler::Memory);
+}
+
+TEST(RegisterMap, AccessCrossingAHandlerBoundary)
+{
+    auto const map = escLayout();
+    EXPECT_EQ(map.handlersIn(0x011F, 4),
+              RegisterMap::bit(RegisterHandler::Memory) |
+                  RegisterMap::bit(RegisterHandler::AlControl));
+    EXPECT_EQ(map.handlersIn(0x0120, 2), RegisterMap::bit(RegisterHandler::AlControl));
+    EXPECT_TRUE(map.within(0x0100, 0x20, RegisterMap::bit(RegisterHandler::Memory)));
+    EXPECT_FALSE(map.within(0x0100, 0x21, RegisterMap::bit(RegisterHandler::Memory)));
+
+    EXPECT_EQ(runs(map, 0x011F, 4),
+              (std::vector<Span>{Span{RegisterHandler::Memory, 0x011F, 1},
+                                Span{RegisterHandler::AlControl, 0x0120, 2},
+                                Span{RegisterHandler::Memory, 0x0122, 1}}));
+    // Both mailbox windows in one access
+    EXPECT_EQ(runs(map, 0x11FE, 4),
+              (std::vector<Span>{Span{RegisterHandler::MailboxRecv, 0x11FE, 2},
+                                Span{RegisterHandler::MailboxSend, 0x1200, 2}}));
+}
+
+TEST(RegisterMap, AccessCrossingAPageBoundary)
+{
+    auto const map = escLayout();
+    // One run across uniform pages of the same handler
+    EXPECT_EQ(runs(map, 0x10F0, 0x20),
+              (std::vector<Span>{Span{RegisterHandler::MailboxRecv, 0x10F0, 0x20}}));
+    // From a boundary page into a uniform one: the Memory run continues over the page edge
+    EXPECT_EQ(runs(map, 0x0121, 0x100),
+              (std::vector<Span>{Span{RegisterHandler::AlControl, 0x0121, 1},
+                                Span{RegisterHandler::Memory, 0x0122, 0xFF}}));
+    EXPECT_EQ(map.handlersIn(0x0FF0, 0x20),
+              RegisterMap::bit(RegisterHandler::Memory) |
+                  RegisterMap::bit(RegisterHandler::MailboxRecv));
+    // Whole register space in one access: every page, uniform or not
+    EXPECT_EQ(map.handlersIn(0x0000, 0x1000),
+              RegisterMap::bit(RegisterHandler::Memory) |
+                  RegisterMap::bit(RegisterHandler::AlControl));
+
+    // Past the end of the address space: clipped, and reported as Unmapped
+    EXPECT_EQ(runs(map, 0xFFFC, 8),
+              (std::vector<Span>{Span{RegisterHandler::Unmapped, 0xFFFC, 4}}));
+    EXPECT_NE(map.handlersIn(0x0000, 0x10000 + 1) & RegisterMap::bit(RegisterHandler::Unmapped),
+              0u);
+}
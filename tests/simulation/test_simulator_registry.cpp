@@ -42,3 +42,36 @@ TEST(NetworkSimulatorRegistry, WriteRead_ByIndex_AliasesToStationAddress)
     ASSERT_TRUE(sim.readFromSlave(2, REG, r2, sizeof(r2)));
     EXPECT_EQ(0, std::memcmp(r2, wbuf, sizeof(wbuf)));
 }
+
+TEST(NetworkSimulatorRegistry, SlaveStates_TrackDatagramsPerSlave)
+{
+    NetworkSimulator sim;
+    sim.initialize();
+    sim.clearSlaves();
+    sim.setVirtualSlaveCount(2);
+    sim.startAllSlaves();
+
+    auto table = sim.slaveStates();
+    ASSERT_EQ(2u, table->size());
+
+    uint8_t buf[2] = {0};
+    ASSERT_TRUE(sim.readFromSlave(1, 0x0130, buf, sizeof(buf)));
+    ASSERT_TRUE(sim.readFromSlaveByIndex(0, 0x0130, buf, sizeof(buf)));
+    EXPECT_FALSE(sim.readFromSlave(2, 0x2000, buf, sizeof(buf))); // outside every area
+    EXPECT_EQ(0u, (*table)[0]->load().datagrams); // published once per frame, by runOnce()
+    sim.runOnce();
+
+    auto const s1 = (*table)[0]->load();
+    auto const s2 = (*table)[1]->load();
+    EXPECT_EQ(2u, s1.datagrams);
+    EXPECT_EQ(0u, s1.wkc_zero);
+    EXPECT_EQ(1u, s2.datagrams);
+    EXPECT_EQ(1u, s2.wkc_zero);
+    EXPECT_EQ(2u, s2.station_address);
+    EXPECT_EQ(static_cast<uint8_t>(::kickcat::State::INIT), s2.al_state);
+
+    // Removing slaves publishes a new table; the old snapshot stays readable
+    sim.clearSlaves();
+    EXPECT_TRUE(sim.slaveStates()->empty());
+    EXPECT_EQ(2u, table->size());
+}
@@ -40,3 +40,73 @@ TEST(VirtualSlave, AL_DL_Defaults_And_AL_CONTROL_ChangesState)
     ASSERT_TRUE(sim.readFromSlave(1, ::kickcat::reg::AL_STATUS, al_status2, sizeof(al_status2)));
     EXPECT_EQ(al_status2[0], static_cast<uint8_t>(::kickcat::State::PRE_OP));
 }
+
+TEST(VirtualSlave, SMConfigWrite_MovesMailboxWindow)
+{
+    VirtualSlave s(1, 0x9A, 0x1111, "S1");
+
+    // SM0 (mailbox out): start 0x1800, length 128
+    std::uint8_t sm0[8] = {0x00, 0x18, 0x80, 0x00, 0x26, 0x00, 0x01, 0x00};
+    ASSERT_TRUE(s.write(::kickcat::reg::SYNC_MANAGER_0, sm0, sizeof(sm0)));
+
+    std::uint8_t readback[4] = {0};
+    ASSERT_TRUE(s.read(::kickcat::reg::SYNC_MANAGER_0, readback, sizeof(readback)));
+    EXPECT_EQ(0x00, readback[0]);
+    EXPECT_EQ(0x18, readback[1]);
+    EXPECT_EQ(0x80, readback[2]);
+
+    std::uint8_t payload[6] = {0};
+    EXPECT_FALSE(s.write(0x1000, payload, sizeof(payload))); // old window is gone
+    EXPECT_TRUE(s.write(0x1800, payload, sizeof(payload)));
+    EXPECT_FALSE(s.write(0x1800 + 126, payload, sizeof(payload))); // runs past the window
+    s.start();
+    s.routine(); // publishes the observed state
+    EXPECT_EQ(1u, s.observe().mailbox_writes);
+
+    // A reset (zero length) keeps the current window
+    std::uint8_t zero[8] = {0};
+    ASSERT_TRUE(s.write(::kickcat::reg::SYNC_MANAGER_0, zero, sizeof(zero)));
+    EXPECT_TRUE(s.write(0x1800, payload, sizeof(payload)));
+}
+
+TEST(VirtualSlave, RegisterAccess_BoundsAndZeroLength)
+{
+    VirtualSlave s(1, 0x9A, 0x1111, "S1");
+    std::uint8_t buf[8] = {0};
+
+    EXPECT_TRUE(s.write(::kickcat::reg::AL_CONTROL, buf, 0)); // ignored, no state change
+    EXPECT_EQ(::kickcat::State::INIT, s.alState());
+
+    // Register space ends at 0x1000; the mailbox window (0x1000) cannot be reached by straddling
+    EXPECT_TRUE(s.write(0x0FF8, buf, 8));
+    EXPECT_FALSE(s.write(0x0FFC, buf, 8));
+    EXPECT_FALSE(s.read(0xFFFC, buf, 8));
+
+    // A write covering AL_CONTROL from below still triggers the state machine
+    std::uint8_t block[4] = {0, 0, static_cast<std::uint8_t>(::kickcat::State::PRE_OP), 0};
+    ASSERT_TRUE(s.write(::kickcat::reg::AL_CONTROL - 2, block, sizeof(block)));
+    EXPECT_EQ(::kickcat::State::PRE_OP, s.alState());
+}
+
+TEST(VirtualSlave, RegisterAccess_SpanningHooksServesEachRun)
+{
+    VirtualSlave s(1, 0x9A, 0x1111, "S1");
+    std::uint8_t const request[6] = {0x00, 0x01, 0x08, 0x00, 0x00, 0x00}; // read word 8
+
+    // The EEPROM data register is served by the EEPROM even when the read starts below it
+    ASSERT_TRUE(s.write(::kickcat::reg::EEPROM_CONTROL, request, sizeof(request)));
+    std::uint8_t alone[4] = {0};
+    ASSERT_TRUE(s.read(::kickcat::reg::EEPROM_DATA, alone, sizeof(alone)));
+    EXPECT_EQ(alone[0], 0x9A); // vendor id
+    ASSERT_TRUE(s.write(::kickcat::reg::EEPROM_CONTROL, request, sizeof(request)));
+    std::uint8_t spanning[10] = {0};
+    ASSERT_TRUE(s.read(::kickcat::reg::EEPROM_CONTROL, spanning, sizeof(spanning)));
+    EXPECT_EQ(0, std::memcmp(spanning + 6, alone, sizeof(alone)));
+
+    // A write from register space into the EEPROM control registers issues the request
+    std::uint8_t block[8] = {0x00, 0x00, 0x00, 0x01, 0x0A, 0x00, 0x00, 0x00}; // word 10
+    ASSERT_TRUE(s.write(::kickcat::reg::EEPROM_CONTROL - 2, block, sizeof(block)));
+    ASSERT_TRUE(s.read(::kickcat::reg::EEPROM_DATA, alone, sizeof(alone)));
+    EXPECT_EQ(alone[0], 0x11); // product code
+    EXPECT_EQ(alone[1], 0x11);
+}
@@ -0,0 +1,117 @@
+#include <chrono>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "ethercat_sim/simulation/network_simulator.h"
+#include "ethercat_sim/simulation/timer_wheel.h"
+#include "ethercat_sim/simulation/virtual_slave.h"
+
+using namespace std::chrono_literals;
+using ethercat_sim::simulation::NetworkSimulator;
+using ethercat_sim::simulation::TimerWheel;
+using ethercat_sim::simulation::VirtualSlave;
+
+TEST(TimerWheel, OneShotNeverFiresEarly)
+{
+    auto const t0 = TimerWheel::Clock::now();
+    TimerWheel wheel(100us, t0);
+    int fired = 0;
+    wheel.scheduleAt(t0 + 250us, [&] { ++fired; }); // rounds up to tick 3
+
+    EXPECT_EQ(wheel.advanceTo(t0 + 299us), 0u);
+    EXPECT_EQ(fired, 0);
+    EXPECT_EQ(wheel.advanceTo(t0 + 300us), 1u);
+    EXPECT_EQ(fired, 1);
+    EXPECT_EQ(wheel.pending(), 0u);
+    EXPECT_EQ(wheel.advanceTo(t0 + 10ms), 0u);
+}
+
+TEST(TimerWheel, FarTimersCascadeInOrder)
+{
+    auto const t0 = TimerWheel::Clock::now();
+    TimerWheel wheel(100us, t0);
+    std::vector<int> order;
+    // Levels 0..3 plus one beyond the wheel span (64^4 ticks ~ 28 min)
+    wheel.scheduleAt(t0 + 2h, [&] { order.push_back(5); });
+    wheel.scheduleAt(t0 + 30s, [&] { order.push_back(4); });
+    wheel.scheduleAt(t0 + 300ms, [&] { order.push_back(3); });
+    wheel.scheduleAt(t0 + 5ms, [&] { order.push_back(2); });
+    wheel.scheduleAt(t0 + 1ms, [&] { order.push_back(1); });
+
+    wheel.advanceTo(t0 + 30s - 100us);
+    EXPECT_EQ(order, (std::vector<int>{1, 2, 3}));
+    wheel.advanceTo(t0 + 30s);
+    EXPECT_EQ(order, (std::vector<int>{1, 2, 3, 4}));
+    wheel.advanceTo(t0 + 2h - 100us);
+    EXPECT_EQ(order.size(), 4u);
+    wheel.advanceTo(t0 + 2h);
+    EXPECT_EQ(order, (std::vector<int>{1, 2, 3, 4, 5}));
+}
+
+TEST(TimerWheel, CancelAndPeriodic)
+{
+    auto const t0 = TimerWheel::Clock::now();
+    TimerWheel wheel(100us, t0);
+    int once = 0, ticks = 0;
+    auto const id = wheel.scheduleAfter(1ms, [&] { ++once; });
+    auto const every = wheel.scheduleEvery(1ms, [&] { ++ticks; });
+    EXPECT_TRUE(wheel.cancel(id));
+    EXPECT_FALSE(wheel.cancel(id));
+
+    wheel.advanceTo(t0 + 10ms);
+    EXPECT_EQ(once, 0);
+    EXPECT_EQ(ticks, 10);
+
+    EXPECT_TRUE(wheel.cancel(every));
+    wheel.advanceTo(t0 + 20ms);
+    EXPECT_EQ(ticks, 10);
+    EXPECT_EQ(wheel.pending(), 0u);
+}
+
+TEST(TimerWheel, SlaveUpdatePeriodDrivesRoutine)
+{
+    // Counts runOnce() visits through the mapped input read
+    struct CountingSlave : VirtualSlave
+    {
+        using VirtualSlave::VirtualSlave;
+        bool readDigitalInputsBitfield(uint32_t& bits_out) const noexcept override
+        {
+            ++reads;
+            bits_out = 0;
+            return true;
+        }
+        mutable int reads{0};
+    };
+
+    NetworkSimulator sim;
+    sim.initialize();
+    sim.clearSlaves();
+    auto fast = std::make_shared<CountingSlave>(1, 0x9A, 0x1111, "fast");
+    auto idle = std::make_shared<CountingSlave>(2, 0x9A, 0x1111, "idle");
+    sim.addVirtualSlave(fast);
+    sim.addVirtualSlave(idle);
+    sim.mapDigitalInputs(fast, 0x10, 1);
+    sim.mapDigitalInputs(idle, 0x11, 1);
+    fast->setUpdatePeriod(1ms);
+    sim.runOnce();
+    int const fast_before = fast->reads;
+    int const idle_before = idle->reads;
+
+    auto const until = std::chrono::steady_clock::now() + 50ms;
+    while (std::chrono::steady_clock::now() < until)
+    {
+        sim.runOnce();
+    }
+    EXPECT_GE(fast->reads - fast_before, 10); // ~50 periods, generous for loaded CI
+    EXPECT_EQ(idle->reads, idle_before);
+
+    fast->setUpdatePeriod(0ns);
+    sim.runOnce();
+    int const stopped = fast->reads;
+    for (int i = 0; i < 10; ++i)
+    {
+        sim.runOnce();
+    }
+    EXPECT_EQ(fast->reads, stopped);
+}